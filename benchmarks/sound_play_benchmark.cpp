@@ -0,0 +1,161 @@
+// Times SoundManager::PlaySound3D by SoundId against resolving the sound by name on every play,
+// which is what the string-keyed API did (and still understates it: the old path hashed the name
+// once each for the config, the last play time and the volume multiplier). Runs on miniaudio's
+// null backend, so no audio device is needed.
+
+#include "game/audio/MiniaudioSoundController.h"
+#include "game/audio/SoundManager.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  // As many names as GameSounds, with the same shape, so the name table is a realistic size
+  const char *const kSoundNames[] = {
+      "PLAYER_SHOOT", "PLAYER_DASH", "PLAYER_MELEE", "PLAYER_MELEE_CONTINUE", "PLAYER_DAMAGE",
+      "PLAYER_FLIGHT", "PLAYER_WALKING", "PLAYER_LASER", "ENEMY_SHOOT", "ENEMY_DEATH",
+      "ENEMY_DRONE_MOVEMENT", "ENEMY_TURRET_LASER", "PROJECTILE_IMPACT", "MISSILE_LAUNCH",
+      "MISSILE_EXPLOSION", "BOSS_DEATH", "BOSS_MOVEMENT", "BOSS_PROJECTILE", "BOSS_SHOCKWAVE",
+      "GATE_COLLAPSE"};
+  constexpr int kSoundCount = static_cast<int>(sizeof(kSoundNames) / sizeof(kSoundNames[0]));
+
+  constexpr int kPlaysPerRound = 256;
+  constexpr int kRounds = 40;
+
+  void WriteLittleEndian(std::ofstream &out, uint32_t value, int bytes)
+  {
+    for (int i = 0; i < bytes; ++i)
+    {
+      out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+  }
+
+  // A quarter second 16-bit mono sine, enough for the controller to decode into a clip
+  bool WriteTestClip(const std::string &path)
+  {
+    const uint32_t sampleRate = 48000;
+    const uint32_t frameCount = sampleRate / 4;
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+    {
+      return false;
+    }
+    out.write("RIFF", 4);
+    WriteLittleEndian(out, 36 + frameCount * 2, 4);
+    out.write("WAVEfmt ", 8);
+    WriteLittleEndian(out, 16, 4);
+    WriteLittleEndian(out, 1, 2); // PCM
+    WriteLittleEndian(out, 1, 2); // Mono
+    WriteLittleEndian(out, sampleRate, 4);
+    WriteLittleEndian(out, sampleRate * 2, 4);
+    WriteLittleEndian(out, 2, 2);
+    WriteLittleEndian(out, 16, 2);
+    out.write("data", 4);
+    WriteLittleEndian(out, frameCount * 2, 4);
+    for (uint32_t i = 0; i < frameCount; ++i)
+    {
+      const float sample = std::sin(6.2831853f * 440.0f * static_cast<float>(i) / sampleRate);
+      WriteLittleEndian(out, static_cast<uint32_t>(static_cast<int16_t>(sample * 12000.0f)) & 0xFFFF, 2);
+    }
+    return static_cast<bool>(out);
+  }
+
+  // Stops every handle and waits for the controller to hand the voices back to the pool
+  void StopAll(mecha::SoundManager &sounds, std::vector<void *> &handles)
+  {
+    for (void *handle : handles)
+    {
+      sounds.StopSound(handle);
+    }
+    handles.clear();
+    for (int i = 0; i < 10; ++i)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      sounds.Update(0.002f);
+    }
+  }
+
+  /**
+   * @brief Average microseconds per play over kRounds rounds of kPlaysPerRound plays
+   * @param byName Resolve the id from the name on each play instead of using the stored id
+   */
+  double TimePlays(mecha::SoundManager &sounds, const std::vector<mecha::SoundId> &ids, bool byName,
+                   int &failedPlays)
+  {
+    std::vector<void *> handles;
+    handles.reserve(kPlaysPerRound);
+    Clock::duration total{};
+    for (int round = 0; round < kRounds; ++round)
+    {
+      const Clock::time_point start = Clock::now();
+      for (int i = 0; i < kPlaysPerRound; ++i)
+      {
+        const int sound = (i * 7 + round) % kSoundCount;
+        const glm::vec3 position(static_cast<float>(i % 50), 0.0f, static_cast<float>(i / 50));
+        // The string-keyed API took const std::string&, so each call site built one from a literal
+        const mecha::SoundId id = byName ? sounds.FindSound(kSoundNames[sound]) : ids[sound];
+        handles.push_back(sounds.PlaySound3D(id, position));
+      }
+      total += Clock::now() - start;
+
+      for (void *handle : handles)
+      {
+        failedPlays += handle == nullptr ? 1 : 0;
+      }
+      StopAll(sounds, handles);
+    }
+    return std::chrono::duration<double, std::micro>(total).count() / (kRounds * kPlaysPerRound);
+  }
+} // namespace
+
+int main()
+{
+  const std::string clipPath = (std::filesystem::temp_directory_path() / "sound_play_benchmark.wav").string();
+  if (!WriteTestClip(clipPath))
+  {
+    std::printf("Could not write %s\n", clipPath.c_str());
+    return 1;
+  }
+
+  int failedPlays = 0;
+  double byIdMicros = 0.0;
+  double byNameMicros = 0.0;
+  {
+    mecha::MiniaudioSoundController::Config config;
+    config.nullBackend = true;
+    config.voiceCount = 2 * kPlaysPerRound;
+    mecha::MiniaudioSoundController controller(config);
+    mecha::SoundManager sounds(&controller);
+    sounds.SetMixerPolicy({2 * kPlaysPerRound, 0.001f});
+
+    std::vector<mecha::SoundId> ids;
+    for (const char *name : kSoundNames)
+    {
+      ids.push_back(sounds.RegisterSound(name, {clipPath.c_str(), 1.0f, 1000.0f, false, 0.0f}));
+    }
+
+    // Warm up the pool and the allocator before measuring either path
+    TimePlays(sounds, ids, false, failedPlays);
+    failedPlays = 0;
+
+    byIdMicros = TimePlays(sounds, ids, false, failedPlays);
+    byNameMicros = TimePlays(sounds, ids, true, failedPlays);
+  }
+  std::filesystem::remove(clipPath);
+
+  std::printf("PlaySound3D by SoundId:   %.3f us/call\n", byIdMicros);
+  std::printf("PlaySound3D by name:      %.3f us/call\n", byNameMicros);
+  std::printf("%d plays per path, %d sounds registered, %d plays failed\n", kRounds * kPlaysPerRound,
+              kSoundCount, failedPlays);
+  return failedPlays == 0 ? 0 : 1;
+}
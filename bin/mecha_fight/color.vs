@@ -0,0 +1,25 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+
+uniform mat4 model;
+
+const int MAX_CASCADES = 4;
+layout (std140) uniform FrameConstants
+{
+    mat4 projection;
+    mat4 view;
+    mat4 invProjection;
+    mat4 cascadeMatrices[MAX_CASCADES];
+    mat4 staticLightSpaceMatrix;
+    vec4 cascadeSplits;      // far view-space distance of each cascade
+    vec3 viewPos;
+    float time;
+    vec3 lightPos;
+    int cascadeCount;
+    vec3 lightIntensity;
+    int useStaticShadow;     // cached terrain/gate depth, sampled alongside the cascades
+};
+
+void main() {
+    gl_Position = projection * view * model * vec4(aPos, 1.0);
+}
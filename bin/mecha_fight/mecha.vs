@@ -1,18 +1,34 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
 layout (location = 5) in ivec4 aBoneIDs;
 layout (location = 6) in vec4 aWeights;
 
-out VS_OUT
-{
-    vec3 FragPosVS;
-    vec3 NormalVS;
-} vs_out;
+out vec2 TexCoords;
+out vec3 FragPos;
+out vec3 Normal;
+out vec3 FragPosWorld;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+
+const int MAX_CASCADES = 4;
+layout (std140) uniform FrameConstants
+{
+    mat4 projection;
+    mat4 view;
+    mat4 invProjection;
+    mat4 cascadeMatrices[MAX_CASCADES];
+    mat4 staticLightSpaceMatrix;
+    vec4 cascadeSplits;      // far view-space distance of each cascade
+    vec3 viewPos;
+    float time;
+    vec3 lightPos;
+    int cascadeCount;
+    vec3 lightIntensity;
+    int useStaticShadow;     // cached terrain/gate depth, sampled alongside the cascades
+};
+
 uniform bool useSkinning;
 uniform int bonesCount;
 const int MAX_BONES = 100;
@@ -35,7 +51,7 @@ vec4 applySkinning(vec3 position)
         {
             continue;
         }
-        skinnedPosition += bones[boneID] * vec4(position, 1.0) * weight;
+        skinnedPosition += (bones[boneID] * vec4(position, 1.0)) * weight;
         totalWeight += weight;
     }
 
@@ -79,16 +95,13 @@ vec3 applySkinningToNormal(vec3 normal)
 
 void main()
 {
-    vec4 skinnedPos = applySkinning(aPos);
+    TexCoords = aTexCoords;
+    vec4 skinnedPosition = applySkinning(aPos);
     vec3 skinnedNormal = applySkinningToNormal(aNormal);
 
-    vec4 worldPos = model * skinnedPos;
-    vec3 normalWS = normalize(mat3(transpose(inverse(model))) * skinnedNormal);
-
-    vec4 viewPos = view * worldPos;
-    vs_out.FragPosVS = viewPos.xyz;
-    vs_out.NormalVS = mat3(view) * normalWS;
-
-    gl_Position = projection * viewPos;
+    vec4 worldPos = model * skinnedPosition;
+    FragPos = vec3(worldPos);
+    FragPosWorld = vec3(worldPos);
+    Normal = normalize(mat3(transpose(inverse(model))) * skinnedNormal);
+    gl_Position = projection * view * worldPos;
 }
-
@@ -0,0 +1,6 @@
+#version 330 core
+
+void main()
+{
+    // Depth is automatically written - no color output needed
+}
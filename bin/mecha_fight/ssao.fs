@@ -0,0 +1,102 @@
+#version 330 core
+out float FragColor;
+
+in vec2 TexCoords;
+
+uniform sampler2D sceneDepth;  // depth written by the main pass
+uniform sampler2D texNoise;
+
+uniform vec2 noiseScale;
+uniform float radius;
+uniform float bias;
+uniform float power;
+
+const int MAX_CASCADES = 4;
+layout (std140) uniform FrameConstants
+{
+    mat4 projection;
+    mat4 view;
+    mat4 invProjection;
+    mat4 cascadeMatrices[MAX_CASCADES];
+    mat4 staticLightSpaceMatrix;
+    vec4 cascadeSplits;      // far view-space distance of each cascade
+    vec3 viewPos;
+    float time;
+    vec3 lightPos;
+    int cascadeCount;
+    vec3 lightIntensity;
+    int useStaticShadow;     // cached terrain/gate depth, sampled alongside the cascades
+};
+
+const int kernelSize = 64;
+layout (std140) uniform SSAOKernel
+{
+    vec4 samples[kernelSize];  // xyz used, written once at init
+};
+uniform int sampleCount;   // taps actually taken, lower at reduced resolution
+uniform int sampleStride;  // kernel is ordered small to large, stride keeps the radius spread
+
+vec3 ViewPosFromDepth(vec2 uv)
+{
+    float depth = texture(sceneDepth, uv).r;
+    vec4 viewPos = invProjection * vec4(vec3(uv, depth) * 2.0 - 1.0, 1.0);
+    return viewPos.xyz / viewPos.w;
+}
+
+// Normal from the neighbour on each axis with the smaller depth step, so
+// silhouettes do not bend normals toward the background.
+vec3 ViewNormalFromDepth(vec2 uv, vec3 center)
+{
+    vec2 texel = 1.0 / vec2(textureSize(sceneDepth, 0));
+    vec3 right = ViewPosFromDepth(uv + vec2(texel.x, 0.0)) - center;
+    vec3 left = center - ViewPosFromDepth(uv - vec2(texel.x, 0.0));
+    vec3 up = ViewPosFromDepth(uv + vec2(0.0, texel.y)) - center;
+    vec3 down = center - ViewPosFromDepth(uv - vec2(0.0, texel.y));
+    vec3 dx = abs(right.z) < abs(left.z) ? right : left;
+    vec3 dy = abs(up.z) < abs(down.z) ? up : down;
+    return normalize(cross(dx, dy));
+}
+
+void main()
+{
+    if (texture(sceneDepth, TexCoords).r >= 1.0)
+    {
+        FragColor = 1.0;
+        return;
+    }
+
+    vec3 fragPos = ViewPosFromDepth(TexCoords);
+    vec3 normal = ViewNormalFromDepth(TexCoords, fragPos);
+    vec3 randomVec = normalize(texture(texNoise, TexCoords * noiseScale).xyz);
+
+    vec3 tangent = normalize(randomVec - normal * dot(randomVec, normal));
+    vec3 bitangent = cross(normal, tangent);
+    mat3 TBN = mat3(tangent, bitangent, normal);
+
+    float occlusion = 0.0;
+    for (int i = 0; i < sampleCount; ++i)
+    {
+        vec3 sampleVec = TBN * samples[i * sampleStride].xyz;
+        vec3 samplePos = fragPos + sampleVec * radius;
+
+        vec4 offset = projection * vec4(samplePos, 1.0);
+        offset.xyz /= offset.w;
+        offset.xyz = offset.xyz * 0.5 + 0.5;
+
+        if (offset.x < 0.0 || offset.x > 1.0 || offset.y < 0.0 || offset.y > 1.0)
+        {
+            continue;
+        }
+
+        float sampleDepth = -ViewPosFromDepth(offset.xy).z;
+        float samplePosDepth = -samplePos.z;
+        float rangeCheck = smoothstep(0.0, 1.0, radius / (abs(samplePosDepth - sampleDepth) + 1e-4));
+        if (sampleDepth <= samplePosDepth - bias)
+        {
+            occlusion += rangeCheck;
+        }
+    }
+
+    occlusion = 1.0 - (occlusion / float(sampleCount));
+    FragColor = pow(clamp(occlusion, 0.0, 1.0), power);
+}
@@ -0,0 +1,15 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoords;
+
+uniform sampler2D sceneColor;
+uniform sampler2D ssaoMap;
+uniform float aoStrength;
+
+void main()
+{
+    vec3 color = texture(sceneColor, TexCoords).rgb;
+    float ao = texture(ssaoMap, TexCoords).r;
+    FragColor = vec4(color * mix(1.0, ao, aoStrength), 1.0);
+}
@@ -0,0 +1,80 @@
+#version 330 core
+out float FragColor;
+
+in vec2 TexCoords;
+
+uniform sampler2D ssaoInput;   // blurred AO at reduced resolution
+uniform sampler2D sceneDepth;  // full resolution depth from the main pass
+
+const int MAX_CASCADES = 4;
+layout (std140) uniform FrameConstants
+{
+    mat4 projection;
+    mat4 view;
+    mat4 invProjection;
+    mat4 cascadeMatrices[MAX_CASCADES];
+    mat4 staticLightSpaceMatrix;
+    vec4 cascadeSplits;      // far view-space distance of each cascade
+    vec3 viewPos;
+    float time;
+    vec3 lightPos;
+    int cascadeCount;
+    vec3 lightIntensity;
+    int useStaticShadow;     // cached terrain/gate depth, sampled alongside the cascades
+};
+
+uniform float depthTolerance;  // relative depth difference at which a low-res tap is rejected
+
+float ViewDepth(float depth)
+{
+    vec4 viewPos = invProjection * vec4(0.0, 0.0, depth * 2.0 - 1.0, 1.0);
+    return -viewPos.z / viewPos.w;
+}
+
+void main()
+{
+    float rawDepth = texelFetch(sceneDepth, ivec2(gl_FragCoord.xy), 0).r;
+    float depth = ViewDepth(rawDepth);
+    if (rawDepth >= 1.0)
+    {
+        FragColor = 1.0;
+        return;
+    }
+
+    ivec2 lowSize = textureSize(ssaoInput, 0);
+    vec2 lowCoord = TexCoords * vec2(lowSize) - 0.5;
+    ivec2 base = ivec2(floor(lowCoord));
+    vec2 f = fract(lowCoord);
+
+    float result = 0.0;
+    float totalWeight = 0.0;
+    float nearestAO = 1.0;
+    float nearestDiff = 1e20;
+    for (int y = 0; y <= 1; ++y)
+    {
+        for (int x = 0; x <= 1; ++x)
+        {
+            ivec2 coord = clamp(base + ivec2(x, y), ivec2(0), lowSize - 1);
+            vec2 lowUV = (vec2(coord) + 0.5) / vec2(lowSize);
+            // Same depth the AO pass read for this low-res texel
+            float sampleDepth = ViewDepth(texture(sceneDepth, lowUV).r);
+            float ao = texelFetch(ssaoInput, coord, 0).r;
+
+            float diff = abs(depth - sampleDepth);
+            float bilinear = (x == 0 ? 1.0 - f.x : f.x) * (y == 0 ? 1.0 - f.y : f.y);
+            float depthWeight = 1.0 - clamp(diff / (depth * depthTolerance), 0.0, 1.0);
+            float weight = bilinear * depthWeight;
+
+            result += ao * weight;
+            totalWeight += weight;
+            if (diff < nearestDiff)
+            {
+                nearestDiff = diff;
+                nearestAO = ao;
+            }
+        }
+    }
+
+    // All taps straddle a depth edge: fall back to the closest surface
+    FragColor = totalWeight > 1e-4 ? result / totalWeight : nearestAO;
+}
@@ -0,0 +1,163 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoords;
+in vec3 FragPos;
+in vec3 Normal;
+in vec3 FragPosWorld;
+
+uniform sampler2D texture_diffuse1;
+uniform sampler2DArray shadowMap;
+uniform bool useAlbedoTexture;
+uniform vec3 fallbackColor;
+uniform sampler2D staticShadowMap;
+
+const int MAX_CASCADES = 4;
+layout (std140) uniform FrameConstants
+{
+    mat4 projection;
+    mat4 view;
+    mat4 invProjection;
+    mat4 cascadeMatrices[MAX_CASCADES];
+    mat4 staticLightSpaceMatrix;
+    vec4 cascadeSplits;      // far view-space distance of each cascade
+    vec3 viewPos;
+    float time;
+    vec3 lightPos;
+    int cascadeCount;
+    vec3 lightIntensity;
+    int useStaticShadow;     // cached terrain/gate depth, sampled alongside the cascades
+};
+
+int SelectCascade(vec3 worldPos)
+{
+    float viewDepth = -(view * vec4(worldPos, 1.0)).z;
+    for (int i = 0; i < cascadeCount; ++i)
+    {
+        if (viewDepth < cascadeSplits[i])
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+float ShadowBias(vec3 normal, vec3 lightDir)
+{
+    float ndotl = clamp(dot(normal, lightDir), 0.0, 1.0);
+    float slope = sqrt(max(1.0 - ndotl * ndotl, 0.0));
+    const float biasMin = 0.0004;
+    const float biasMax = 0.015;
+    const float biasSlopeFactor = 0.008;
+    return clamp(biasMin + slope * biasSlopeFactor, biasMin, biasMax);
+}
+
+float CascadeShadow(vec3 worldPos, float bias)
+{
+    int cascade = SelectCascade(worldPos);
+    if (cascade < 0)
+    {
+        return 0.0;
+    }
+
+    vec4 fragPosLightSpace = cascadeMatrices[cascade] * vec4(worldPos, 1.0);
+    vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
+    projCoords = projCoords * 0.5 + 0.5;
+
+    if (projCoords.z <= 0.0 || projCoords.z >= 1.0 ||
+        projCoords.x <= 0.0 || projCoords.x >= 1.0 ||
+        projCoords.y <= 0.0 || projCoords.y >= 1.0)
+    {
+        return 0.0;
+    }
+
+    float currentDepth = projCoords.z;
+    float shadow = 0.0;
+    vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0).xy);
+    for (int x = -1; x <= 1; ++x)
+    {
+        for (int y = -1; y <= 1; ++y)
+        {
+            float pcfDepth = texture(shadowMap, vec3(projCoords.xy + vec2(x, y) * texelSize, float(cascade))).r;
+            shadow += currentDepth - bias > pcfDepth ? 1.0 : 0.0;
+        }
+    }
+    return shadow / 9.0;
+}
+
+float StaticShadow(vec3 worldPos, float bias)
+{
+    vec4 fragPosLightSpace = staticLightSpaceMatrix * vec4(worldPos, 1.0);
+    vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
+    projCoords = projCoords * 0.5 + 0.5;
+
+    if (projCoords.z <= 0.0 || projCoords.z >= 1.0 ||
+        projCoords.x <= 0.0 || projCoords.x >= 1.0 ||
+        projCoords.y <= 0.0 || projCoords.y >= 1.0)
+    {
+        return 0.0;
+    }
+
+    float currentDepth = projCoords.z;
+    float shadow = 0.0;
+    vec2 texelSize = 1.0 / vec2(textureSize(staticShadowMap, 0));
+    for (int x = -1; x <= 1; ++x)
+    {
+        for (int y = -1; y <= 1; ++y)
+        {
+            float pcfDepth = texture(staticShadowMap, projCoords.xy + vec2(x, y) * texelSize).r;
+            shadow += currentDepth - bias > pcfDepth ? 1.0 : 0.0;
+        }
+    }
+    return shadow / 9.0;
+}
+
+float ShadowCalculation(vec3 worldPos, vec3 normal, vec3 lightDir)
+{
+    float bias = ShadowBias(normal, lightDir);
+    float shadow = CascadeShadow(worldPos, bias);
+    if (useStaticShadow != 0)
+    {
+        shadow = max(shadow, StaticShadow(worldPos, bias));
+    }
+    return shadow;
+}
+
+void main()
+{
+    vec3 baseColor = fallbackColor;
+    if (useAlbedoTexture)
+    {
+        vec4 texColor = texture(texture_diffuse1, TexCoords);
+        if (texColor.a < 0.05)
+        {
+            discard;
+        }
+        baseColor = texColor.rgb;
+    }
+
+    // Lighting
+    vec3 lightColor = lightIntensity;
+    vec3 norm = normalize(Normal);
+    vec3 lightDir = normalize(lightPos - FragPos);
+
+    // Ambient
+    float ambientStrength = 0.45;
+    vec3 ambient = ambientStrength * lightColor;
+
+    // Diffuse
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = diff * lightColor;
+
+    // Apply normal offset to reduce self-shadowing
+    float normalOffsetScale = 0.015;
+    vec3 offsetPos = FragPosWorld + norm * normalOffsetScale;
+
+    // Calculate shadow
+    float shadow = ShadowCalculation(offsetPos, norm, lightDir);
+
+
+    // Combine with shadow (SSAO is applied by the composite pass)
+    vec3 result = (ambient + (1.0 - shadow) * diffuse) * baseColor;
+    FragColor = vec4(result, 1.0);
+}
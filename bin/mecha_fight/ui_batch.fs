@@ -0,0 +1,11 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 uv;
+in vec4 color;
+
+uniform sampler2D uTexture; // 1x1 white for untextured shapes
+
+void main() {
+    FragColor = texture(uTexture, uv) * color;
+}
@@ -0,0 +1,17 @@
+#version 330 core
+layout (location = 0) in vec2 aPos;   // pixels, top-left origin
+layout (location = 1) in vec2 aUV;
+layout (location = 2) in vec4 aColor;
+
+uniform vec2 screenSize; // pixels
+
+out vec2 uv;
+out vec4 color;
+
+void main() {
+    float ndcX = (aPos.x / screenSize.x) * 2.0 - 1.0;
+    float ndcY = 1.0 - (aPos.y / screenSize.y) * 2.0;
+    gl_Position = vec4(ndcX, ndcY, 0.0, 1.0);
+    uv = aUV;
+    color = aColor;
+}
@@ -7,6 +7,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <learnopengl/shader.h>
+#include <learnopengl/vertex_layout.h>
 
 #include <string>
 #include <vector>
@@ -32,6 +33,13 @@ struct Vertex
     float m_Weights[MAX_BONE_INFLUENCE];
 };
 
+// contiguous index range inside a mesh's element buffer
+struct MeshLod
+{
+    unsigned int indexOffset;
+    unsigned int indexCount;
+};
+
 struct Texture
 {
     unsigned int id;
@@ -48,24 +56,60 @@ public:
     vector<Texture> textures;
     string materialName;
     int skinIndex;
-    unsigned int VAO;
-
-    // constructor
+    unsigned int VAO = 0;
+    // index ranges per level of detail, level 0 is the full-resolution mesh
+    vector<MeshLod> lods;
+    // indices of the reduced levels; the element buffer holds them right after the level 0 indices
+    vector<unsigned int> lodIndices;
+    // GPU vertex format, picked by setupMesh (skinned or static, half or float uvs)
+    VertexLayout layout;
+
+    // constructor (pass upload = false to build the mesh without a GL context and call upload() later)
     Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<Texture> textures,
-         const string &materialName = "", int skinIndex = -1)
+         const string &materialName = "", int skinIndex = -1, bool upload = true)
     {
         this->vertices = vertices;
         this->indices = indices;
         this->textures = textures;
         this->materialName = materialName;
         this->skinIndex = skinIndex;
+        lods.assign(1, MeshLod{0u, static_cast<unsigned int>(this->indices.size())});
 
         // now that we have all the required data, set the vertex buffers and its attribute pointers.
-        setupMesh();
+        if (upload)
+            setupMesh();
+    }
+
+    // create the GL buffers for a mesh constructed without them (main thread only)
+    void upload()
+    {
+        if (VAO == 0)
+            setupMesh();
     }
 
-    // render the mesh
-    void Draw(Shader &shader)
+    bool isUploaded() const { return VAO != 0; }
+
+    // drop the CPU copies of vertices and indices once they live on the GPU; drawing keeps working from the
+    // buffers and lod ranges, but nothing can read or simplify the geometry afterwards
+    void releaseCpuData()
+    {
+        if (VAO == 0)
+            return;
+        vector<Vertex>().swap(vertices);
+        vector<unsigned int>().swap(indices);
+        vector<unsigned int>().swap(lodIndices);
+    }
+
+    bool hasCpuData() const { return !vertices.empty(); }
+
+    size_t cpuBytes() const
+    {
+        return vertices.capacity() * sizeof(Vertex) + (indices.capacity() + lodIndices.capacity()) * sizeof(unsigned int);
+    }
+    size_t gpuBytes() const { return vertexBufferBytes + indexBufferBytes; }
+
+    // render the mesh (lod is clamped to the available levels)
+    void Draw(Shader &shader, int lod = 0)
     {
         // bind appropriate textures
         unsigned int diffuseNr = 1;
@@ -94,17 +138,71 @@ public:
         }
 
         // draw mesh
+        const MeshLod &range = lods[lod < 0 ? 0 : (lod >= static_cast<int>(lods.size()) ? lods.size() - 1 : lod)];
         glBindVertexArray(VAO);
-        glDrawElements(GL_TRIANGLES, static_cast<unsigned int>(indices.size()), GL_UNSIGNED_INT, 0);
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(range.indexCount), GL_UNSIGNED_INT,
+                       (void *)(static_cast<size_t>(range.indexOffset) * sizeof(unsigned int)));
         glBindVertexArray(0);
 
         // always good practice to set everything back to defaults once configured.
         glActiveTexture(GL_TEXTURE0);
     }
 
+    int GetLodCount() const { return static_cast<int>(lods.size()); }
+
+    unsigned int GetLodTriangleCount(int lod) const
+    {
+        if (lod < 0 || lod >= static_cast<int>(lods.size()))
+            return 0;
+        return lods[lod].indexCount / 3;
+    }
+
+    // replace the reduced levels (level 0 stays the source indices); all ranges share one element buffer.
+    // Needs no GL context before upload(); an uploaded mesh gets its element buffer rewritten
+    void setLodIndices(const vector<vector<unsigned int>> &levels)
+    {
+        if (!hasCpuData())
+            return;
+
+        lodIndices.clear();
+        lods.assign(1, MeshLod{0u, static_cast<unsigned int>(indices.size())});
+        for (const vector<unsigned int> &level : levels)
+        {
+            if (level.empty())
+                continue;
+            lods.push_back(MeshLod{static_cast<unsigned int>(indices.size() + lodIndices.size()),
+                                   static_cast<unsigned int>(level.size())});
+            lodIndices.insert(lodIndices.end(), level.begin(), level.end());
+        }
+
+        if (VAO != 0)
+        {
+            glBindVertexArray(VAO);
+            uploadIndices();
+            glBindVertexArray(0);
+        }
+    }
+
+    // adopt cooked level ranges and indices; false (leaving level 0 only) if a range falls outside the indices
+    bool setCookedLods(vector<MeshLod> ranges, vector<unsigned int> reducedIndices)
+    {
+        const size_t total = indices.size() + reducedIndices.size();
+        bool valid = !ranges.empty() && ranges[0].indexOffset == 0 && ranges[0].indexCount == indices.size();
+        for (const MeshLod &range : ranges)
+            valid = valid && static_cast<size_t>(range.indexOffset) + range.indexCount <= total;
+        if (!valid)
+            return false;
+
+        lods = std::move(ranges);
+        lodIndices = std::move(reducedIndices);
+        return true;
+    }
+
 private:
     // render data
-    unsigned int VBO, EBO;
+    unsigned int VBO = 0, EBO = 0;
+    size_t vertexBufferBytes = 0;
+    size_t indexBufferBytes = 0;
 
     // initializes all the buffer objects/arrays
     void setupMesh()
@@ -114,41 +212,34 @@ private:
         glGenBuffers(1, &VBO);
         glGenBuffers(1, &EBO);
 
+        // the CPU keeps the full Vertex for simplification and collision; the GPU only gets what the shaders
+        // read, quantised: unskinned meshes drop the bone attributes and the bitangent is never uploaded
+        layout = VertexLayout::compact(skinIndex >= 0, VertexLayout::fitsHalfTexCoords(vertices));
+        const vector<unsigned char> packed = layout.pack(vertices);
+
         glBindVertexArray(VAO);
         // load data into vertex buffers
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        // A great thing about structs is that their memory layout is sequential for all its items.
-        // The effect is that we can simply pass a pointer to the struct and it translates perfectly to a glm::vec3/2 array which
-        // again translates to 3/2 floats which translates to a byte array.
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
+        glBufferData(GL_ARRAY_BUFFER, packed.size(), packed.data(), GL_STATIC_DRAW);
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+        uploadIndices();
+        vertexBufferBytes = packed.size();
 
         // set the vertex attribute pointers
-        // vertex Positions
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)0);
-        // vertex normals
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, Normal));
-        // vertex texture coords
-        glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, TexCoords));
-        // vertex tangent
-        glEnableVertexAttribArray(3);
-        glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, Tangent));
-        // vertex bitangent
-        glEnableVertexAttribArray(4);
-        glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, Bitangent));
-        // ids
-        glEnableVertexAttribArray(5);
-        glVertexAttribIPointer(5, 4, GL_INT, sizeof(Vertex), (void *)offsetof(Vertex, m_BoneIDs));
-
-        // weights
-        glEnableVertexAttribArray(6);
-        glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, m_Weights));
+        layout.apply();
         glBindVertexArray(0);
     }
+
+    // fills the element buffer with level 0 followed by the reduced levels (VAO must be bound)
+    void uploadIndices()
+    {
+        const size_t levelZeroBytes = indices.size() * sizeof(unsigned int);
+        indexBufferBytes = levelZeroBytes + lodIndices.size() * sizeof(unsigned int);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBufferBytes, nullptr, GL_STATIC_DRAW);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, levelZeroBytes, indices.data());
+        if (!lodIndices.empty())
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, levelZeroBytes, indexBufferBytes - levelZeroBytes, lodIndices.data());
+    }
 };
 #endif
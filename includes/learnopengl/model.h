@@ -38,10 +38,27 @@
 #include <iomanip>
 #include <functional>
 #include <utility>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 using namespace std;
 
 inline unsigned int TextureFromFile(const char *path, const string &directory, bool gamma = false);
 
+// shared texture store for deferred models, so identical images across models become one GL texture.
+// the Request* calls run on loader threads and return a handle (0 on failure); Resolve() runs on the GL
+// thread once the model uploads and returns the texture id behind a handle.
+class TextureProvider
+{
+public:
+    virtual ~TextureProvider() = default;
+    virtual unsigned int RequestFile(const string &path, bool gamma) = 0;
+    virtual unsigned int RequestPixels(const string &name, const unsigned char *pixels, int width, int height, int components,
+                                       bool gamma) = 0;
+    virtual unsigned int Resolve(unsigned int handle) = 0;
+};
+
 class Model
 {
 public:
@@ -61,8 +78,279 @@ public:
         loadModel(path);
     }
 
-    // draws the model, and thus all its meshes
-    void Draw(Shader &shader)
+    // tag for the constructor that only parses and decodes; safe to call without a GL context
+    struct DeferUpload
+    {
+    };
+
+    // parses the file and decodes its images into CPU memory; call UploadToGpu() on the GL thread before drawing.
+    // with a provider, 8-bit images are handed to it instead and shared with every other model using it
+    Model(string const &path, DeferUpload, bool gamma = false, TextureProvider *textures = nullptr)
+        : gammaCorrection(gamma), deferUpload(true), textureProvider(textures)
+    {
+        boundingMin = glm::vec3(FLT_MAX);
+        boundingMax = glm::vec3(-FLT_MAX);
+        loadModel(path);
+    }
+
+    // empty deferred model, filled by Deserialize()
+    explicit Model(DeferUpload, bool gamma = false, TextureProvider *textures = nullptr)
+        : gammaCorrection(gamma), deferUpload(true), textureProvider(textures)
+    {
+        boundingMin = glm::vec3(FLT_MAX);
+        boundingMax = glm::vec3(-FLT_MAX);
+    }
+
+    bool IsUploaded() const { return !deferUpload; }
+
+    // layout version of Serialize(); bump whenever it or anything loadModel() produces changes
+    static constexpr uint32_t CookedFormatVersion = 3;
+
+    // appends the parsed model (meshes, nodes, skins, animation clips, embedded images) as a flat blob.
+    // External image files are stored by name and decoded again on Deserialize(). Deferred models only,
+    // before UploadToGpu() releases the decoded images.
+    void Serialize(vector<unsigned char> &out) const
+    {
+        CookedWriter writer{out};
+        writer.str(directory);
+        writer.pod(boundingMin);
+        writer.pod(boundingMax);
+
+        writer.count(textures_loaded.size());
+        for (const Texture &texture : textures_loaded)
+        {
+            writer.str(texture.type);
+            writer.str(texture.path);
+        }
+
+        writer.count(pendingImages.size());
+        for (const PendingImage &image : pendingImages)
+        {
+            writer.str(image.cacheKey);
+            writer.str(image.uri);
+            if (image.uri.empty())
+            {
+                writer.pod(image.width);
+                writer.pod(image.height);
+                writer.pod(image.components);
+                writer.pod(static_cast<uint32_t>(image.pixelType));
+                writer.array(image.pixels);
+            }
+        }
+
+        writer.count(meshes.size());
+        for (const Mesh &mesh : meshes)
+        {
+            writer.str(mesh.materialName);
+            writer.pod(mesh.skinIndex);
+            writer.array(mesh.vertices);
+            writer.array(mesh.indices);
+            writer.array(mesh.lods);
+            writer.array(mesh.lodIndices);
+            writer.count(mesh.textures.size());
+            for (const Texture &texture : mesh.textures)
+            {
+                writer.str(texture.type);
+                writer.str(texture.path);
+            }
+        }
+
+        writer.count(skins.size());
+        for (const SkinData &skin : skins)
+        {
+            writer.str(skin.name);
+            writer.array(skin.joints);
+            writer.array(skin.inverseBindMatrices);
+            writer.pod(skin.skeletonRoot);
+        }
+        writer.array(nodeSkinBindings);
+
+        writer.count(nodes.size());
+        for (const NodeInfo &node : nodes)
+        {
+            writer.str(node.name);
+            writer.pod(node.parent);
+            writer.array(node.children);
+        }
+        writer.array(sceneRootNodes);
+        writer.array(nodeDefaultTranslations);
+        writer.array(nodeDefaultRotations);
+        writer.array(nodeDefaultScales);
+
+        writer.count(animationClips.size());
+        for (const AnimationClip &clip : animationClips)
+        {
+            writer.str(clip.name);
+            writer.pod(clip.duration);
+            writer.count(clip.samplers.size());
+            for (const AnimationSampler &sampler : clip.samplers)
+            {
+                writer.array(sampler.inputs);
+                writer.array(sampler.outputs);
+                writer.str(sampler.interpolation);
+            }
+            writer.array(clip.channels);
+        }
+    }
+
+    // rebuilds an empty deferred model from a Serialize() blob; returns false if the blob is truncated.
+    // Safe without a GL context, the model still needs UploadToGpu() before drawing.
+    bool Deserialize(const unsigned char *data, size_t size)
+    {
+        CookedReader reader{data, data + size};
+        reader.str(directory);
+        reader.pod(boundingMin);
+        reader.pod(boundingMax);
+
+        textures_loaded.resize(reader.count());
+        for (Texture &texture : textures_loaded)
+        {
+            texture.id = 0;
+            reader.str(texture.type);
+            reader.str(texture.path);
+        }
+
+        const size_t imageCount = reader.count();
+        for (size_t i = 0; i < imageCount && reader.ok; ++i)
+        {
+            PendingImage image;
+            reader.str(image.cacheKey);
+            reader.str(image.uri);
+            if (!image.uri.empty())
+            {
+                decodeImageFile(image.uri, image.cacheKey);
+                continue;
+            }
+            uint32_t pixelType = GL_UNSIGNED_BYTE;
+            reader.pod(image.width);
+            reader.pod(image.height);
+            reader.pod(image.components);
+            reader.pod(pixelType);
+            reader.array(image.pixels);
+            image.pixelType = static_cast<GLenum>(pixelType);
+            image.sharedHandle = requestSharedPixels(image);
+            pendingImages.push_back(std::move(image));
+        }
+
+        const size_t meshCount = reader.count();
+        meshes.reserve(meshCount);
+        for (size_t i = 0; i < meshCount && reader.ok; ++i)
+        {
+            string materialName;
+            int skinIndex = -1;
+            vector<Vertex> vertices;
+            vector<unsigned int> indices;
+            vector<MeshLod> lods;
+            vector<unsigned int> lodIndices;
+            reader.str(materialName);
+            reader.pod(skinIndex);
+            reader.array(vertices);
+            reader.array(indices);
+            reader.array(lods);
+            reader.array(lodIndices);
+            vector<Texture> textures(reader.count());
+            for (Texture &texture : textures)
+            {
+                texture.id = 0;
+                reader.str(texture.type);
+                reader.str(texture.path);
+            }
+            meshes.emplace_back(std::move(vertices), std::move(indices), std::move(textures), materialName, skinIndex, false);
+            if (reader.ok && !meshes.back().setCookedLods(std::move(lods), std::move(lodIndices)))
+                return false;
+        }
+
+        skins.resize(reader.count());
+        for (SkinData &skin : skins)
+        {
+            reader.str(skin.name);
+            reader.array(skin.joints);
+            reader.array(skin.inverseBindMatrices);
+            reader.pod(skin.skeletonRoot);
+        }
+        reader.array(nodeSkinBindings);
+
+        nodes.resize(reader.count());
+        for (NodeInfo &node : nodes)
+        {
+            reader.str(node.name);
+            reader.pod(node.parent);
+            reader.array(node.children);
+        }
+        reader.array(sceneRootNodes);
+        reader.array(nodeDefaultTranslations);
+        reader.array(nodeDefaultRotations);
+        reader.array(nodeDefaultScales);
+
+        animationClips.resize(reader.count());
+        for (AnimationClip &clip : animationClips)
+        {
+            reader.str(clip.name);
+            reader.pod(clip.duration);
+            clip.samplers.resize(reader.count());
+            for (AnimationSampler &sampler : clip.samplers)
+            {
+                reader.array(sampler.inputs);
+                reader.array(sampler.outputs);
+                reader.str(sampler.interpolation);
+            }
+            reader.array(clip.channels);
+        }
+
+        if (!reader.ok || nodeDefaultTranslations.size() != nodes.size() || nodeDefaultRotations.size() != nodes.size() ||
+            nodeDefaultScales.size() != nodes.size() || reader.cur != reader.end)
+        {
+            return false;
+        }
+
+        // derived state, as initializeNodeData() and loadAnimations() leave it
+        skinMatrices.assign(skins.size(), {});
+        nodeLocalMatrices.assign(nodes.size(), glm::mat4(1.0f));
+        nodeGlobalMatrices.assign(nodes.size(), glm::mat4(1.0f));
+        activeAnimation = animationClips.empty() ? -1 : 0;
+        currentAnimationTime = 0.0f;
+        resetAnimationPose();
+        updateNodeMatrices();
+        updateSkinMatrices();
+        return true;
+    }
+
+    // creates the textures and mesh buffers of a deferred model and frees the decoded pixels
+    void UploadToGpu()
+    {
+        if (!deferUpload)
+            return;
+
+        for (PendingImage &pending : pendingImages)
+        {
+            const unsigned int id = pending.sharedHandle != 0
+                                        ? textureProvider->Resolve(pending.sharedHandle)
+                                        : createTexture(pending.width, pending.height, pending.components, pending.pixelType,
+                                                        pending.pixels.data());
+            for (Texture &texture : textures_loaded)
+            {
+                if (texture.path == pending.cacheKey)
+                    texture.id = id;
+            }
+            for (Mesh &mesh : meshes)
+            {
+                for (Texture &texture : mesh.textures)
+                {
+                    if (texture.path == pending.cacheKey)
+                        texture.id = id;
+                }
+            }
+        }
+        pendingImages.clear();
+        pendingImages.shrink_to_fit();
+
+        for (Mesh &mesh : meshes)
+            mesh.upload();
+        deferUpload = false;
+    }
+
+    // draws the model, and thus all its meshes (lod 0 is full resolution)
+    void Draw(Shader &shader, int lod = 0)
     {
         int lastSkinIndex = std::numeric_limits<int>::min();
         static bool loggedNoSkin = false;
@@ -74,7 +362,7 @@ public:
                 applySkinningUniforms(shader, mesh.skinIndex);
                 lastSkinIndex = mesh.skinIndex;
             }
-            meshes[i].Draw(shader);
+            meshes[i].Draw(shader, lod);
             if (mesh.skinIndex < 0 && !loggedNoSkin)
             {
                 std::cout << "[GLTF] Draw mesh without skin (" << mesh.materialName << ")" << std::endl;
@@ -89,6 +377,38 @@ public:
     glm::vec3 GetBoundingMin() const { return boundingMin; }
     glm::vec3 GetBoundingMax() const { return boundingMax; }
     glm::vec3 GetDimensions() const { return boundingMax - boundingMin; }
+    int GetLodCount() const
+    {
+        int count = 1;
+        for (const Mesh &mesh : meshes)
+            count = std::max(count, mesh.GetLodCount());
+        return count;
+    }
+    // frees every mesh's CPU vertex/index copy (see Mesh::releaseCpuData)
+    void ReleaseCpuData()
+    {
+        for (Mesh &mesh : meshes)
+            mesh.releaseCpuData();
+    }
+    bool HasCpuData() const
+    {
+        return std::any_of(meshes.begin(), meshes.end(), [](const Mesh &mesh)
+                           { return mesh.hasCpuData(); });
+    }
+    size_t GetCpuMeshBytes() const
+    {
+        size_t bytes = 0;
+        for (const Mesh &mesh : meshes)
+            bytes += mesh.cpuBytes();
+        return bytes;
+    }
+    size_t GetGpuMeshBytes() const
+    {
+        size_t bytes = 0;
+        for (const Mesh &mesh : meshes)
+            bytes += mesh.gpuBytes();
+        return bytes;
+    }
     bool HasSkins() const { return !skins.empty(); }
     bool HasAnimations() const { return !animationClips.empty(); }
     int GetAnimationClipCount() const { return static_cast<int>(animationClips.size()); }
@@ -106,6 +426,102 @@ public:
 private:
     static constexpr int MAX_BONES = 100;
 
+    // image decoded by a deferred load, waiting for its GL texture
+    struct PendingImage
+    {
+        string cacheKey;
+        string uri; // external file relative to directory, empty for images embedded in the model
+        int width = 0;
+        int height = 0;
+        int components = 0;
+        GLenum pixelType = GL_UNSIGNED_BYTE;
+        vector<unsigned char> pixels; // external files handed to the provider keep none
+        unsigned int sharedHandle = 0; // TextureProvider handle, 0 when this model creates the texture itself
+    };
+
+    bool deferUpload = false;
+    TextureProvider *textureProvider = nullptr;
+    vector<PendingImage> pendingImages;
+
+    // byte-level helpers for Serialize()/Deserialize(); arrays are a 64-bit count followed by raw elements
+    struct CookedWriter
+    {
+        vector<unsigned char> &out;
+
+        template <typename T>
+        void pod(const T &value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "cooked data must be trivially copyable");
+            const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+
+        void count(size_t n) { pod(static_cast<uint64_t>(n)); }
+
+        template <typename T>
+        void array(const vector<T> &values)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "cooked data must be trivially copyable");
+            count(values.size());
+            const unsigned char *bytes = reinterpret_cast<const unsigned char *>(values.data());
+            out.insert(out.end(), bytes, bytes + values.size() * sizeof(T));
+        }
+
+        void str(const string &value)
+        {
+            count(value.size());
+            out.insert(out.end(), value.begin(), value.end());
+        }
+    };
+
+    struct CookedReader
+    {
+        const unsigned char *cur;
+        const unsigned char *end;
+        bool ok = true;
+
+        bool take(void *dst, size_t bytes)
+        {
+            if (!ok || static_cast<size_t>(end - cur) < bytes)
+            {
+                ok = false;
+                return false;
+            }
+            if (bytes > 0)
+                std::memcpy(dst, cur, bytes);
+            cur += bytes;
+            return true;
+        }
+
+        template <typename T>
+        void pod(T &value) { take(&value, sizeof(T)); }
+
+        // element count, clamped to what the remaining bytes could hold so a corrupt blob cannot over-allocate
+        size_t count(size_t minElementSize = 1)
+        {
+            uint64_t n = 0;
+            if (!take(&n, sizeof(n)) || n > static_cast<uint64_t>(end - cur) / minElementSize)
+            {
+                ok = false;
+                return 0;
+            }
+            return static_cast<size_t>(n);
+        }
+
+        template <typename T>
+        void array(vector<T> &values)
+        {
+            values.resize(count(sizeof(T)));
+            take(values.data(), values.size() * sizeof(T));
+        }
+
+        void str(string &value)
+        {
+            value.resize(count());
+            take(&value[0], value.size());
+        }
+    };
+
     struct SkinData
     {
         std::string name;
@@ -1113,6 +1529,7 @@ private:
         size_t texCoordStride = 0;
         const unsigned char *tangentBuffer = nullptr;
         size_t tangentStride = 0;
+        int tangentComponents = 0;
         const unsigned char *jointBuffer = nullptr;
         size_t jointStride = 0;
         int jointComponentType = 0;
@@ -1190,6 +1607,7 @@ private:
             const tinygltf::Buffer &buffer = model.buffers[bufferView.buffer];
             tangentBuffer = &buffer.data[bufferView.byteOffset + accessor.byteOffset];
             tangentStride = accessor.ByteStride(bufferView);
+            tangentComponents = tinygltf::GetNumComponentsInType(static_cast<uint32_t>(accessor.type));
             if (tangentStride == 0)
             {
                 tangentStride = tinygltf::GetNumComponentsInType(static_cast<uint32_t>(accessor.type)) *
@@ -1245,6 +1663,7 @@ private:
         const bool applyTransform = (skinIndex < 0);
         glm::mat3 transformMat3 = glm::mat3(1.0f);
         glm::mat3 normalMatrix = glm::mat3(1.0f);
+        bool mirrored = false; // Transform flips handedness, so cross(normal, tangent) flips too
         if (applyTransform)
         {
             transformMat3 = glm::mat3(transform);
@@ -1253,6 +1672,7 @@ private:
             {
                 normalMatrix = glm::transpose(glm::inverse(transformMat3));
             }
+            mirrored = determinant < 0.0f;
         }
 
         for (size_t i = 0; i < vertexCount; i++)
@@ -1283,10 +1703,15 @@ private:
             }
 
             glm::vec3 tangent = glm::vec3(0.0f);
+            float handedness = 1.0f;
             if (tangentBuffer)
             {
                 const float *tan = reinterpret_cast<const float *>(tangentBuffer + i * tangentStride);
                 tangent = glm::vec3(tan[0], tan[1], tan[2]);
+                if (tangentComponents == 4 && tan[3] < 0.0f)
+                {
+                    handedness = -1.0f;
+                }
             }
 
             glm::vec3 finalPosition = position;
@@ -1323,7 +1748,7 @@ private:
             }
             vertex.TexCoords = texCoord;
 
-            // GLTF Tangents are VEC4 (w component for handedness), our Vertex struct is VEC3
+            // GLTF Tangents are VEC4 (w component for handedness), our Vertex struct is VEC3; w goes into Bitangent below
             if (applyTransform)
             {
                 glm::vec3 transformedTangent = normalMatrix * tangent;
@@ -1348,10 +1773,13 @@ private:
                 }
             }
 
-            // GLTF doesn't store Bitangents, they are meant to be calculated.
-            // We can calculate them from Position, Normal, and TexCoords if needed,
-            // or just set them to zero. For now, set to zero.
-            vertex.Bitangent = glm::vec3(0.0f); // Placeholder
+            // GLTF doesn't store Bitangents: bitangent = cross(normal, tangent) * tangent.w. Keeping it lets the
+            // vertex packer recover the sign for mirrored UVs
+            if (applyTransform && mirrored)
+            {
+                handedness = -handedness;
+            }
+            vertex.Bitangent = glm::cross(vertex.Normal, vertex.Tangent) * handedness;
 
             if (hasJointAttribute)
             {
@@ -1519,7 +1947,8 @@ private:
             }
         }
 
-        static int debugPrimitiveCount = 0;
+        // deferred models are parsed on worker threads
+        static std::atomic<int> debugPrimitiveCount{0};
         if (debugPrimitiveCount < 5)
         {
             glm::vec3 minPos(FLT_MAX);
@@ -1541,7 +1970,7 @@ private:
         }
 
         // return a mesh object created from the extracted mesh data
-        return Mesh(vertices, indices, textures, materialName, skinIndex);
+        return Mesh(vertices, indices, textures, materialName, skinIndex, !deferUpload);
     }
 
     void updateBounds(const glm::vec3 &position)
@@ -1674,7 +2103,15 @@ private:
         // If the image references an external URI, fall back to the existing file loader.
         if (!image.uri.empty() && !isDataUri)
         {
-            texture.id = TextureFromFile(image.uri.c_str(), this->directory, gammaCorrection);
+            if (deferUpload)
+            {
+                texture.id = 0;
+                decodeImageFile(image.uri, cacheKey);
+            }
+            else
+            {
+                texture.id = TextureFromFile(image.uri.c_str(), this->directory, gammaCorrection);
+            }
             textures_loaded.push_back(texture);
             return texture;
         }
@@ -1698,34 +2135,6 @@ private:
             return texture;
         }
 
-        GLenum format = GL_RGB;
-        switch (components)
-        {
-        case 1:
-            format = GL_RED;
-            break;
-        case 2:
-            format = GL_RG;
-            break;
-        case 3:
-            format = GL_RGB;
-            break;
-        case 4:
-        default:
-            format = GL_RGBA;
-            break;
-        }
-
-        GLenum internalFormat = format;
-        if (components == 3)
-        {
-            internalFormat = gammaCorrection ? GL_SRGB : GL_RGB;
-        }
-        else if (components == 4)
-        {
-            internalFormat = gammaCorrection ? GL_SRGB_ALPHA : GL_RGBA;
-        }
-
         auto resolvePixelType = [](int tinyType, int bits)
         {
             switch (tinyType)
@@ -1758,12 +2167,115 @@ private:
 
         GLenum pixelType = resolvePixelType(image.pixel_type, image.bits);
 
-        glGenTextures(1, &texture.id);
-        glBindTexture(GL_TEXTURE_2D, texture.id);
+        if (deferUpload)
+        {
+            PendingImage pending;
+            pending.cacheKey = cacheKey;
+            pending.width = width;
+            pending.height = height;
+            pending.components = components;
+            pending.pixelType = pixelType;
+            pending.pixels = image.image;
+            pending.sharedHandle = requestSharedPixels(pending);
+            pendingImages.push_back(std::move(pending));
+            texture.id = 0;
+        }
+        else
+        {
+            texture.id = createTexture(width, height, components, pixelType, image.image.data());
+        }
+
+        textures_loaded.push_back(texture);
+        return texture;
+    }
+
+    // worker-thread half of TextureFromFile: decode into pendingImages, the GL texture is made by UploadToGpu()
+    void decodeImageFile(const string &uri, const string &cacheKey)
+    {
+        string filename = uri;
+        filename.erase(std::remove_if(filename.begin(), filename.end(), [](char c)
+                                      { return c == '\r' || c == '\n'; }),
+                       filename.end());
+        std::replace(filename.begin(), filename.end(), '\\', '/');
+        filename = directory + '/' + filename;
+
+        if (textureProvider)
+        {
+            PendingImage pending;
+            pending.cacheKey = cacheKey;
+            pending.uri = uri;
+            pending.sharedHandle = textureProvider->RequestFile(filename, gammaCorrection);
+            if (pending.sharedHandle != 0)
+                pendingImages.push_back(std::move(pending));
+            return;
+        }
+
+        int width = 0, height = 0, components = 0;
+        unsigned char *data = stbi_load(filename.c_str(), &width, &height, &components, 0);
+        if (!data)
+        {
+            std::cout << "Texture failed to load at path: " << uri << " (resolved: " << filename << ") reason: "
+                      << stbi_failure_reason() << std::endl;
+            return;
+        }
+
+        PendingImage pending;
+        pending.cacheKey = cacheKey;
+        pending.uri = uri;
+        pending.width = width;
+        pending.height = height;
+        pending.components = components;
+        pending.pixels.assign(data, data + static_cast<size_t>(width) * height * components);
+        stbi_image_free(data);
+        pendingImages.push_back(std::move(pending));
+    }
+
+    // embedded images keep their pixels for Serialize(); only 8-bit ones are shared
+    unsigned int requestSharedPixels(const PendingImage &image) const
+    {
+        if (!textureProvider || image.pixelType != GL_UNSIGNED_BYTE || image.pixels.empty())
+            return 0;
+        return textureProvider->RequestPixels(image.cacheKey, image.pixels.data(), image.width, image.height, image.components,
+                                              gammaCorrection);
+    }
+
+    unsigned int createTexture(int width, int height, int components, GLenum pixelType, const void *pixels) const
+    {
+        GLenum format = GL_RGB;
+        switch (components)
+        {
+        case 1:
+            format = GL_RED;
+            break;
+        case 2:
+            format = GL_RG;
+            break;
+        case 3:
+            format = GL_RGB;
+            break;
+        case 4:
+        default:
+            format = GL_RGBA;
+            break;
+        }
+
+        GLenum internalFormat = format;
+        if (components == 3)
+        {
+            internalFormat = gammaCorrection ? GL_SRGB : GL_RGB;
+        }
+        else if (components == 4)
+        {
+            internalFormat = gammaCorrection ? GL_SRGB_ALPHA : GL_RGBA;
+        }
+
+        unsigned int id = 0;
+        glGenTextures(1, &id);
+        glBindTexture(GL_TEXTURE_2D, id);
         GLint previousUnpackAlignment = 4;
         glGetIntegerv(GL_UNPACK_ALIGNMENT, &previousUnpackAlignment);
         glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, pixelType, image.image.data());
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, pixelType, pixels);
         glGenerateMipmap(GL_TEXTURE_2D);
 
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -1772,9 +2284,7 @@ private:
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
         glPixelStorei(GL_UNPACK_ALIGNMENT, previousUnpackAlignment);
-
-        textures_loaded.push_back(texture);
-        return texture;
+        return id;
     }
 };
 
@@ -0,0 +1,202 @@
+#ifndef VERTEX_LAYOUT_H
+#define VERTEX_LAYOUT_H
+
+#include <glad/glad.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// what a vertex attribute carries; the encoding is chosen by its GL type
+enum class VertexSemantic
+{
+    Position,
+    Normal,
+    TexCoord,
+    Tangent, // w holds the bitangent sign, bitangent = cross(normal, tangent) * w
+    BoneIds,
+    Weights
+};
+
+struct VertexAttribute
+{
+    VertexSemantic semantic;
+    GLuint location;
+    GLint components;
+    GLenum type;
+    GLboolean normalized;
+    bool integer; // bound with glVertexAttribIPointer
+    unsigned int offset;
+};
+
+// GPU vertex format of a mesh: which attributes exist, how they are encoded and where they sit in the
+// interleaved buffer. Attribute locations match the shaders (0 pos, 1 normal, 2 uv, 3 tangent, 5 bones, 6 weights).
+struct VertexLayout
+{
+    std::vector<VertexAttribute> attributes;
+    unsigned int stride = 0;
+
+    bool isSkinned() const
+    {
+        return std::any_of(attributes.begin(), attributes.end(), [](const VertexAttribute &a)
+                           { return a.semantic == VertexSemantic::BoneIds; });
+    }
+
+    // float position, 10-10-10-2 normal and tangent, half or float uvs, uint8 bone ids and unorm8 weights
+    static VertexLayout compact(bool skinned, bool halfTexCoords)
+    {
+        VertexLayout layout;
+        layout.add(VertexSemantic::Position, 0, 3, GL_FLOAT, GL_FALSE, false, 12);
+        layout.add(VertexSemantic::Normal, 1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, false, 4);
+        layout.add(VertexSemantic::Tangent, 3, 4, GL_INT_2_10_10_10_REV, GL_TRUE, false, 4);
+        if (halfTexCoords)
+            layout.add(VertexSemantic::TexCoord, 2, 2, GL_HALF_FLOAT, GL_FALSE, false, 4);
+        else
+            layout.add(VertexSemantic::TexCoord, 2, 2, GL_FLOAT, GL_FALSE, false, 8);
+        if (skinned)
+        {
+            layout.add(VertexSemantic::BoneIds, 5, 4, GL_UNSIGNED_BYTE, GL_FALSE, true, 4);
+            layout.add(VertexSemantic::Weights, 6, 4, GL_UNSIGNED_BYTE, GL_TRUE, false, 4);
+        }
+        return layout;
+    }
+
+    // position, normal and uv only, for meshes that are never normal mapped or skinned
+    static VertexLayout positionNormalUv(bool halfTexCoords)
+    {
+        VertexLayout layout;
+        layout.add(VertexSemantic::Position, 0, 3, GL_FLOAT, GL_FALSE, false, 12);
+        layout.add(VertexSemantic::Normal, 1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, false, 4);
+        if (halfTexCoords)
+            layout.add(VertexSemantic::TexCoord, 2, 2, GL_HALF_FLOAT, GL_FALSE, false, 4);
+        else
+            layout.add(VertexSemantic::TexCoord, 2, 2, GL_FLOAT, GL_FALSE, false, 8);
+        return layout;
+    }
+
+    // half floats keep ~11 bits of mantissa, enough for uvs near the unit square but not for tiled ones
+    template <typename VertexT>
+    static bool fitsHalfTexCoords(const std::vector<VertexT> &vertices)
+    {
+        for (const VertexT &v : vertices)
+        {
+            if (std::abs(v.TexCoords.x) > 2.0f || std::abs(v.TexCoords.y) > 2.0f)
+                return false;
+        }
+        return true;
+    }
+
+    // encodes vertices (anything with Position/Normal/TexCoords/Tangent/Bitangent/m_BoneIDs/m_Weights) into this layout
+    template <typename VertexT>
+    std::vector<unsigned char> pack(const std::vector<VertexT> &vertices) const
+    {
+        std::vector<unsigned char> data(vertices.size() * stride);
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            const VertexT &v = vertices[i];
+            unsigned char *dst = data.data() + i * stride;
+            for (const VertexAttribute &attribute : attributes)
+            {
+                unsigned char *out = dst + attribute.offset;
+                switch (attribute.semantic)
+                {
+                case VertexSemantic::Position:
+                    std::memcpy(out, &v.Position, sizeof(glm::vec3));
+                    break;
+                case VertexSemantic::Normal:
+                    writeU32(out, packDirection(v.Normal, 0.0f));
+                    break;
+                case VertexSemantic::Tangent:
+                    writeU32(out, packDirection(v.Tangent, bitangentSign(v.Normal, v.Tangent, v.Bitangent)));
+                    break;
+                case VertexSemantic::TexCoord:
+                    if (attribute.type == GL_HALF_FLOAT)
+                        writeU32(out, glm::packHalf2x16(v.TexCoords));
+                    else
+                        std::memcpy(out, &v.TexCoords, sizeof(glm::vec2));
+                    break;
+                case VertexSemantic::BoneIds:
+                case VertexSemantic::Weights:
+                {
+                    uint8_t ids[4];
+                    uint8_t weights[4];
+                    quantizeInfluences(v.m_BoneIDs, v.m_Weights, ids, weights);
+                    std::memcpy(out, attribute.semantic == VertexSemantic::BoneIds ? ids : weights, 4);
+                    break;
+                }
+                }
+            }
+        }
+        return data;
+    }
+
+    // points the attributes of the bound VAO at the bound array buffer
+    void apply() const
+    {
+        for (const VertexAttribute &attribute : attributes)
+        {
+            glEnableVertexAttribArray(attribute.location);
+            const void *offset = reinterpret_cast<const void *>(static_cast<uintptr_t>(attribute.offset));
+            if (attribute.integer)
+                glVertexAttribIPointer(attribute.location, attribute.components, attribute.type, stride, offset);
+            else
+                glVertexAttribPointer(attribute.location, attribute.components, attribute.type, attribute.normalized, stride, offset);
+        }
+    }
+
+private:
+    void add(VertexSemantic semantic, GLuint location, GLint components, GLenum type, GLboolean normalized, bool integer,
+             unsigned int size)
+    {
+        attributes.push_back(VertexAttribute{semantic, location, components, type, normalized, integer, stride});
+        stride += size;
+    }
+
+    static void writeU32(unsigned char *out, uint32_t value) { std::memcpy(out, &value, sizeof(value)); }
+
+    // -1 when the bitangent points against cross(normal, tangent) (mirrored uvs); +1 otherwise, also without one
+    static float bitangentSign(const glm::vec3 &normal, const glm::vec3 &tangent, const glm::vec3 &bitangent)
+    {
+        return glm::dot(glm::cross(normal, tangent), bitangent) < 0.0f ? -1.0f : 1.0f;
+    }
+
+    static uint32_t packDirection(const glm::vec3 &direction, float w)
+    {
+        const float length = glm::length(direction);
+        const glm::vec3 unit = length > 0.0f ? direction / length : glm::vec3(0.0f);
+        return glm::packSnorm3x10_1x2(glm::vec4(unit, w));
+    }
+
+    // ids outside 0..255 are dropped; weights are renormalised so the bytes always sum to 255
+    static void quantizeInfluences(const int *sourceIds, const float *sourceWeights, uint8_t *ids, uint8_t *weights)
+    {
+        float total = 0.0f;
+        for (int i = 0; i < 4; ++i)
+        {
+            const bool valid = sourceIds[i] >= 0 && sourceIds[i] <= 255 && sourceWeights[i] > 0.0f;
+            ids[i] = valid ? static_cast<uint8_t>(sourceIds[i]) : 0;
+            total += valid ? sourceWeights[i] : 0.0f;
+        }
+
+        int sum = 0;
+        int largest = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            const bool valid = sourceIds[i] >= 0 && sourceIds[i] <= 255 && sourceWeights[i] > 0.0f;
+            const int quantized = (valid && total > 0.0f) ? static_cast<int>(std::lround(sourceWeights[i] / total * 255.0f)) : 0;
+            weights[i] = static_cast<uint8_t>(std::clamp(quantized, 0, 255));
+            sum += weights[i];
+            if (weights[i] > weights[largest])
+                largest = i;
+        }
+        if (sum > 0)
+            weights[largest] = static_cast<uint8_t>(std::clamp(weights[largest] + 255 - sum, 0, 255));
+    }
+};
+
+#endif
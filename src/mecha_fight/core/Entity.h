@@ -8,6 +8,8 @@ struct GLFWwindow;
 
 namespace mecha
 {
+  class ShadowMapper;
+
   struct Transform
   {
     glm::vec3 position{0.0f, 0.0f, 0.0f};
@@ -22,6 +24,14 @@ namespace mecha
     void *userData{nullptr};
   };
 
+  // Which casters a shadow pass should draw when static casters are cached separately
+  enum class ShadowCasterSet
+  {
+    All,
+    StaticOnly,
+    DynamicOnly
+  };
+
   struct RenderContext
   {
     float deltaTime{0.0f};
@@ -29,15 +39,11 @@ namespace mecha
     glm::mat4 view{1.0f};
     glm::vec3 viewPos{0.0f};
     glm::mat4 lightSpaceMatrix{1.0f};
-    glm::vec3 lightPos{0.0f};
-    glm::vec3 lightIntensity{1.0f, 1.0f, 1.0f};
-    unsigned int shadowMapTexture{0};
-    unsigned int ssaoTexture{0};
-    glm::vec2 screenSize{0.0f};
+    const ShadowMapper *shadowMapper{nullptr};
+    int shadowCascade{-1}; // cascade being rendered during the shadow pass, -1 otherwise
+    ShadowCasterSet shadowCasters{ShadowCasterSet::All};
     bool shadowPass{false};
     Shader *overrideShader{nullptr};
-    bool ssaoEnabled{false};
-    float ssaoStrength{1.0f};
   };
 
   class Entity
@@ -57,6 +63,12 @@ namespace mecha
     {
     }
 
+    // Casters that never move are baked into the cached static shadow layer
+    virtual bool IsStaticShadowCaster() const
+    {
+      return false;
+    }
+
     void SetFramePayload(void *payload)
     {
       framePayload_ = payload;
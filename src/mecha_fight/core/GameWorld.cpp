@@ -51,10 +51,16 @@ namespace mecha
 
   void GameWorld::Render(const RenderContext &ctx)
   {
+    const bool filterCasters = ctx.shadowPass && ctx.shadowCasters != ShadowCasterSet::All;
+    const bool wantStatic = ctx.shadowCasters == ShadowCasterSet::StaticOnly;
     for (auto &entity : entities_)
     {
       if (entity)
       {
+        if (filterCasters && entity->IsStaticShadowCaster() != wantStatic)
+        {
+          continue;
+        }
         entity->Render(ctx);
       }
     }
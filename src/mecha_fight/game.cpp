@@ -40,6 +40,7 @@
 #include "game/systems/ProjectileSystem.h"
 #include "game/systems/MissileSystem.h"
 #include "game/ui/DebugTextRenderer.h"
+#include "game/ui/FontService.h"
 #include "game/ui/DeveloperOverlayUI.h"
 #include "game/ui/HudRenderer.h"
 #include "game/particles/AfterimageParticleSystem.h"
@@ -59,6 +60,7 @@
 #include "game/audio/MiniaudioSoundController.h"
 #include "game/audio/ProximitySoundSystem.h"
 #include "game/audio/SoundManager.h"
+#include "game/audio/GameSounds.h"
 #include "game/audio/SoundRegistry.h"
 #include "game/audio/BackgroundMusicSystem.h"
 #include "game/ui/MainMenu.h"
@@ -85,6 +87,7 @@ using mecha::MainMenu;
 using mecha::MechaPlayer;
 using mecha::MiniaudioSoundController;
 using mecha::MissileSystem;
+using mecha::ModelLoader;
 using mecha::MovementState;
 using mecha::ProjectileSystem;
 using mecha::ProximitySoundSystem;
@@ -115,6 +118,7 @@ constexpr float kInitialMasterVolume = 1.0f; // Adjust this to change the game's
 unsigned int SCR_WIDTH = 1600;
 unsigned int SCR_HEIGHT = 900;
 
+static mecha::FontService gFontService;
 static mecha::DebugTextRenderer gDebugText;
 static DeveloperOverlayState gDevOverlay;
 [[maybe_unused]] static bool gDevOverlayVolumeInitialized = []()
@@ -139,6 +143,7 @@ static std::shared_ptr<DashParticleSystem> gDashParticleSystem;
 static std::shared_ptr<mecha::SparkParticleSystem> gSparkParticleSystem;
 static std::shared_ptr<ShockwaveParticleSystem> gShockwaveSystem;
 static HudRenderer gHudRenderer;
+static HudRenderer::HudRenderData gHudData; // Kept across frames so its blip vectors keep their capacity
 static GameHUD gGameHUD;
 static InputController gInputController;
 static SceneRenderer gSceneRenderer;
@@ -157,6 +162,7 @@ static mecha::ThirdPersonCamera gCamera;
 // Sound system
 static std::unique_ptr<MiniaudioSoundController> gSoundController;
 static std::unique_ptr<SoundManager> gSoundManager;
+static mecha::GameSounds gSounds; // Ids handed to entities with the sound manager
 static std::shared_ptr<ProximitySoundSystem> gProximitySoundSystem;
 static std::unique_ptr<mecha::BackgroundMusicSystem> gBackgroundMusic;
 
@@ -208,7 +214,7 @@ void framebuffer_size_callback(GLFWwindow *window, int width, int height)
     // make sure the viewport matches the new window dimensions; note that width and
     // height will be significantly larger than specified on retina displays.
     glViewport(0, 0, width, height);
-    gDebugText.Resize(width, height);
+    gFontService.Resize(width, height);
     gMainMenu.Resize(width, height);
 }
 
@@ -283,14 +289,38 @@ int main()
     SetCursorCapture(window, true);
 
     // Initialize debug systems
-    if (!initializer.InitializeDebugSystems(gDebugText, SCR_WIDTH, SCR_HEIGHT))
+    if (!initializer.InitializeDebugSystems(gFontService, gDebugText, SCR_WIDTH, SCR_HEIGHT))
     {
         glfwTerminate();
         return -1;
     }
 
-    // Load all resources
-    if (!initializer.LoadResources(gResourceManager, gTerrainConfig))
+    // Initialize main menu first so it can show loading progress
+    const std::string menuBackgroundPath = FileSystem::getPath("resources/images/main-menu.png");
+    if (!gMainMenu.Initialize(SCR_WIDTH, SCR_HEIGHT, menuBackgroundPath, gFontService))
+    {
+        std::cerr << "[Game] Warning: Main menu initialization failed, continuing without background" << std::endl;
+    }
+
+    // Load all resources, redrawing the menu's loading bar between steps
+    auto showLoadingProgress = [window](float progress, const std::string &label)
+    {
+        gMainMenu.SetLoadingProgress(progress, label);
+        Shader *uiShader = gResourceManager.Shaders().GetShader("ui");
+        if (!uiShader)
+        {
+            return;
+        }
+
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glDisable(GL_DEPTH_TEST);
+        gMainMenu.Render(*uiShader, gResourceManager.GetUIQuadVAO());
+        glEnable(GL_DEPTH_TEST);
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+    };
+    if (!initializer.LoadResources(gResourceManager, gTerrainConfig, showLoadingProgress))
     {
         glfwTerminate();
         return -1;
@@ -339,57 +369,55 @@ int main()
             gWorld.AddEntity(gProximitySoundSystem);
         }
 
+        // 3D sounds share a voice budget; priority decides who keeps a voice, maxInstances caps
+        // how many copies of one sound (drone hums, impacts) are audible at once
+        gSoundManager->SetMixerPolicy(SoundManager::MixerPolicy{32, 0.001f});
+
         // Register all sounds with the manager
-        gSoundManager->RegisterSound("PLAYER_SHOOT",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::PLAYER_SHOOT, 0.7f, 100.0f, false, 0.0f});
-        gSoundManager->RegisterSound("PLAYER_DASH",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::PLAYER_DASH, 0.2f, 60.0f, false, 0.0f});
-        gSoundManager->RegisterSound("PLAYER_MELEE",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::PLAYER_MELEE, 1.0f, 50.0f, false, 0.0f});
-        gSoundManager->RegisterSound("PLAYER_MELEE_CONTINUE",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::PLAYER_MELEE_CONTINUE, 0.8f, 50.0f, true, 0.0f});
-        gSoundManager->RegisterSound("PLAYER_DAMAGE",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::PLAYER_DAMAGE, 0.8f, 40.0f, false, 0.25f});
-        gSoundManager->RegisterSound("PLAYER_FLIGHT",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::PLAYER_FLIGHT, 0.9f, 80.0f, true, 0.0f});
-        gSoundManager->RegisterSound("PLAYER_WALKING",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::PLAYER_WALKING, 1.5f, 40.0f, true, 0.0f});
-        gSoundManager->RegisterSound("PLAYER_LASER",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::PLAYER_LASER, 0.7f, 60.0f, true, 0.0f});
-
-        gSoundManager->RegisterSound("ENEMY_SHOOT",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::ENEMY_SHOOT, 0.6f, 50.0f, false, 0.05f});
-        gSoundManager->RegisterSound("ENEMY_DEATH",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::ENEMY_DEATH, 0.8f, 60.0f, false, 0.1f});
-        gSoundManager->RegisterSound("ENEMY_DRONE_MOVEMENT",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::ENEMY_DRONE_MOVEMENT, 0.05f, 80.0f, true, 0.0f});
-        gSoundManager->RegisterSound("ENEMY_TURRET_LASER",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::ENEMY_TURRET_LASER, 0.7f, 200.0f, true, 0.0f});
-
-        gSoundManager->RegisterSound("PROJECTILE_IMPACT",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::PROJECTILE_IMPACT, 0.7f, 40.0f, false, 0.05f});
-        gSoundManager->RegisterSound("MISSILE_LAUNCH",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::MISSILE_LAUNCH, 0.8f, 100.0f, true, 0.0f});
-        gSoundManager->RegisterSound("MISSILE_EXPLOSION",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::MISSILE_EXPLOSION, 10.0f, 3000.0f, false, 0.2f});
-
-        gSoundManager->RegisterSound("BOSS_DEATH",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::BOSS_DEATH, 3.0f, 7500.0f, false, 0.0f});
-        gSoundManager->RegisterSound("BOSS_MOVEMENT",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::BOSS_MOVEMENT, 2.0f, 3000.0f, true, 0.0f});
-        gSoundManager->RegisterSound("BOSS_PROJECTILE",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::BOSS_PROJECTILE, 0.4f, 220.0f, false, 0.05f});
-        gSoundManager->RegisterSound("BOSS_SHOCKWAVE",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::BOSS_SHOCKWAVE, 2.5f, 500.0f, false, 0.0f});
-
-        gSoundManager->RegisterSound("GATE_COLLAPSE",
-                                     SoundManager::SoundConfig{mecha::SoundRegistry::GATE_COLLAPSE, 1.0f, 120.0f, false, 0.0f});
-
-        // Preload all registered sounds
-        for (const auto &[soundName, config] : gSoundManager->GetRegisteredSounds())
-        {
-            gSoundManager->PreloadSound(soundName);
-        }
+        gSounds.playerShoot = gSoundManager->RegisterSound("PLAYER_SHOOT",
+                                                           SoundManager::SoundConfig{mecha::SoundRegistry::PLAYER_SHOOT, 0.7f, 100.0f, false, 0.0f, 3, 0});
+        gSounds.playerDash = gSoundManager->RegisterSound("PLAYER_DASH",
+                                                          SoundManager::SoundConfig{mecha::SoundRegistry::PLAYER_DASH, 0.2f, 60.0f, false, 0.0f, 3, 0});
+        gSounds.playerMelee = gSoundManager->RegisterSound("PLAYER_MELEE",
+                                                           SoundManager::SoundConfig{mecha::SoundRegistry::PLAYER_MELEE, 1.0f, 50.0f, false, 0.0f, 3, 0});
+        gSounds.playerMeleeContinue = gSoundManager->RegisterSound("PLAYER_MELEE_CONTINUE",
+                                                                   SoundManager::SoundConfig{mecha::SoundRegistry::PLAYER_MELEE_CONTINUE, 0.8f, 50.0f, true, 0.0f, 3, 0});
+        gSounds.playerDamage = gSoundManager->RegisterSound("PLAYER_DAMAGE",
+                                                            SoundManager::SoundConfig{mecha::SoundRegistry::PLAYER_DAMAGE, 0.8f, 40.0f, false, 0.25f, 3, 0});
+        gSounds.playerFlight = gSoundManager->RegisterSound("PLAYER_FLIGHT",
+                                                            SoundManager::SoundConfig{mecha::SoundRegistry::PLAYER_FLIGHT, 0.9f, 80.0f, true, 0.0f, 3, 0});
+        gSounds.playerWalking = gSoundManager->RegisterSound("PLAYER_WALKING",
+                                                             SoundManager::SoundConfig{mecha::SoundRegistry::PLAYER_WALKING, 1.5f, 40.0f, true, 0.0f, 3, 0});
+        gSounds.playerLaser = gSoundManager->RegisterSound("PLAYER_LASER",
+                                                           SoundManager::SoundConfig{mecha::SoundRegistry::PLAYER_LASER, 0.7f, 60.0f, true, 0.0f, 3, 0});
+
+        gSounds.enemyShoot = gSoundManager->RegisterSound("ENEMY_SHOOT",
+                                                          SoundManager::SoundConfig{mecha::SoundRegistry::ENEMY_SHOOT, 0.6f, 50.0f, false, 0.05f, 1, 6});
+        gSounds.enemyDeath = gSoundManager->RegisterSound("ENEMY_DEATH",
+                                                          SoundManager::SoundConfig{mecha::SoundRegistry::ENEMY_DEATH, 0.8f, 60.0f, false, 0.1f, 2, 4});
+        gSounds.enemyDroneMovement = gSoundManager->RegisterSound("ENEMY_DRONE_MOVEMENT",
+                                                                  SoundManager::SoundConfig{mecha::SoundRegistry::ENEMY_DRONE_MOVEMENT, 0.05f, 80.0f, true, 0.0f, 0, 3});
+        gSounds.enemyTurretLaser = gSoundManager->RegisterSound("ENEMY_TURRET_LASER",
+                                                                SoundManager::SoundConfig{mecha::SoundRegistry::ENEMY_TURRET_LASER, 0.7f, 200.0f, true, 0.0f, 1, 4});
+
+        gSounds.projectileImpact = gSoundManager->RegisterSound("PROJECTILE_IMPACT",
+                                                                SoundManager::SoundConfig{mecha::SoundRegistry::PROJECTILE_IMPACT, 0.7f, 40.0f, false, 0.05f, 0, 6});
+        gSounds.missileLaunch = gSoundManager->RegisterSound("MISSILE_LAUNCH",
+                                                             SoundManager::SoundConfig{mecha::SoundRegistry::MISSILE_LAUNCH, 0.8f, 100.0f, true, 0.0f, 2, 4});
+        gSounds.missileExplosion = gSoundManager->RegisterSound("MISSILE_EXPLOSION",
+                                                                SoundManager::SoundConfig{mecha::SoundRegistry::MISSILE_EXPLOSION, 10.0f, 3000.0f, false, 0.2f, 2, 4});
+
+        gSounds.bossDeath = gSoundManager->RegisterSound("BOSS_DEATH",
+                                                         SoundManager::SoundConfig{mecha::SoundRegistry::BOSS_DEATH, 3.0f, 7500.0f, false, 0.0f, 4, 0});
+        gSounds.bossMovement = gSoundManager->RegisterSound("BOSS_MOVEMENT",
+                                                            SoundManager::SoundConfig{mecha::SoundRegistry::BOSS_MOVEMENT, 2.0f, 3000.0f, true, 0.0f, 4, 0});
+        gSounds.bossProjectile = gSoundManager->RegisterSound("BOSS_PROJECTILE",
+                                                              SoundManager::SoundConfig{mecha::SoundRegistry::BOSS_PROJECTILE, 0.4f, 220.0f, false, 0.05f, 2, 6});
+        gSounds.bossShockwave = gSoundManager->RegisterSound("BOSS_SHOCKWAVE",
+                                                             SoundManager::SoundConfig{mecha::SoundRegistry::BOSS_SHOCKWAVE, 2.5f, 500.0f, false, 0.0f, 4, 0});
+
+        gSounds.gateCollapse = gSoundManager->RegisterSound("GATE_COLLAPSE",
+                                                            SoundManager::SoundConfig{mecha::SoundRegistry::GATE_COLLAPSE, 1.0f, 120.0f, false, 0.0f, 3, 0});
 
         // Register with ResourceManager for unified access
         gResourceManager.SetSoundManager(gSoundManager.get());
@@ -429,6 +457,7 @@ int main()
     inputDeps.sparkParticles = &sparkParticles;
     inputDeps.shockwaveParticles = &shockwaveParticles;
     inputDeps.soundManager = gSoundManager.get();
+    inputDeps.sounds = gSounds;
     gInputController.SetDependencies(inputDeps);
 
     // Setup camera terrain sampler
@@ -457,6 +486,7 @@ int main()
     renderConfig.ssaoBias = 0.025f;
     renderConfig.ssaoPower = 0.85f;
     renderConfig.ssaoStrength = 0.25f;
+    renderConfig.ssaoResolutionMode = gDevOverlay.ssaoResolutionMode;
     renderConfig.enableSkybox = true;
     renderConfig.skyboxIntensity = 1.0f;
     renderConfig.skyboxTint = glm::vec3(1.0f);
@@ -467,15 +497,23 @@ int main()
         return -1;
     }
 
-    gSceneRenderer.SetDependencies(&gResourceManager, &gShadowMapper, &gWorld);
+    if (!gHudRenderer.Initialize(*gResourceManager.Shaders().GetShader("ui_batch")))
+    {
+        std::cerr << "[Game] Warning: HUD batch initialization failed" << std::endl;
+    }
 
-    // Initialize main menu
-    const std::string menuBackgroundPath = FileSystem::getPath("resources/images/main-menu.png");
-    if (!gMainMenu.Initialize(SCR_WIDTH, SCR_HEIGHT, menuBackgroundPath))
+    gSceneRenderer.SetDependencies(&gResourceManager, &gShadowMapper, &gWorld);
+    if (!gSceneRenderer.BuildTerrainChunks(gTerrainConfig))
     {
-        std::cerr << "[Game] Warning: Main menu initialization failed, continuing without background" << std::endl;
+        std::cerr << "[Game] Warning: Terrain chunking failed, drawing the terrain as a single model" << std::endl;
     }
 
+    // Chunks are built and the heightfield is baked, so nothing reads terrain geometry on the CPU anymore
+    gResourceManager.Models().SetCpuRetention("mountain_range_01", ModelLoader::CpuRetention::Release);
+    gResourceManager.Models().ReleaseCpuData();
+    gResourceManager.Models().PrintMemoryReport();
+    gResourceManager.Textures().PrintVramReport();
+
     // Initialize game over screen
     if (!gGameOverScreen.Initialize(SCR_WIDTH, SCR_HEIGHT))
     {
@@ -495,6 +533,7 @@ int main()
         float frameDelta = currentFrame - lastFrame;
         lastFrame = currentFrame;
         deltaTime = frameDelta * gDevOverlay.timeScale;
+        gFontService.EndFrame();
 
         // Handle main menu state
         if (gGameState == GameState::MainMenu)
@@ -659,6 +698,12 @@ int main()
             }
         }
 
+        // Apply SSAO resolution from developer overlay
+        if (gSceneRenderer.GetSSAOResolutionMode() != gDevOverlay.ssaoResolutionMode)
+        {
+            gSceneRenderer.SetSSAOResolutionMode(gDevOverlay.ssaoResolutionMode);
+        }
+
         // Prepare frame data for rendering
         glm::mat4 projection = glm::perspective(glm::radians(gCamera.GetCamera().Zoom),
                                                 (float)SCR_WIDTH / (float)SCR_HEIGHT,
@@ -870,7 +915,7 @@ int main()
         GameHUD::HUDState hudState = gGameHUD.CalculateHUDState(gMecha, SCR_WIDTH, SCR_HEIGHT, FOCUS_CIRCLE_RADIUS);
 
         // Convert to renderer format
-        HudRenderer::HudRenderData hudData{};
+        HudRenderer::HudRenderData &hudData = gHudData;
         hudData.screenSize = hudState.screenSize;
         hudData.crosshairPos = hudState.crosshairPos;
         hudData.focusCircleRadius = hudState.focusCircleRadius;
@@ -1024,15 +1069,21 @@ int main()
 
         hudData.minimapWorldRange = 100.0f;         // Show 100 units around player
         hudData.playerYawDegrees = mechaYawDegrees; // Player rotation for minimap orientation
+        hudData.frameTime = frameDelta;
 
-        Shader *uiShader = gResourceManager.Shaders().GetShader("ui");
-        gHudRenderer.Render(hudData, *uiShader, gResourceManager.GetUIQuadVAO());
+        gHudRenderer.Render(hudData);
 
         // Render objective display below minimap
-        gHudRenderer.RenderObjective(hudData, *uiShader, gResourceManager.GetUIQuadVAO(), gDebugText);
+        gHudRenderer.RenderObjective(hudData, gDebugText);
 
         // Render boss health bar at bottom of screen
-        gHudRenderer.RenderBossHealthBar(hudData, *uiShader, gResourceManager.GetUIQuadVAO(), gDebugText);
+        gHudRenderer.RenderBossHealthBar(hudData, gDebugText);
+
+        // The whole HUD in one batch, then its text on top
+        gHudRenderer.Flush(*gResourceManager.Shaders().GetShader("ui_batch"), hudData.screenSize);
+        gDebugText.Flush();
+
+        Shader *uiShader = gResourceManager.Shaders().GetShader("ui");
 
         mecha::DeveloperOverlayUI::RenderParams overlayParams{
             *uiShader,
@@ -1064,6 +1115,8 @@ int main()
 
     // Shutdown main menu
     gMainMenu.Shutdown();
+    gHudRenderer.Shutdown();
+    gFontService.Shutdown();
 
     // Shutdown sound system
     if (gSoundController)
@@ -1,21 +1,12 @@
 #pragma once
 
-#include <functional>
-
 #include <glm/glm.hpp>
 
+#include "placeholder/HeightField.h"
+
 namespace mecha
 {
 
-  struct TerrainHeightSampler
-  {
-    std::function<float(float, float)> callback;
-    float operator()(float x, float z) const
-    {
-      return callback ? callback(x, z) : 0.0f;
-    }
-  };
-
   struct ThrusterParticle
   {
     glm::vec3 pos{0.0f};
@@ -25,7 +25,7 @@ namespace mecha
       return;
     }
 
-    // Preload all music tracks
+    // Preload all music tracks (compressed bytes only; they are decoded while streaming)
     for (const auto &track : normalTracks_)
     {
       soundController_->PreloadSound(track.c_str());
@@ -96,6 +96,7 @@ namespace mecha
           {
             // Just fading out, set stage to None
             currentStage_ = MusicStage::None;
+            ReleasePreparedTrack();
             isFadingOut_ = false;
           }
         }
@@ -134,7 +135,8 @@ namespace mecha
     }
     else
     {
-      // Crossfade: first fade out current track
+      // Crossfade: first fade out current track; the new stage's stream pre-rolls meanwhile
+      PrepareTrack(stage, 0);
       StartFade(0.0f, fadeDuration * 0.5f); // Fade out in half the time
     }
 
@@ -164,6 +166,7 @@ namespace mecha
       soundController_->StopSound(currentTrackHandle_);
       currentTrackHandle_ = nullptr;
     }
+    ReleasePreparedTrack();
 
     currentStage_ = MusicStage::None;
     targetStage_ = MusicStage::None;
@@ -207,14 +210,22 @@ namespace mecha
     }
 
     // Get the track to play
-    const std::string &trackPath = tracks[currentTrackIndex_ % tracks.size()];
+    const size_t trackIndex = currentTrackIndex_ % tracks.size();
+    const std::string &trackPath = tracks[trackIndex];
 
-    // Play as 2D sound (background music), not looped (we handle looping manually)
-    currentTrackHandle_ = soundController_->Play2D(trackPath.c_str(), false, currentVolume_);
+    // Streamed, not looped (we handle looping manually); normally it was prepared already
+    PrepareTrack(currentStage_, trackIndex);
+    currentTrackHandle_ = nextTrackHandle_;
+    nextTrackHandle_ = nullptr;
+    nextTrackStage_ = MusicStage::None;
 
     if (currentTrackHandle_)
     {
+      soundController_->PlayStream(currentTrackHandle_, currentVolume_);
       std::cout << "[BackgroundMusicSystem] Playing track: " << trackPath << std::endl;
+
+      // Buffer the following track while this one plays
+      PrepareTrack(currentStage_, (trackIndex + 1) % tracks.size());
     }
     else
     {
@@ -222,6 +233,35 @@ namespace mecha
     }
   }
 
+  void BackgroundMusicSystem::PrepareTrack(MusicStage stage, size_t trackIndex)
+  {
+    if (nextTrackHandle_ && nextTrackStage_ == stage && nextTrackIndex_ == trackIndex)
+    {
+      return;
+    }
+    ReleasePreparedTrack();
+
+    const auto &tracks = GetTracksForStage(stage);
+    if (trackIndex >= tracks.size())
+    {
+      return;
+    }
+
+    nextTrackHandle_ = soundController_->OpenStream(tracks[trackIndex].c_str(), false);
+    nextTrackStage_ = stage;
+    nextTrackIndex_ = trackIndex;
+  }
+
+  void BackgroundMusicSystem::ReleasePreparedTrack()
+  {
+    if (nextTrackHandle_)
+    {
+      soundController_->StopSound(nextTrackHandle_);
+      nextTrackHandle_ = nullptr;
+    }
+    nextTrackStage_ = MusicStage::None;
+  }
+
   const std::vector<std::string> &BackgroundMusicSystem::GetTracksForStage(MusicStage stage) const
   {
     static const std::vector<std::string> empty;
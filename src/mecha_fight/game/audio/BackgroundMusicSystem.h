@@ -15,6 +15,10 @@ namespace mecha
    * - Crossfade transitions between stages
    * - Multiple tracks per stage with sequential playback
    * - Fade out on specific events (boss death)
+   *
+   * Tracks are streamed. The track that plays next (the following one of the stage, or the
+   * first of the stage being crossfaded to) is opened ahead of time so its stream is already
+   * buffered when it starts.
    */
   class BackgroundMusicSystem
   {
@@ -87,6 +91,9 @@ namespace mecha
     MusicStage currentStage_{MusicStage::None};
     MusicStage targetStage_{MusicStage::None};
     void *currentTrackHandle_{nullptr};
+    void *nextTrackHandle_{nullptr}; // Opened (pre-rolling) but not started
+    MusicStage nextTrackStage_{MusicStage::None};
+    size_t nextTrackIndex_{0};
     float baseVolume_{0.5f};
     float currentVolume_{0.0f};
 
@@ -108,6 +115,16 @@ namespace mecha
      */
     void PlayNextTrack();
 
+    /**
+     * @brief Open a track's stream ahead of time so it is buffered before it plays
+     */
+    void PrepareTrack(MusicStage stage, size_t trackIndex);
+
+    /**
+     * @brief Close the prepared track, if any
+     */
+    void ReleasePreparedTrack();
+
     /**
      * @brief Get the tracks for a given stage
      */
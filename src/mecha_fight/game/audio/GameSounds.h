@@ -0,0 +1,42 @@
+#pragma once
+
+#include "SoundManager.h"
+
+namespace mecha
+{
+
+  /**
+   * @brief Ids of every sound the game plays, filled once when game.cpp registers them
+   *
+   * Handed to entities and systems next to the SoundManager, so a play is an array lookup
+   * by id instead of a name lookup. Unregistered entries stay kInvalidSoundId.
+   */
+  struct GameSounds
+  {
+    SoundId playerShoot{kInvalidSoundId};
+    SoundId playerDash{kInvalidSoundId};
+    SoundId playerMelee{kInvalidSoundId};
+    SoundId playerMeleeContinue{kInvalidSoundId};
+    SoundId playerDamage{kInvalidSoundId};
+    SoundId playerFlight{kInvalidSoundId};
+    SoundId playerWalking{kInvalidSoundId};
+    SoundId playerLaser{kInvalidSoundId};
+
+    SoundId enemyShoot{kInvalidSoundId};
+    SoundId enemyDeath{kInvalidSoundId};
+    SoundId enemyDroneMovement{kInvalidSoundId};
+    SoundId enemyTurretLaser{kInvalidSoundId};
+
+    SoundId projectileImpact{kInvalidSoundId};
+    SoundId missileLaunch{kInvalidSoundId};
+    SoundId missileExplosion{kInvalidSoundId};
+
+    SoundId bossDeath{kInvalidSoundId};
+    SoundId bossMovement{kInvalidSoundId};
+    SoundId bossProjectile{kInvalidSoundId};
+    SoundId bossShockwave{kInvalidSoundId};
+
+    SoundId gateCollapse{kInvalidSoundId};
+  };
+
+} // namespace mecha
@@ -20,13 +20,18 @@ namespace mecha
 
     /**
      * @brief Play a 3D positional sound in the world
+     *
+     * The engine pans the sound around the listener and attenuates it with distance,
+     * linearly down to silence at maxDistance.
      * @param filePath Path to the sound file
      * @param position World position of the sound source
      * @param looped Whether the sound should loop
-     * @param volume Base volume (0.0 to 1.0)
+     * @param volume Base volume (0.0 to 1.0), before distance attenuation
+     * @param maxDistance Distance from the listener at which the sound becomes silent
      * @return Opaque handle to the sound (can be used to stop/control it later)
      */
-    virtual void* Play3D(const char* filePath, const glm::vec3& position, bool looped = false, float volume = 1.0f) = 0;
+    virtual void* Play3D(const char* filePath, const glm::vec3& position, bool looped = false, float volume = 1.0f,
+                         float maxDistance = 50.0f) = 0;
 
     /**
      * @brief Play a 2D sound (not positional, for UI/music)
@@ -37,6 +42,25 @@ namespace mecha
      */
     virtual void* Play2D(const char* filePath, bool looped = false, float volume = 1.0f) = 0;
 
+    /**
+     * @brief Open a long 2D sound (music) for streaming playback without starting it
+     *
+     * The file is decoded a little at a time off the calling thread into a short buffer,
+     * which starts filling right away: opening a stream ahead of time pre-rolls it, so
+     * PlayStream can start it later without decoding anything on the caller's thread.
+     * @param filePath Path to the sound file
+     * @param looped Whether the stream should loop
+     * @return Opaque handle usable like a Play2D handle once started (nullptr on failure)
+     */
+    virtual void* OpenStream(const char* filePath, bool looped = false) = 0;
+
+    /**
+     * @brief Start a stream returned by OpenStream
+     * @param streamHandle Handle returned from OpenStream
+     * @param volume Volume (0.0 to 1.0)
+     */
+    virtual void PlayStream(void* streamHandle, float volume = 1.0f) = 0;
+
     /**
      * @brief Update the listener position (player/camera)
      * @param position Listener position in world space
@@ -46,8 +70,8 @@ namespace mecha
     virtual void SetListenerPosition(const glm::vec3& position, const glm::vec3& forward, const glm::vec3& up) = 0;
 
     /**
-     * @brief Stop a playing sound
-     * @param soundHandle Handle returned from Play3D or Play2D
+     * @brief Stop a playing sound (or close a stream that was never started)
+     * @param soundHandle Handle returned from Play3D, Play2D or OpenStream
      */
     virtual void StopSound(void* soundHandle) = 0;
 
@@ -65,6 +89,19 @@ namespace mecha
      */
     virtual void SetPosition(void* soundHandle, const glm::vec3& position) = 0;
 
+    /**
+     * @brief Update the velocity of a 3D sound (drives the doppler effect)
+     * @param soundHandle Handle returned from Play3D
+     * @param velocity World units per second
+     */
+    virtual void SetVelocity(void* soundHandle, const glm::vec3& velocity) = 0;
+
+    /**
+     * @brief Update the velocity of the listener (drives the doppler effect)
+     * @param velocity World units per second
+     */
+    virtual void SetListenerVelocity(const glm::vec3& velocity) = 0;
+
     /**
      * @brief Set the pitch/playback speed of a sound
      * @param soundHandle Handle returned from Play3D or Play2D
@@ -96,6 +133,15 @@ namespace mecha
      */
     virtual void PreloadSound(const char* filePath) = 0;
 
+    /**
+     * @brief Decode a short clip into PCM once so later plays neither read nor decode it
+     *
+     * Meant for sound effects; long files such as music should only be preloaded.
+     * @param filePath Path to the sound file
+     * @return true if the clip is decoded (now or by an earlier call)
+     */
+    virtual bool DecodeSound(const char* filePath) = 0;
+
     /**
      * @brief Set the master volume for all sounds
      * @param volume Master volume (0.0 to 1.0, where 1.0 is full volume)
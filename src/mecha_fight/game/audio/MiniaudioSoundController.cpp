@@ -14,20 +14,219 @@
 
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
 #include <fstream>
 
 namespace mecha
 {
 
+  // Everything a pooled play touches lives here, created once by InitializeVoices
+  struct MiniaudioSoundController::Voice
+  {
+    // Service thread only once it runs
+    ma_sound sound;
+    ma_audio_buffer_ref source; // Rebound to a clip's frames on every play
+    bool initialized{false};
+    bool playing{false}; // Started and not ended or stopped yet
+    bool looped{false};
+    ma_uint64 endedAt{0}; // Engine time when it ended; reported once the mixer clock moves past it
+    std::chrono::steady_clock::time_point endedWallTime; // Reported after kRetireTimeout even if the clock stalls
+
+    // Game thread only
+    bool inUse{false};
+    bool stopping{false};   // Stop queued; the slot is recycled once the service thread confirms
+    uint32_t generation{0}; // Bumped on release so stale handles miss
+  };
+
+  // Music decoded ahead of the mixer: the streaming thread writes the ring buffer, the
+  // audio thread reads it through the data source callbacks below. Neither blocks the other.
+  struct MiniaudioSoundController::MusicStream
+  {
+    ma_data_source_base base; // Must stay first: miniaudio hands callbacks a pointer to it
+    ma_pcm_rb ring;
+    ma_decoder decoder;     // Touched only by the streaming thread
+    bool decoderReady{false};
+    bool ringReady{false};
+    bool looped{false};
+    ma_uint32 channels{0};
+    ma_uint32 sampleRate{0};
+    std::string filePath;
+    std::shared_ptr<std::vector<unsigned char>> encoded; // Compressed file, kept alive for the decoder
+    std::atomic<bool> finished{false}; // Decoder hit the end (or failed); set after the last write
+    std::atomic<bool> closed{false};   // Owner released it; the streaming thread stops filling
+
+    ~MusicStream()
+    {
+      if (decoderReady)
+      {
+        ma_decoder_uninit(&decoder);
+      }
+      if (ringReady)
+      {
+        ma_pcm_rb_uninit(&ring);
+        ma_data_source_uninit(&base);
+      }
+    }
+
+    // Decode until the ring buffer is full; runs on the streaming thread
+    void Fill()
+    {
+      if (!decoderReady)
+      {
+        ma_decoder_config config = ma_decoder_config_init(ma_format_f32, channels, sampleRate);
+        if (ma_decoder_init_memory(encoded->data(), encoded->size(), &config, &decoder) != MA_SUCCESS)
+        {
+          std::cerr << "[Sound] Failed to open stream: " << filePath << std::endl;
+          finished.store(true, std::memory_order_release);
+          return;
+        }
+        decoderReady = true;
+      }
+
+      bool rewound = false;
+      while (!finished.load(std::memory_order_relaxed) && !closed.load(std::memory_order_relaxed))
+      {
+        ma_uint32 frameCount = ma_pcm_rb_available_write(&ring);
+        if (frameCount == 0)
+        {
+          return;
+        }
+
+        void* buffer = nullptr;
+        if (ma_pcm_rb_acquire_write(&ring, &frameCount, &buffer) != MA_SUCCESS || frameCount == 0)
+        {
+          return;
+        }
+
+        ma_uint64 framesRead = 0;
+        ma_result result = ma_decoder_read_pcm_frames(&decoder, buffer, frameCount, &framesRead);
+        ma_pcm_rb_commit_write(&ring, static_cast<ma_uint32>(framesRead));
+
+        if (framesRead < frameCount || result != MA_SUCCESS)
+        {
+          // A read right after rewinding that yields nothing means there is nothing to loop
+          const bool empty = rewound && framesRead == 0;
+          if (looped && !empty && ma_decoder_seek_to_pcm_frame(&decoder, 0) == MA_SUCCESS)
+          {
+            rewound = true;
+            continue;
+          }
+          finished.store(true, std::memory_order_release);
+        }
+        rewound = false;
+      }
+    }
+
+    static const ma_data_source_vtable kVTable;
+
+    static ma_result OnRead(ma_data_source* dataSource, void* framesOut, ma_uint64 frameCount, ma_uint64* framesRead)
+    {
+      MusicStream* stream = static_cast<MusicStream*>(dataSource);
+      // Read the flag first: once set, everything the decoder produced is already in the ring
+      const bool finished = stream->finished.load(std::memory_order_acquire);
+
+      float* out = static_cast<float*>(framesOut);
+      ma_uint64 total = 0;
+      while (total < frameCount)
+      {
+        ma_uint32 chunk = static_cast<ma_uint32>(std::min<ma_uint64>(frameCount - total, UINT32_MAX));
+        void* buffer = nullptr;
+        if (ma_pcm_rb_acquire_read(&stream->ring, &chunk, &buffer) != MA_SUCCESS || chunk == 0)
+        {
+          break;
+        }
+        std::memcpy(out + total * stream->channels, buffer, chunk * stream->channels * sizeof(float));
+        ma_pcm_rb_commit_read(&stream->ring, chunk);
+        total += chunk;
+      }
+
+      if (total < frameCount && finished)
+      {
+        *framesRead = total;
+        return total == 0 ? MA_AT_END : MA_SUCCESS;
+      }
+
+      // Underrun: the decoder fell behind, play silence rather than ending the sound
+      std::memset(out + total * stream->channels, 0, (frameCount - total) * stream->channels * sizeof(float));
+      *framesRead = frameCount;
+      return MA_SUCCESS;
+    }
+
+    static ma_result OnSeek(ma_data_source*, ma_uint64)
+    {
+      return MA_NOT_IMPLEMENTED;
+    }
+
+    static ma_result OnGetDataFormat(ma_data_source* dataSource, ma_format* format, ma_uint32* channels,
+                                     ma_uint32* sampleRate, ma_channel* channelMap, size_t channelMapCap)
+    {
+      const MusicStream* stream = static_cast<const MusicStream*>(dataSource);
+      *format = ma_format_f32;
+      *channels = stream->channels;
+      *sampleRate = stream->sampleRate;
+      ma_channel_map_init_standard(ma_standard_channel_map_default, channelMap, channelMapCap, stream->channels);
+      return MA_SUCCESS;
+    }
+
+    static ma_result OnGetCursor(ma_data_source*, ma_uint64* cursor)
+    {
+      *cursor = 0;
+      return MA_NOT_IMPLEMENTED;
+    }
+
+    static ma_result OnGetLength(ma_data_source*, ma_uint64* length)
+    {
+      *length = 0;
+      return MA_NOT_IMPLEMENTED;
+    }
+  };
+
+  namespace
+  {
+    constexpr uintptr_t kVoiceIndexBits = 16;
+    constexpr ma_uint32 kStreamBufferMilliseconds = 500;
+    constexpr float kMinDistance = 1.0f; // Radius around a 3D sound heard at full volume
+    constexpr auto kStreamPollInterval = std::chrono::milliseconds(20);
+    constexpr auto kServicePollInterval = std::chrono::milliseconds(2); // Command latency, well under a mixer period
+    constexpr size_t kCommandQueueSize = 4096;
+    // Far longer than any mixer read; a clock that did not move in that long belongs to a stalled device
+    constexpr auto kRetireTimeout = std::chrono::milliseconds(250);
+  }
+
+  const ma_data_source_vtable MiniaudioSoundController::MusicStream::kVTable = {
+      MusicStream::OnRead, MusicStream::OnSeek, MusicStream::OnGetDataFormat,
+      MusicStream::OnGetCursor, MusicStream::OnGetLength, nullptr, 0};
+
   MiniaudioSoundController::MiniaudioSoundController()
+    : MiniaudioSoundController(Config{})
+  {
+  }
+
+  MiniaudioSoundController::MiniaudioSoundController(const Config& config)
     : engine_(nullptr)
-    , nextHandleId_(reinterpret_cast<void*>(1))
   {
+    ma_engine_config engineConfig = ma_engine_config_init();
+    if (config.nullBackend)
+    {
+      context_ = new ma_context;
+      ma_backend backends[] = {ma_backend_null};
+      if (ma_context_init(backends, 1, nullptr, context_) != MA_SUCCESS)
+      {
+        std::cerr << "[Sound] Failed to initialize the null audio backend" << std::endl;
+        delete context_;
+        context_ = nullptr;
+        return;
+      }
+      engineConfig.pContext = context_;
+    }
+
     // Allocate engine
     engine_ = new ma_engine;
 
     // Initialize engine
-    ma_result result = ma_engine_init(nullptr, engine_);
+    ma_result result = ma_engine_init(&engineConfig, engine_);
     if (result != MA_SUCCESS)
     {
       std::cerr << "[Sound] Failed to initialize miniaudio engine: " << result << std::endl;
@@ -36,7 +235,10 @@ namespace mecha
       return;
     }
 
-    std::cout << "[Sound] miniaudio sound engine initialized successfully" << std::endl;
+    InitializeVoices(config.voiceCount);
+    StartServiceThread();
+
+    std::cout << "[Sound] miniaudio sound engine initialized successfully (" << voiceCount_ << " voices)" << std::endl;
   }
 
   MiniaudioSoundController::~MiniaudioSoundController()
@@ -44,10 +246,43 @@ namespace mecha
     Shutdown();
   }
 
+  void MiniaudioSoundController::InitializeVoices(unsigned int voiceCount)
+  {
+    voiceCount = std::min<unsigned int>(voiceCount, (1u << (kVoiceIndexBits - 1)) - 1);
+    voices_ = std::make_unique<Voice[]>(voiceCount);
+    freeVoices_.reserve(voiceCount);
+    serviceVoices_.reserve(voiceCount);
+    retiringVoices_.reserve(voiceCount);
+
+    const ma_uint32 channels = ma_engine_get_channels(engine_);
+    for (unsigned int i = 0; i < voiceCount; ++i)
+    {
+      Voice& voice = voices_[i];
+      // An empty buffer in the engine's format: plays swap in clip frames without a resampler or channel converter
+      if (ma_audio_buffer_ref_init(ma_format_f32, channels, nullptr, 0, &voice.source) != MA_SUCCESS)
+      {
+        break;
+      }
+      if (ma_sound_init_from_data_source(engine_, &voice.source, 0, nullptr, &voice.sound) != MA_SUCCESS)
+      {
+        ma_audio_buffer_ref_uninit(&voice.source);
+        break;
+      }
+      voice.initialized = true;
+      voiceCount_ = i + 1;
+    }
+
+    // Popped from the back, so voice 0 is handed out first
+    for (unsigned int i = voiceCount_; i > 0; --i)
+    {
+      freeVoices_.push_back(i - 1);
+    }
+  }
+
   void* MiniaudioSoundController::CreateHandle()
   {
-    void* handle = nextHandleId_;
-    nextHandleId_ = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(nextHandleId_) + 1);
+    void* handle = reinterpret_cast<void*>((nextHandleId_ << 1) | 1u);
+    ++nextHandleId_;
     return handle;
   }
 
@@ -66,6 +301,25 @@ namespace mecha
     return nullptr;
   }
 
+  MiniaudioSoundController::Voice* MiniaudioSoundController::GetVoice(void* handle) const
+  {
+    if (!IsVoiceHandle(handle))
+    {
+      return nullptr;
+    }
+
+    const uintptr_t value = reinterpret_cast<uintptr_t>(handle) >> 1;
+    const uintptr_t index = (value & ((uintptr_t(1) << (kVoiceIndexBits - 1)) - 1)) - 1;
+    const uint32_t generation = static_cast<uint32_t>(value >> (kVoiceIndexBits - 1));
+    if (index >= voiceCount_)
+    {
+      return nullptr;
+    }
+
+    Voice& voice = voices_[index];
+    return (voice.inUse && !voice.stopping && voice.generation == generation) ? &voice : nullptr;
+  }
+
   std::shared_ptr<std::vector<unsigned char>> MiniaudioSoundController::GetOrLoadAudioData(const char* filePath)
   {
     if (!filePath)
@@ -106,21 +360,99 @@ namespace mecha
     return buffer;
   }
 
-  void* MiniaudioSoundController::Play3D(const char* filePath, const glm::vec3& position, bool looped, float volume)
+  bool MiniaudioSoundController::DecodeSound(const char* filePath)
   {
-    if (!engine_)
+    if (!engine_ || !filePath)
+    {
+      return false;
+    }
+    if (clipLookup_.count(std::string_view(filePath)) != 0)
+    {
+      return true;
+    }
+
+    auto encoded = GetOrLoadAudioData(filePath);
+    if (!encoded)
+    {
+      return false;
+    }
+
+    // Decode straight to the format the voices were created with
+    ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_f32, ma_engine_get_channels(engine_),
+                                                             ma_engine_get_sample_rate(engine_));
+    ma_uint64 frameCount = 0;
+    void* frames = nullptr;
+    ma_result result = ma_decode_memory(encoded->data(), encoded->size(), &decoderConfig, &frameCount, &frames);
+    // The encoded bytes are only needed for plays that decode on the fly
+    cachedAudio_.erase(filePath);
+    if (result != MA_SUCCESS)
+    {
+      std::cerr << "[Sound] Failed to decode " << filePath << " (error: " << result << ")" << std::endl;
+      return false;
+    }
+
+    auto clip = std::make_unique<DecodedClip>();
+    clip->filePath = filePath;
+    clip->frames = static_cast<float*>(frames);
+    clip->frameCount = frameCount;
+    clipLookup_[clip->filePath] = clip.get();
+    clips_.push_back(std::move(clip));
+    return true;
+  }
+
+  void* MiniaudioSoundController::PlayVoice(const DecodedClip& clip, const glm::vec3* position, bool looped, float volume,
+                                            float maxDistance)
+  {
+    if (freeVoices_.empty())
     {
+      if (!loggedPoolExhausted_)
+      {
+        std::cerr << "[Sound] All " << voiceCount_ << " voices busy, dropping plays" << std::endl;
+        loggedPoolExhausted_ = true;
+      }
       return nullptr;
     }
 
+    const uint32_t index = freeVoices_.back();
+    freeVoices_.pop_back();
+    Voice& voice = voices_[index];
+    voice.inUse = true;
+    voice.stopping = false;
+
+    // The handle is valid at once; the service thread starts the voice on its next pass
+    Command command;
+    command.type = CommandType::Play;
+    command.voice = index;
+    command.clip = &clip;
+    command.positional = position != nullptr;
+    command.looped = looped;
+    command.vectors[0] = position ? *position : glm::vec3(0.0f);
+    command.values[0] = volume;
+    command.values[1] = maxDistance;
+    Submit(command);
+
+    const uintptr_t value = (uintptr_t(voice.generation) << (kVoiceIndexBits - 1)) | (index + 1);
+    return reinterpret_cast<void*>(value << 1);
+  }
+
+  void MiniaudioSoundController::ReleaseVoice(uint32_t index)
+  {
+    Voice& voice = voices_[index];
+    voice.inUse = false;
+    voice.stopping = false;
+    voice.generation++;
+    freeVoices_.push_back(index);
+  }
+
+  void* MiniaudioSoundController::PlayFromFile(const char* filePath, const glm::vec3* position, bool looped, float volume,
+                                               float maxDistance)
+  {
     // Create sound handle
     auto soundHandle = std::make_unique<SoundHandle>();
     soundHandle->sound = new ma_sound;
-    soundHandle->is3D = true;
+    soundHandle->is3D = position != nullptr;
     soundHandle->isLooped = looped;
 
-    // Load and configure 3D sound
-    // For 3D sounds, we need spatialization enabled
     ma_result result = MA_ERROR;
     auto cached = GetOrLoadAudioData(filePath);
     if (cached)
@@ -154,15 +486,13 @@ namespace mecha
 
     if (result != MA_SUCCESS)
     {
-      std::cerr << "[Sound] Failed to load 3D sound: " << filePath << " (error: " << result << ")" << std::endl;
+      std::cerr << "[Sound] Failed to load " << (position ? "3D" : "2D") << " sound: " << filePath << " (error: " << result
+                << ")" << std::endl;
       delete soundHandle->sound;
       return nullptr;
     }
 
-    // Configure sound - disable spatialization since we handle all volume/positioning manually
-    ma_sound_set_position(soundHandle->sound, position.x, position.y, position.z);
-    ma_sound_set_spatialization_enabled(soundHandle->sound, MA_FALSE); // Disabled - we manage volume manually
-    ma_sound_set_volume(soundHandle->sound, volume);
+    ConfigureSpatialization(soundHandle->sound, position, volume, maxDistance);
 
     if (looped)
     {
@@ -179,75 +509,377 @@ namespace mecha
     return handle;
   }
 
+  void MiniaudioSoundController::ConfigureSpatialization(ma_sound* sound, const glm::vec3* position, float volume,
+                                                         float maxDistance)
+  {
+    if (!position)
+    {
+      ma_sound_set_spatialization_enabled(sound, MA_FALSE);
+      ma_sound_set_volume(sound, volume);
+      return;
+    }
+
+    // Full volume within the min distance, then a straight fade to silence at maxDistance. A volume
+    // above 1 widens the full-volume radius to where volume * (1 - d / maxDistance) drops to 1
+    // instead of amplifying, so loud, far-reaching sounds saturate rather than clip.
+    float minDistance = kMinDistance;
+    if (volume > 1.0f)
+    {
+      minDistance = std::max(minDistance, maxDistance * (1.0f - 1.0f / volume));
+      volume = 1.0f;
+    }
+    if (minDistance >= maxDistance)
+    {
+      minDistance = maxDistance * 0.5f; // miniaudio skips attenuation entirely otherwise
+    }
+
+    ma_sound_set_spatialization_enabled(sound, MA_TRUE);
+    ma_sound_set_position(sound, position->x, position->y, position->z);
+    ma_sound_set_velocity(sound, 0.0f, 0.0f, 0.0f);
+    ma_sound_set_attenuation_model(sound, ma_attenuation_model_linear);
+    ma_sound_set_min_distance(sound, minDistance);
+    ma_sound_set_max_distance(sound, maxDistance);
+    ma_sound_set_rolloff(sound, 1.0f);
+    ma_sound_set_volume(sound, volume);
+  }
+
+  void* MiniaudioSoundController::Play3D(const char* filePath, const glm::vec3& position, bool looped, float volume,
+                                         float maxDistance)
+  {
+    if (!engine_ || !filePath)
+    {
+      return nullptr;
+    }
+
+    auto clip = clipLookup_.find(std::string_view(filePath));
+    if (clip != clipLookup_.end())
+    {
+      return PlayVoice(*clip->second, &position, looped, volume, maxDistance);
+    }
+    return PlayFromFile(filePath, &position, looped, volume, maxDistance);
+  }
+
   void* MiniaudioSoundController::Play2D(const char* filePath, bool looped, float volume)
   {
-    if (!engine_)
+    if (!engine_ || !filePath)
     {
       return nullptr;
     }
 
-    // Create sound handle
+    auto clip = clipLookup_.find(std::string_view(filePath));
+    if (clip != clipLookup_.end())
+    {
+      return PlayVoice(*clip->second, nullptr, looped, volume, 0.0f);
+    }
+    return PlayFromFile(filePath, nullptr, looped, volume, 0.0f);
+  }
+
+  void* MiniaudioSoundController::OpenStream(const char* filePath, bool looped)
+  {
+    if (!engine_ || !filePath)
+    {
+      return nullptr;
+    }
+
+    // Only the compressed bytes are read here (usually already preloaded); decoding is left to streamThread_
+    auto encoded = GetOrLoadAudioData(filePath);
+    if (!encoded)
+    {
+      std::cerr << "[Sound] Failed to load stream: " << filePath << std::endl;
+      return nullptr;
+    }
+
+    auto stream = std::make_shared<MusicStream>();
+    stream->channels = ma_engine_get_channels(engine_);
+    stream->sampleRate = ma_engine_get_sample_rate(engine_);
+    stream->looped = looped;
+    stream->filePath = filePath;
+    stream->encoded = std::move(encoded);
+
+    ma_data_source_config dataSourceConfig = ma_data_source_config_init();
+    dataSourceConfig.vtable = &MusicStream::kVTable;
+    if (ma_data_source_init(&dataSourceConfig, &stream->base) != MA_SUCCESS)
+    {
+      return nullptr;
+    }
+    const ma_uint32 bufferFrames = stream->sampleRate * kStreamBufferMilliseconds / 1000;
+    if (ma_pcm_rb_init(ma_format_f32, stream->channels, bufferFrames, nullptr, nullptr, &stream->ring) != MA_SUCCESS)
+    {
+      ma_data_source_uninit(&stream->base);
+      return nullptr;
+    }
+    stream->ringReady = true;
+
     auto soundHandle = std::make_unique<SoundHandle>();
     soundHandle->sound = new ma_sound;
-    soundHandle->is3D = false;
-    soundHandle->isLooped = looped;
+    soundHandle->stream = stream;
+    soundHandle->isLooped = looped; // The decoder rewinds itself, so the sound never reaches its end
+    soundHandle->started = false;
 
-    // Load 2D sound (no spatialization)
-    ma_result result = MA_ERROR;
-    auto cached = GetOrLoadAudioData(filePath);
-    if (cached)
+    // The stream already has the engine's format, and music is not positional
+    ma_result result = ma_sound_init_from_data_source(engine_, &stream->base, MA_SOUND_FLAG_NO_SPATIALIZATION,
+                                                      nullptr, soundHandle->sound);
+    if (result != MA_SUCCESS)
     {
-      // Create decoder from memory
-      soundHandle->decoder = new ma_decoder;
-      ma_decoder_config decoderConfig = ma_decoder_config_init_default();
-      result = ma_decoder_init_memory(cached->data(), cached->size(), &decoderConfig, soundHandle->decoder);
-      if (result == MA_SUCCESS)
+      std::cerr << "[Sound] Failed to create stream: " << filePath << " (error: " << result << ")" << std::endl;
+      delete soundHandle->sound;
+      return nullptr;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(streamMutex_);
+      if (!streamThread_.joinable())
       {
-        // Create sound from decoder
-        ma_sound_config soundConfig = ma_sound_config_init_2(engine_);
-        soundConfig.pDataSource = soundHandle->decoder;
-        soundConfig.flags = MA_SOUND_FLAG_DECODE;
-        result = ma_sound_init_ex(engine_, &soundConfig, soundHandle->sound);
+        streamThreadExit_ = false;
+        streamThread_ = std::thread(&MiniaudioSoundController::StreamThreadMain, this);
       }
-      else
+      streams_.push_back(stream);
+      streamAdded_ = true;
+    }
+    streamWake_.notify_one();
+
+    void* handle = CreateHandle();
+    activeSounds_[handle] = std::move(soundHandle);
+    return handle;
+  }
+
+  void MiniaudioSoundController::PlayStream(void* streamHandle, float volume)
+  {
+    SoundHandle* handle = GetSoundHandle(streamHandle);
+    if (!handle || !handle->stream || handle->started)
+    {
+      return;
+    }
+
+    ma_sound_set_volume(handle->sound, std::max(0.0f, std::min(1.0f, volume)));
+    ma_sound_start(handle->sound);
+    handle->started = true;
+  }
+
+  void MiniaudioSoundController::StreamThreadMain()
+  {
+    std::vector<std::shared_ptr<MusicStream>> pending;
+    std::unique_lock<std::mutex> lock(streamMutex_);
+    while (!streamThreadExit_)
+    {
+      // Decode outside the lock; the snapshot keeps streams alive while they are filled
+      pending = streams_;
+      streamAdded_ = false;
+      lock.unlock();
+      for (const auto& stream : pending)
       {
-        delete soundHandle->decoder;
-        soundHandle->decoder = nullptr;
+        stream->Fill();
       }
+      pending.clear();
+      lock.lock();
+
+      streamWake_.wait_for(lock, kStreamPollInterval, [this] { return streamThreadExit_ || streamAdded_; });
     }
-    else
+  }
+
+  void MiniaudioSoundController::StopStreamThread()
+  {
     {
-      result = ma_sound_init_from_file(engine_, filePath,
-                                        MA_SOUND_FLAG_DECODE,
-                                        nullptr,  // pGroup (null = default group)
-                                        nullptr,  // pDoneFence (null = synchronous)
-                                        soundHandle->sound);
+      std::lock_guard<std::mutex> lock(streamMutex_);
+      streamThreadExit_ = true;
+    }
+    streamWake_.notify_one();
+    if (streamThread_.joinable())
+    {
+      streamThread_.join();
     }
+  }
 
-    if (result != MA_SUCCESS)
+  void MiniaudioSoundController::StartServiceThread()
+  {
+    commands_ = std::make_unique<SpscQueue<Command>>(kCommandQueueSize);
+    // Every voice has at most one end pending, so events can never overflow
+    voiceEvents_ = std::make_unique<SpscQueue<VoiceEvent>>(voiceCount_ + 1);
+    serviceExit_.store(false, std::memory_order_relaxed);
+    serviceThread_ = std::thread(&MiniaudioSoundController::ServiceThreadMain, this);
+  }
+
+  void MiniaudioSoundController::StopServiceThread()
+  {
+    serviceExit_.store(true, std::memory_order_relaxed);
+    if (serviceThread_.joinable())
     {
-      std::cerr << "[Sound] Failed to load 2D sound: " << filePath << " (error: " << result << ")" << std::endl;
-      delete soundHandle->sound;
-      return nullptr;
+      serviceThread_.join();
     }
+  }
+
+  void MiniaudioSoundController::ServiceThreadMain()
+  {
+    Command command;
+    while (!serviceExit_.load(std::memory_order_relaxed))
+    {
+      while (commands_->Pop(command))
+      {
+        ApplyCommand(command);
+      }
 
-    // Configure 2D sound
-    ma_sound_set_spatialization_enabled(soundHandle->sound, MA_FALSE);
-    ma_sound_set_volume(soundHandle->sound, volume);
+      // One-shots that reached their end were stopped by the mixer itself
+      for (size_t i = 0; i < serviceVoices_.size();)
+      {
+        const Voice& voice = voices_[serviceVoices_[i]];
+        if (!voice.looped && !ma_sound_is_playing(&voice.sound))
+        {
+          FinishVoice(i);
+        }
+        else
+        {
+          ++i;
+        }
+      }
+      RetireVoices();
 
-    if (looped)
+      // Polled rather than signalled, so submitting never costs the game thread a wake-up call
+      std::this_thread::sleep_for(kServicePollInterval);
+    }
+  }
+
+  void MiniaudioSoundController::ApplyCommand(const Command& command)
+  {
+    switch (command.type)
     {
-      ma_sound_set_looping(soundHandle->sound, MA_TRUE);
+    case CommandType::SetListener:
+      ma_engine_listener_set_position(engine_, 0, command.vectors[0].x, command.vectors[0].y, command.vectors[0].z);
+      ma_engine_listener_set_direction(engine_, 0, command.vectors[1].x, command.vectors[1].y, command.vectors[1].z);
+      ma_engine_listener_set_world_up(engine_, 0, command.vectors[2].x, command.vectors[2].y, command.vectors[2].z);
+      return;
+    case CommandType::SetListenerVelocity:
+      ma_engine_listener_set_velocity(engine_, 0, command.vectors[0].x, command.vectors[0].y, command.vectors[0].z);
+      return;
+    default:
+      break;
     }
 
-    // Start playing
-    ma_sound_start(soundHandle->sound);
+    Voice& voice = voices_[command.voice];
+    if (command.type == CommandType::Play)
+    {
+      ma_audio_buffer_ref_set_data(&voice.source, command.clip->frames, command.clip->frameCount);
+      ConfigureSpatialization(&voice.sound, command.positional ? &command.vectors[0] : nullptr, command.values[0],
+                              command.values[1]);
+      ma_sound_set_pitch(&voice.sound, 1.0f);
+      ma_sound_set_looping(&voice.sound, command.looped ? MA_TRUE : MA_FALSE);
+      ma_sound_start(&voice.sound);
+      voice.playing = true;
+      voice.looped = command.looped;
+      serviceVoices_.push_back(command.voice);
+      return;
+    }
 
-    // Store handle
-    void* handle = CreateHandle();
-    activeSounds_[handle] = std::move(soundHandle);
+    // A voice that already ended has its event out; the game thread recycles it from that alone
+    if (!voice.playing)
+    {
+      return;
+    }
 
-    return handle;
+    const glm::vec3& vector = command.vectors[0];
+    switch (command.type)
+    {
+    case CommandType::Stop:
+      ma_sound_stop(&voice.sound);
+      FinishVoice(std::find(serviceVoices_.begin(), serviceVoices_.end(), command.voice) - serviceVoices_.begin());
+      break;
+    case CommandType::SetVolume:
+      ma_sound_set_volume(&voice.sound, command.values[0]);
+      break;
+    case CommandType::SetPosition:
+      ma_sound_set_position(&voice.sound, vector.x, vector.y, vector.z);
+      break;
+    case CommandType::SetVelocity:
+      ma_sound_set_velocity(&voice.sound, vector.x, vector.y, vector.z);
+      break;
+    case CommandType::SetPitch:
+      ma_sound_set_pitch(&voice.sound, command.values[0]);
+      break;
+    default:
+      break;
+    }
+  }
+
+  void MiniaudioSoundController::FinishVoice(size_t serviceIndex)
+  {
+    const uint32_t index = serviceVoices_[serviceIndex];
+    serviceVoices_[serviceIndex] = serviceVoices_.back();
+    serviceVoices_.pop_back();
+    voices_[index].playing = false;
+    voices_[index].endedAt = ma_engine_get_time_in_pcm_frames(engine_);
+    voices_[index].endedWallTime = std::chrono::steady_clock::now();
+    retiringVoices_.push_back(index);
+  }
+
+  void MiniaudioSoundController::RetireVoices()
+  {
+    // The mixer's clock advances after each read, so once it moved on no read of the voice is still
+    // running and the game thread may rebind it. A device that stopped, was lost or never pulls frames
+    // leaves the clock where it is; nothing reads the voice then either, so the timeout frees it
+    // instead of leaking the pool.
+    const ma_uint64 now = ma_engine_get_time_in_pcm_frames(engine_);
+    const auto wallNow = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < retiringVoices_.size();)
+    {
+      const uint32_t index = retiringVoices_[i];
+      if (now > voices_[index].endedAt || wallNow - voices_[index].endedWallTime >= kRetireTimeout)
+      {
+        voiceEvents_->Push(VoiceEvent{index});
+        retiringVoices_[i] = retiringVoices_.back();
+        retiringVoices_.pop_back();
+      }
+      else
+      {
+        ++i;
+      }
+    }
+  }
+
+  void MiniaudioSoundController::Submit(const Command& command)
+  {
+    while (!commands_->Push(command))
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  void MiniaudioSoundController::SubmitVoiceCommand(void* soundHandle, CommandType type, const glm::vec3& vector,
+                                                    float value)
+  {
+    if (Voice* voice = GetVoice(soundHandle))
+    {
+      Command command;
+      command.type = type;
+      command.voice = static_cast<uint32_t>(voice - voices_.get());
+      command.vectors[0] = vector;
+      command.values[0] = value;
+      Submit(command);
+    }
+  }
+
+  void MiniaudioSoundController::ReleaseSoundHandle(SoundHandle& handle)
+  {
+    if (handle.sound)
+    {
+      ma_sound_stop(handle.sound);
+      ma_sound_uninit(handle.sound);
+      delete handle.sound;
+      handle.sound = nullptr;
+    }
+    // Clean up decoder if it exists
+    if (handle.decoder)
+    {
+      ma_decoder_uninit(handle.decoder);
+      delete handle.decoder;
+      handle.decoder = nullptr;
+    }
+    if (handle.stream)
+    {
+      // The streaming thread may still hold it for the rest of its pass; the last owner frees it
+      handle.stream->closed.store(true, std::memory_order_relaxed);
+      std::lock_guard<std::mutex> lock(streamMutex_);
+      streams_.erase(std::remove(streams_.begin(), streams_.end(), handle.stream), streams_.end());
+      handle.stream.reset();
+    }
   }
 
   void MiniaudioSoundController::SetListenerPosition(const glm::vec3& position, const glm::vec3& forward, const glm::vec3& up)
@@ -258,65 +890,114 @@ namespace mecha
     }
 
     // Set listener position and orientation
-    ma_engine_listener_set_position(engine_, 0, position.x, position.y, position.z);
-    ma_engine_listener_set_direction(engine_, 0, forward.x, forward.y, forward.z);
-    ma_engine_listener_set_world_up(engine_, 0, up.x, up.y, up.z);
+    Command command;
+    command.type = CommandType::SetListener;
+    command.vectors[0] = position;
+    command.vectors[1] = forward;
+    command.vectors[2] = up;
+    Submit(command);
   }
 
-  void MiniaudioSoundController::StopSound(void* soundHandle)
+  ma_sound* MiniaudioSoundController::GetSound(void* soundHandle) const
   {
     SoundHandle* handle = GetSoundHandle(soundHandle);
-    if (handle && handle->sound)
+    return handle ? handle->sound : nullptr;
+  }
+
+  void MiniaudioSoundController::StopSound(void* soundHandle)
+  {
+    if (IsVoiceHandle(soundHandle))
     {
-      ma_sound_stop(handle->sound);
-      ma_sound_uninit(handle->sound);
-      delete handle->sound;
-      // Clean up decoder if it exists
-      if (handle->decoder)
+      if (Voice* voice = GetVoice(soundHandle))
       {
-        ma_decoder_uninit(handle->decoder);
-        delete handle->decoder;
+        // The handle dies now; the slot is reused once the service thread reports the stop
+        SubmitVoiceCommand(soundHandle, CommandType::Stop, glm::vec3(0.0f), 0.0f);
+        voice->stopping = true;
       }
+      return;
+    }
+
+    SoundHandle* handle = GetSoundHandle(soundHandle);
+    if (handle && handle->sound)
+    {
+      ReleaseSoundHandle(*handle);
       activeSounds_.erase(soundHandle);
     }
   }
 
   void MiniaudioSoundController::SetVolume(void* soundHandle, float volume)
   {
-    SoundHandle* handle = GetSoundHandle(soundHandle);
-    if (handle && handle->sound)
+    volume = std::max(0.0f, std::min(1.0f, volume));
+    if (IsVoiceHandle(soundHandle))
+    {
+      SubmitVoiceCommand(soundHandle, CommandType::SetVolume, glm::vec3(0.0f), volume);
+    }
+    else if (ma_sound* sound = GetSound(soundHandle))
     {
-      volume = std::max(0.0f, std::min(1.0f, volume));
-      ma_sound_set_volume(handle->sound, volume);
+      ma_sound_set_volume(sound, volume);
     }
   }
 
   void MiniaudioSoundController::SetPosition(void* soundHandle, const glm::vec3& position)
   {
+    if (IsVoiceHandle(soundHandle))
+    {
+      SubmitVoiceCommand(soundHandle, CommandType::SetPosition, position, 0.0f);
+      return;
+    }
     SoundHandle* handle = GetSoundHandle(soundHandle);
-    if (handle && handle->sound && handle->is3D)
+    if (handle && handle->is3D && handle->sound)
     {
       ma_sound_set_position(handle->sound, position.x, position.y, position.z);
     }
   }
 
-  void MiniaudioSoundController::SetPitch(void* soundHandle, float pitch)
+  void MiniaudioSoundController::SetVelocity(void* soundHandle, const glm::vec3& velocity)
   {
+    if (IsVoiceHandle(soundHandle))
+    {
+      SubmitVoiceCommand(soundHandle, CommandType::SetVelocity, velocity, 0.0f);
+      return;
+    }
     SoundHandle* handle = GetSoundHandle(soundHandle);
-    if (handle && handle->sound)
+    if (handle && handle->is3D && handle->sound)
+    {
+      ma_sound_set_velocity(handle->sound, velocity.x, velocity.y, velocity.z);
+    }
+  }
+
+  void MiniaudioSoundController::SetListenerVelocity(const glm::vec3& velocity)
+  {
+    if (engine_)
+    {
+      Command command;
+      command.type = CommandType::SetListenerVelocity;
+      command.vectors[0] = velocity;
+      Submit(command);
+    }
+  }
+
+  void MiniaudioSoundController::SetPitch(void* soundHandle, float pitch)
+  {
+    if (IsVoiceHandle(soundHandle))
+    {
+      SubmitVoiceCommand(soundHandle, CommandType::SetPitch, glm::vec3(0.0f), pitch);
+    }
+    else if (ma_sound* sound = GetSound(soundHandle))
     {
-      ma_sound_set_pitch(handle->sound, pitch);
+      ma_sound_set_pitch(sound, pitch);
     }
   }
 
   bool MiniaudioSoundController::IsPlaying(void* soundHandle) const
   {
-    SoundHandle* handle = GetSoundHandle(soundHandle);
-    if (handle && handle->sound)
+    if (IsVoiceHandle(soundHandle))
     {
-      return ma_sound_is_playing(handle->sound) != 0;
+      // Counts as playing from the call that started it until its end is reported
+      return GetVoice(soundHandle) != nullptr;
     }
-    return false;
+    const ma_sound* sound = GetSound(soundHandle);
+    return sound && ma_sound_is_playing(sound) != 0;
   }
 
   void MiniaudioSoundController::Update(float deltaTime)
@@ -332,6 +1013,13 @@ namespace mecha
 
   void MiniaudioSoundController::CleanupFinishedSounds()
   {
+    // Voices the service thread stopped or saw end
+    VoiceEvent event;
+    while (voiceEvents_->Pop(event))
+    {
+      ReleaseVoice(event.voice);
+    }
+
     // Remove sounds that are no longer playing (except looped sounds)
     auto it = activeSounds_.begin();
     while (it != activeSounds_.end())
@@ -339,17 +1027,10 @@ namespace mecha
       SoundHandle* handle = it->second.get();
       if (handle && handle->sound)
       {
-        // Keep looped sounds, remove finished non-looped sounds
-        if (!handle->isLooped && !ma_sound_is_playing(handle->sound))
+        // Keep looped sounds and streams not started yet, remove finished non-looped sounds
+        if (!handle->isLooped && handle->started && !ma_sound_is_playing(handle->sound))
         {
-          ma_sound_uninit(handle->sound);
-          delete handle->sound;
-          // Clean up decoder if it exists
-          if (handle->decoder)
-          {
-            ma_decoder_uninit(handle->decoder);
-            delete handle->decoder;
-          }
+          ReleaseSoundHandle(*handle);
           it = activeSounds_.erase(it);
         }
         else
@@ -366,24 +1047,40 @@ namespace mecha
 
   void MiniaudioSoundController::Shutdown()
   {
+    StopServiceThread();
+    StopStreamThread();
+
     // Stop and cleanup all sounds
     for (auto& pair : activeSounds_)
     {
-      SoundHandle* handle = pair.second.get();
-      if (handle && handle->sound)
+      if (pair.second)
       {
-        ma_sound_stop(handle->sound);
-        ma_sound_uninit(handle->sound);
-        delete handle->sound;
+        ReleaseSoundHandle(*pair.second);
       }
-      // Clean up decoder if it exists
-      if (handle && handle->decoder)
+    }
+    activeSounds_.clear();
+
+    for (unsigned int i = 0; i < voiceCount_; ++i)
+    {
+      if (voices_[i].initialized)
       {
-        ma_decoder_uninit(handle->decoder);
-        delete handle->decoder;
+        ma_sound_uninit(&voices_[i].sound);
+        ma_audio_buffer_ref_uninit(&voices_[i].source);
       }
     }
-    activeSounds_.clear();
+    voices_.reset();
+    voiceCount_ = 0;
+    freeVoices_.clear();
+    serviceVoices_.clear();
+    retiringVoices_.clear();
+
+    // Voices are gone, so nothing reads the decoded frames anymore
+    clipLookup_.clear();
+    for (const auto& clip : clips_)
+    {
+      ma_free(clip->frames, nullptr);
+    }
+    clips_.clear();
 
     if (engine_)
     {
@@ -392,6 +1089,13 @@ namespace mecha
       engine_ = nullptr;
       std::cout << "[Sound] miniaudio sound engine shut down" << std::endl;
     }
+
+    if (context_)
+    {
+      ma_context_uninit(context_);
+      delete context_;
+      context_ = nullptr;
+    }
   }
 
   void MiniaudioSoundController::SetMasterVolume(float volume)
@@ -415,7 +1119,7 @@ namespace mecha
 
   void MiniaudioSoundController::PreloadSound(const char* filePath)
   {
-    if (!engine_ || !filePath)
+    if (!engine_ || !filePath || clipLookup_.count(std::string_view(filePath)) != 0)
     {
       return;
     }
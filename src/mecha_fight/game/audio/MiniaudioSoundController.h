@@ -1,14 +1,22 @@
 #pragma once
 
 #include "ISoundController.h"
+#include "SpscQueue.h"
 #include <glm/glm.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 // Forward declarations for miniaudio
 struct ma_engine;
+struct ma_context;
 struct ma_sound;
 struct ma_decoder;
 
@@ -17,58 +25,193 @@ namespace mecha
 
   /**
    * @brief Concrete implementation of ISoundController using miniaudio
-   * 
+   *
    * Cross-platform sound controller that works on Windows, macOS (including arm64),
-   * Linux, and other platforms. Provides 3D positional audio support.
+   * Linux, and other platforms. Provides 3D positional audio support: 3D sounds use
+   * miniaudio's spatializer, so panning, distance attenuation and doppler are all
+   * computed on the mixing thread.
+   *
+   * Clips passed to DecodeSound are decoded once into PCM in the engine's format and
+   * played through a fixed pool of voices created up front, so a play only rebinds a
+   * voice to the shared buffer: no decoding, file access or allocation. Files that were
+   * never decoded still get a sound and decoder of their own per play.
+   *
+   * Pool voices belong to an audio service thread. The game thread only reserves a voice,
+   * returns its handle and pushes a small command (play, stop, volume, position...) into a
+   * lock-free queue; the service thread applies commands in order and reports every voice
+   * that stopped or ended through a second queue, drained by Update to recycle the voice.
+   *
+   * Music goes through OpenStream: a streaming thread decodes each open stream into a
+   * half-second ring buffer the mixer reads from, so no track is decoded in one go.
    */
   class MiniaudioSoundController : public ISoundController
   {
   public:
+    struct Config
+    {
+      unsigned int voiceCount{64}; // Concurrent decoded-clip plays
+      bool nullBackend{false};     // Mix without an audio device (headless runs, tests)
+    };
+
     MiniaudioSoundController();
+    explicit MiniaudioSoundController(const Config& config);
     virtual ~MiniaudioSoundController();
 
     // ISoundController interface
-    void* Play3D(const char* filePath, const glm::vec3& position, bool looped = false, float volume = 1.0f) override;
+    void* Play3D(const char* filePath, const glm::vec3& position, bool looped = false, float volume = 1.0f,
+                 float maxDistance = 50.0f) override;
     void* Play2D(const char* filePath, bool looped = false, float volume = 1.0f) override;
+    void* OpenStream(const char* filePath, bool looped = false) override;
+    void PlayStream(void* streamHandle, float volume = 1.0f) override;
     void SetListenerPosition(const glm::vec3& position, const glm::vec3& forward, const glm::vec3& up) override;
     void StopSound(void* soundHandle) override;
     void SetVolume(void* soundHandle, float volume) override;
     void SetPosition(void* soundHandle, const glm::vec3& position) override;
+    void SetVelocity(void* soundHandle, const glm::vec3& velocity) override;
+    void SetListenerVelocity(const glm::vec3& velocity) override;
     void SetPitch(void* soundHandle, float pitch) override;
     bool IsPlaying(void* soundHandle) const override;
     void Update(float deltaTime) override;
     void Shutdown() override;
     void PreloadSound(const char* filePath) override;
+    bool DecodeSound(const char* filePath) override;
     void SetMasterVolume(float volume) override;
     float GetMasterVolume() const override;
 
+    /**
+     * @brief Voices of the pool reserved by a play and not yet reported ended
+     */
+    unsigned int GetActiveVoiceCount() const { return voiceCount_ - static_cast<unsigned int>(freeVoices_.size()); }
+
   private:
+    friend struct MiniaudioSoundControllerTestAccess; // tests/audio_command_queue_test.cpp
+
     ma_engine* engine_;
-    
-    // Track active sounds
+    ma_context* context_{nullptr}; // Only owned when the null backend is forced
+
+    // Clip decoded to the engine's format (f32, engine channels and sample rate), shared by voices
+    struct DecodedClip
+    {
+      std::string filePath;
+      float* frames{nullptr};
+      uint64_t frameCount{0};
+    };
+
+    // Pool voice; defined in the .cpp since it embeds miniaudio types
+    struct Voice;
+
+    enum class CommandType : uint8_t
+    {
+      Play,
+      Stop,
+      SetVolume,
+      SetPosition,
+      SetVelocity,
+      SetPitch,
+      SetListener,
+      SetListenerVelocity
+    };
+
+    // Game thread to service thread; plain data so the queue can copy it
+    struct Command
+    {
+      CommandType type{CommandType::Play};
+      bool positional{false}; // Play: 3D (vectors[0] is the position) or 2D
+      bool looped{false};
+      uint32_t voice{0};
+      const DecodedClip* clip{nullptr};
+      glm::vec3 vectors[3]{};  // Position/velocity, or listener position, forward and up
+      float values[2]{};       // Volume and max distance, or the pitch
+    };
+
+    // Service thread to game thread: the voice stopped or ended, its slot may be reused
+    struct VoiceEvent
+    {
+      uint32_t voice{0};
+    };
+
+    std::vector<std::unique_ptr<DecodedClip>> clips_;
+    std::unordered_map<std::string_view, const DecodedClip*> clipLookup_; // Keys view into clips_
+    std::unique_ptr<Voice[]> voices_;
+    unsigned int voiceCount_{0};
+    std::vector<uint32_t> freeVoices_;     // Stack of idle voice indices
+    bool loggedPoolExhausted_{false};
+
+    std::unique_ptr<SpscQueue<Command>> commands_;
+    std::unique_ptr<SpscQueue<VoiceEvent>> voiceEvents_;
+    std::vector<uint32_t> serviceVoices_;  // Voices started and not yet ended; service thread only
+    std::vector<uint32_t> retiringVoices_; // Ended, but the mixer may still be in a read of them; service thread only
+    std::thread serviceThread_;
+    std::atomic<bool> serviceExit_{false};
+
+    void StartServiceThread();
+    void StopServiceThread();
+    void ServiceThreadMain();
+    void ApplyCommand(const Command& command);
+    void FinishVoice(size_t serviceIndex);
+    void RetireVoices(); // Report ended voices the mixer is done with
+
+    // Never drops a command: waits for the service thread if the queue is full
+    void Submit(const Command& command);
+    void SubmitVoiceCommand(void* soundHandle, CommandType type, const glm::vec3& vector, float value);
+
+    // Stream decoded by streamThread_; defined in the .cpp since it embeds miniaudio types
+    struct MusicStream;
+
+    // Track active sounds of files that were not decoded
     struct SoundHandle
     {
       ma_sound* sound{nullptr};
       ma_decoder* decoder{nullptr}; // Owned decoder for memory-based sounds
+      std::shared_ptr<MusicStream> stream; // Data source of streamed sounds, shared with streamThread_
       bool is3D{false};
       bool isLooped{false};
+      bool started{true}; // Opened streams wait for PlayStream
     };
-    
+
     std::unordered_map<void*, std::unique_ptr<SoundHandle>> activeSounds_;
-    void* nextHandleId_{nullptr};
+    uintptr_t nextHandleId_{1};
     std::unordered_map<std::string, std::shared_ptr<std::vector<unsigned char>>> cachedAudio_;
-    
+
+    // Open streams, topped up by streamThread_ (started with the first stream)
+    std::vector<std::shared_ptr<MusicStream>> streams_;
+    std::mutex streamMutex_;
+    std::condition_variable streamWake_;
+    std::thread streamThread_;
+    bool streamThreadExit_{false};
+    bool streamAdded_{false}; // Wakes the thread early so a new stream pre-rolls at once
+
+    void StreamThreadMain();
+    void StopStreamThread();
+
+    void InitializeVoices(unsigned int voiceCount);
+
+    // Voice handles are even (index and generation), file-backed sound handles odd
+    static bool IsVoiceHandle(void* handle) { return handle && (reinterpret_cast<uintptr_t>(handle) & 1u) == 0; }
+    Voice* GetVoice(void* handle) const;
+    ma_sound* GetSound(void* handle) const; // File-backed sound behind a handle (voices are the service thread's)
+    void* PlayVoice(const DecodedClip& clip, const glm::vec3* position, bool looped, float volume, float maxDistance);
+    void ReleaseVoice(uint32_t index);
+
+    // Per-play sound and decoder for files without a decoded clip
+    void* PlayFromFile(const char* filePath, const glm::vec3* position, bool looped, float volume, float maxDistance);
+
+    // Spatialize 3D sounds (position given) with linear rolloff to maxDistance; 2D sounds stay unspatialized
+    static void ConfigureSpatialization(ma_sound* sound, const glm::vec3* position, float volume, float maxDistance);
+
     // Helper to get SoundHandle from void*
     SoundHandle* GetSoundHandle(void* handle) const;
-    
+
     // Helper to create new handle ID
     void* CreateHandle();
-    
+
     // Clean up finished sounds
     void CleanupFinishedSounds();
 
+    // Uninit and free what a file-backed sound owns, detaching its stream from the streaming thread
+    void ReleaseSoundHandle(SoundHandle& handle);
+
     std::shared_ptr<std::vector<unsigned char>> GetOrLoadAudioData(const char* filePath);
   };
 
 } // namespace mecha
-
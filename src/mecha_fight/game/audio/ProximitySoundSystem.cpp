@@ -14,41 +14,140 @@ namespace mecha
     }
   }
 
+  namespace
+  {
+    // Our handles live above anything the controller hands out, so untracked (2D) handles
+    // passed to UnregisterSound/SetSoundPitch can still be forwarded to the controller
+    constexpr uintptr_t kHandleTag = uintptr_t(1) << (sizeof(uintptr_t) * 8 - 1);
+    constexpr unsigned kSlotBits = 20;
+    constexpr uintptr_t kSlotMask = (uintptr_t(1) << kSlotBits) - 1;
+    constexpr uintptr_t kGenerationMask = (kHandleTag - 1) >> kSlotBits;
+
+    // Audibility only decides which sounds hold voices; the mixer attenuates continuously
+    constexpr float kVoiceUpdateInterval = 0.1f;
+    // Caps velocities derived from position deltas, so teleports and respawns do not warp the pitch
+    constexpr float kMaxDopplerSpeed = 60.0f;
+
+    glm::vec3 VelocityFromMove(const glm::vec3& from, const glm::vec3& to, float deltaTime)
+    {
+      glm::vec3 velocity = (to - from) / deltaTime;
+      const float speed = glm::length(velocity);
+      return speed > kMaxDopplerSpeed ? velocity * (kMaxDopplerSpeed / speed) : velocity;
+    }
+
+    void* MakeHandle(uint32_t slot, uint32_t generation)
+    {
+      return reinterpret_cast<void*>(kHandleTag | ((generation & kGenerationMask) << kSlotBits) | slot);
+    }
+  }
+
   void* ProximitySoundSystem::RegisterSound(const char* filePath, const glm::vec3& position, bool looped, 
-                                            float baseVolume, float maxDistance)
+                                            float baseVolume, float maxDistance, const PlayParams& params)
   {
     if (!soundController_)
     {
       return nullptr;
     }
 
-    // Play the sound through the sound controller
-    void* handle = soundController_->Play3D(filePath, position, looped, baseVolume);
-    
-    if (handle)
+    SoundInfo info;
+    info.position = position;
+    info.maxDistance = maxDistance;
+    info.baseVolume = baseVolume;
+    info.filePath = filePath;
+    info.group = params.group;
+    info.priority = params.priority;
+    info.maxInstances = params.maxInstances;
+    info.sequence = nextSequence_++;
+    info.lastMoveTime = elapsedTime_;
+    info.isLooped = looped;
+    if (info.group >= static_cast<int>(groupVoices_.size()))
     {
-      // Track it in our system
-      SoundInfo info;
-      info.soundHandle = handle;
-      info.position = position;
-      info.maxDistance = maxDistance;
-      info.baseVolume = baseVolume;
-      info.filePath = filePath;
-      info.isLooped = looped;
-      
-      activeSounds_.push_back(info);
+      groupVoices_.resize(info.group + 1, 0);
     }
+    info.audibility = EvaluateAudibility(info);
 
-    return handle;
+    const bool audible = info.audibility > audibleThreshold_;
+    if (audible && ReserveVoice(info, true))
+    {
+      StartVoice(info);
+    }
+
+    // A one-shot that cannot be heard now never will be; only loops are kept virtual
+    if (!info.voiceHandle && !looped)
+    {
+      return nullptr;
+    }
+
+    if (freeSlots_.empty())
+    {
+      if (slotIndices_.size() > kSlotMask)
+      {
+        Virtualize(info);
+        return nullptr;
+      }
+      freeSlots_.push_back(static_cast<uint32_t>(slotIndices_.size()));
+      slotIndices_.push_back(0);
+      slotGenerations_.push_back(0);
+    }
+    info.slot = freeSlots_.back();
+    freeSlots_.pop_back();
+    slotIndices_[info.slot] = static_cast<uint32_t>(activeSounds_.size());
+    info.soundHandle = MakeHandle(info.slot, slotGenerations_[info.slot]);
+    activeSounds_.push_back(info);
+    return info.soundHandle;
+  }
+
+  void ProximitySoundSystem::SetVoiceLimit(int maxVoices, float audibleThreshold)
+  {
+    maxVoices_ = std::max(1, maxVoices);
+    audibleThreshold_ = std::max(0.0f, audibleThreshold);
+  }
+
+  void ProximitySoundSystem::SetSoundPitch(void* soundHandle, float pitch)
+  {
+    if (!soundController_)
+    {
+      return;
+    }
+
+    SoundInfo* info = FindSoundInfo(soundHandle);
+    if (!info)
+    {
+      soundController_->SetPitch(soundHandle, pitch);
+      return;
+    }
+
+    info->pitch = pitch;
+    if (info->voiceHandle)
+    {
+      soundController_->SetPitch(info->voiceHandle, pitch);
+    }
   }
 
   void ProximitySoundSystem::UpdateSoundPosition(void* soundHandle, const glm::vec3& newPosition)
   {
     SoundInfo* info = FindSoundInfo(soundHandle);
-    if (info && soundController_)
+    if (!info || !soundController_)
+    {
+      return;
+    }
+
+    const float deltaTime = elapsedTime_ - info->lastMoveTime;
+    if (deltaTime > 0.0f && newPosition != info->position)
+    {
+      const glm::vec3 velocity = VelocityFromMove(info->position, newPosition, deltaTime);
+      info->lastMoveTime = elapsedTime_;
+      if (info->voiceHandle)
+      {
+        soundController_->SetVelocity(info->voiceHandle, velocity);
+        info->moving = true;
+      }
+    }
+
+    info->position = newPosition;
+    if (info->voiceHandle)
     {
-      info->position = newPosition;
-      soundController_->SetPosition(soundHandle, newPosition);
+      soundController_->SetPosition(info->voiceHandle, newPosition);
     }
   }
 
@@ -59,21 +158,25 @@ namespace mecha
       return;
     }
 
-    // Stop the sound
-    soundController_->StopSound(soundHandle);
+    SoundInfo* info = FindSoundInfo(soundHandle);
+    if (!info)
+    {
+      // Not one of ours (e.g. a 2D sound): let the controller stop it
+      soundController_->StopSound(soundHandle);
+      return;
+    }
 
-    // Remove from tracking
-    activeSounds_.erase(
-      std::remove_if(activeSounds_.begin(), activeSounds_.end(),
-        [soundHandle](const SoundInfo& info) {
-          return info.soundHandle == soundHandle;
-        }),
-      activeSounds_.end()
-    );
+    RemoveSound(static_cast<size_t>(info - activeSounds_.data()));
   }
 
   void ProximitySoundSystem::SetListenerPosition(const glm::vec3& position, const glm::vec3& forward, const glm::vec3& up)
   {
+    // Called once per frame with the camera pose; the position delta gives the listener's doppler velocity
+    const float deltaTime = elapsedTime_ - listenerTime_;
+    const bool hasVelocity = listenerTime_ >= 0.0f && deltaTime > 0.0f;
+    const glm::vec3 velocity = hasVelocity ? VelocityFromMove(listenerPosition_, position, deltaTime) : glm::vec3(0.0f);
+    listenerTime_ = elapsedTime_;
+
     listenerPosition_ = position;
     listenerForward_ = glm::normalize(forward);
     listenerUp_ = glm::normalize(up);
@@ -82,6 +185,10 @@ namespace mecha
     if (soundController_)
     {
       soundController_->SetListenerPosition(position, forward, up);
+      if (deltaTime > 0.0f)
+      {
+        soundController_->SetListenerVelocity(velocity);
+      }
     }
   }
 
@@ -89,7 +196,7 @@ namespace mecha
   {
     if (maxDistance <= 0.0f)
     {
-      return baseVolume; // No attenuation if maxDistance is invalid
+      return std::min(baseVolume, 1.0f); // No attenuation if maxDistance is invalid
     }
 
     if (distance >= maxDistance)
@@ -97,24 +204,42 @@ namespace mecha
       return 0.0f; // Beyond max distance, volume is 0
     }
 
-    // Use a quadratic (ease-out) falloff so sounds retain volume longer near the listener
-    float normalized = std::clamp(distance / maxDistance, 0.0f, 1.0f);
-    float attenuation = 1.0f - normalized * normalized;
-    return baseVolume * std::max(0.0f, attenuation);
+    // Linear falloff; volumes above 1 saturate near the source, as the controller plays them
+    float attenuation = 1.0f - distance / maxDistance;
+    return std::clamp(baseVolume * attenuation, 0.0f, 1.0f);
   }
 
   ProximitySoundSystem::SoundInfo* ProximitySoundSystem::FindSoundInfo(void* soundHandle)
   {
-    auto it = std::find_if(activeSounds_.begin(), activeSounds_.end(),
-      [soundHandle](const SoundInfo& info) {
-        return info.soundHandle == soundHandle;
-      });
+    const uintptr_t value = reinterpret_cast<uintptr_t>(soundHandle);
+    if ((value & kHandleTag) == 0)
+    {
+      return nullptr;
+    }
+
+    const uintptr_t slot = value & kSlotMask;
+    if (slot >= slotIndices_.size() || soundHandle != MakeHandle(static_cast<uint32_t>(slot), slotGenerations_[slot]))
+    {
+      return nullptr;
+    }
+    return &activeSounds_[slotIndices_[slot]];
+  }
+
+  void ProximitySoundSystem::RemoveSound(size_t index)
+  {
+    Virtualize(activeSounds_[index]);
+
+    // Stale handles of this slot stop matching
+    const uint32_t slot = activeSounds_[index].slot;
+    slotGenerations_[slot]++;
+    freeSlots_.push_back(slot);
 
-    if (it != activeSounds_.end())
+    if (index + 1 != activeSounds_.size())
     {
-      return &(*it);
+      activeSounds_[index] = activeSounds_.back();
+      slotIndices_[activeSounds_[index].slot] = static_cast<uint32_t>(index);
     }
-    return nullptr;
+    activeSounds_.pop_back();
   }
 
   void ProximitySoundSystem::CleanupFinishedSounds()
@@ -124,19 +249,144 @@ namespace mecha
       return;
     }
 
-    // Remove sounds that are no longer playing
-    activeSounds_.erase(
-      std::remove_if(activeSounds_.begin(), activeSounds_.end(),
-        [this](const SoundInfo& info) {
-          // Keep looped sounds, remove finished non-looped sounds
-          if (info.isLooped)
-          {
-            return false; // Keep looped sounds
-          }
-          return !soundController_->IsPlaying(info.soundHandle);
-        }),
-      activeSounds_.end()
-    );
+    // Remove one-shots that finished or lost their voice; loops stay tracked, real or virtual
+    for (size_t i = 0; i < activeSounds_.size();)
+    {
+      const SoundInfo& info = activeSounds_[i];
+      if (!info.isLooped && (!info.voiceHandle || !soundController_->IsPlaying(info.voiceHandle)))
+      {
+        RemoveSound(i); // Brings an unvisited sound to i
+      }
+      else
+      {
+        ++i;
+      }
+    }
+  }
+
+  float ProximitySoundSystem::EvaluateAudibility(const SoundInfo& info) const
+  {
+    float distance = glm::length(info.position - listenerPosition_);
+    return CalculateVolume(distance, info.maxDistance, info.baseVolume);
+  }
+
+  int ProximitySoundSystem::FindVictim(int priority, float audibility, int group, bool replaceEqual) const
+  {
+    int victim = -1;
+    for (size_t i = 0; i < activeSounds_.size(); ++i)
+    {
+      const SoundInfo& info = activeSounds_[i];
+      if (!info.voiceHandle || (group >= 0 && info.group != group))
+      {
+        continue;
+      }
+
+      if (victim < 0)
+      {
+        victim = static_cast<int>(i);
+        continue;
+      }
+
+      // Lowest priority, then quietest, then oldest
+      const SoundInfo& best = activeSounds_[victim];
+      if (info.priority != best.priority)
+      {
+        if (info.priority < best.priority)
+        {
+          victim = static_cast<int>(i);
+        }
+      }
+      else if (info.audibility != best.audibility)
+      {
+        if (info.audibility < best.audibility)
+        {
+          victim = static_cast<int>(i);
+        }
+      }
+      else if (info.sequence < best.sequence)
+      {
+        victim = static_cast<int>(i);
+      }
+    }
+
+    if (victim < 0)
+    {
+      return -1;
+    }
+
+    // Only outrank: a lower priority, or an equal one that is quieter (or as loud, for new plays)
+    const SoundInfo& candidate = activeSounds_[victim];
+    const bool quieter = replaceEqual ? candidate.audibility <= audibility : candidate.audibility < audibility;
+    if (candidate.priority < priority || (candidate.priority == priority && quieter))
+    {
+      return victim;
+    }
+    return -1;
+  }
+
+  bool ProximitySoundSystem::ReserveVoice(const SoundInfo& candidate, bool replaceEqual)
+  {
+    if (candidate.group >= 0 && candidate.maxInstances > 0)
+    {
+      if (groupVoices_[candidate.group] >= candidate.maxInstances)
+      {
+        // Take the place of one of our own instances; the total does not grow
+        int victim = FindVictim(candidate.priority, candidate.audibility, candidate.group, replaceEqual);
+        if (victim < 0)
+        {
+          return false;
+        }
+        Virtualize(activeSounds_[victim]);
+        return true;
+      }
+    }
+
+    if (realVoices_ >= maxVoices_)
+    {
+      int victim = FindVictim(candidate.priority, candidate.audibility, -1, replaceEqual);
+      if (victim < 0)
+      {
+        return false;
+      }
+      Virtualize(activeSounds_[victim]);
+    }
+    return true;
+  }
+
+  bool ProximitySoundSystem::StartVoice(SoundInfo& info)
+  {
+    info.voiceHandle = soundController_->Play3D(info.filePath, info.position, info.isLooped, info.baseVolume,
+                                                info.maxDistance);
+    info.moving = false;
+    if (!info.voiceHandle)
+    {
+      return false;
+    }
+
+    if (info.pitch != 1.0f)
+    {
+      soundController_->SetPitch(info.voiceHandle, info.pitch);
+    }
+    ++realVoices_;
+    if (info.group >= 0)
+    {
+      ++groupVoices_[info.group];
+    }
+    return true;
+  }
+
+  void ProximitySoundSystem::Virtualize(SoundInfo& info)
+  {
+    if (info.voiceHandle)
+    {
+      soundController_->StopSound(info.voiceHandle);
+      info.voiceHandle = nullptr;
+      --realVoices_;
+      if (info.group >= 0)
+      {
+        --groupVoices_[info.group];
+      }
+    }
   }
 
   void ProximitySoundSystem::Update(const UpdateContext& ctx)
@@ -146,22 +396,67 @@ namespace mecha
       return;
     }
 
+    elapsedTime_ += ctx.deltaTime;
+    voiceUpdateTimer_ += ctx.deltaTime;
+    if (voiceUpdateTimer_ < kVoiceUpdateInterval)
+    {
+      return;
+    }
+    voiceUpdateTimer_ = 0.0f;
+    UpdateVoices();
+  }
+
+  void ProximitySoundSystem::UpdateVoices()
+  {
     // Clean up finished sounds first
     CleanupFinishedSounds();
 
-    // Update volume for each active sound based on distance
-    for (auto& soundInfo : activeSounds_)
+    // Drop the voices of sounds that faded out; remember loops that became audible again
+    pendingVoices_.clear();
+    for (size_t i = 0; i < activeSounds_.size(); ++i)
     {
-      // Calculate distance from listener to sound source
-      float distance = glm::length(soundInfo.position - listenerPosition_);
+      SoundInfo& soundInfo = activeSounds_[i];
+      soundInfo.audibility = EvaluateAudibility(soundInfo);
 
-      // Calculate volume using linear attenuation
-      float volume = CalculateVolume(distance, soundInfo.maxDistance, soundInfo.baseVolume);
+      const bool audible = soundInfo.audibility > audibleThreshold_;
+      if (soundInfo.voiceHandle && !audible)
+      {
+        Virtualize(soundInfo);
+      }
+      else if (!soundInfo.voiceHandle && audible && soundInfo.isLooped)
+      {
+        pendingVoices_.push_back(i);
+      }
 
-      // Update the sound volume
-      soundController_->SetVolume(soundInfo.soundHandle, volume);
+      // Sounds whose owner stopped moving them would otherwise keep their last doppler shift
+      if (soundInfo.voiceHandle && soundInfo.moving && elapsedTime_ - soundInfo.lastMoveTime >= kVoiceUpdateInterval)
+      {
+        soundController_->SetVelocity(soundInfo.voiceHandle, glm::vec3(0.0f));
+        soundInfo.moving = false;
+      }
+    }
+
+    // Most important first, so a later, weaker loop cannot steal from an earlier, stronger one
+    std::sort(pendingVoices_.begin(), pendingVoices_.end(),
+      [this](size_t a, size_t b) {
+        const SoundInfo& lhs = activeSounds_[a];
+        const SoundInfo& rhs = activeSounds_[b];
+        if (lhs.priority != rhs.priority)
+        {
+          return lhs.priority > rhs.priority;
+        }
+        return lhs.audibility > rhs.audibility;
+      });
+
+    // Returning loops must strictly outrank a victim, or two equal loops would swap on every update
+    for (size_t index : pendingVoices_)
+    {
+      SoundInfo& soundInfo = activeSounds_[index];
+      if (ReserveVoice(soundInfo, false))
+      {
+        StartVoice(soundInfo);
+      }
     }
   }
 
 } // namespace mecha
-
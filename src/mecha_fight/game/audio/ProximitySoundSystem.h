@@ -4,7 +4,7 @@
 #include "ISoundController.h"
 #include <glm/glm.hpp>
 #include <vector>
-#include <string>
+#include <cstdint>
 
 namespace mecha
 {
@@ -12,9 +12,16 @@ namespace mecha
   /**
    * @brief Manages 3D positional sounds with proximity-based volume attenuation
    * 
-   * Tracks active 3D sounds and applies linear distance attenuation based on
-   * the distance from the listener (player/camera). Follows the Entity pattern
-   * for integration with the game's update loop.
+   * Tracks active 3D sounds and forwards their positions, velocities and the listener
+   * pose (player/camera) to the sound controller, whose mixer does the attenuation,
+   * panning and doppler. Follows the Entity pattern for integration with the game's
+   * update loop.
+   *
+   * Also acts as the voice mixer: only a limited number of sounds hold a real voice
+   * in the sound controller. A sound the attenuation makes inaudible, or that loses
+   * its voice to a more important one, becomes virtual: loops keep their handle and
+   * position and get a voice back once audible, one-shots are dropped. Victims are
+   * picked lowest priority first, then quietest, then oldest.
    */
   class ProximitySoundSystem : public Entity
   {
@@ -24,14 +31,34 @@ namespace mecha
      */
     struct SoundInfo
     {
-      void* soundHandle{nullptr};        // Handle from ISoundController
+      void* soundHandle{nullptr};        // Handle given to callers, stays valid while virtual
+      void* voiceHandle{nullptr};        // Handle from ISoundController, null while virtual
       glm::vec3 position{0.0f};          // Current world position
       float maxDistance{50.0f};          // Distance at which volume reaches 0
       float baseVolume{1.0f};            // Base volume (0.0 to 1.0)
-      std::string filePath;              // Sound file path (for debugging)
+      float pitch{1.0f};                 // Reapplied when a virtual sound gets a voice
+      float audibility{0.0f};            // Attenuated volume from the last evaluation
+      float lastMoveTime{0.0f};          // When the position last changed, for its velocity
+      bool moving{false};                // A non-zero velocity was sent to the voice
+      const char* filePath{nullptr};     // Sound file path (must outlive the sound)
+      int group{-1};                     // Instances sharing a maxInstances budget (-1 = none)
+      int priority{0};
+      int maxInstances{0};
+      uint64_t sequence{0};              // Play order, for oldest-first stealing
+      uint32_t slot{0};                  // Entry of the handle table pointing back here
       bool isLooped{false};              // Whether sound is looping
     };
 
+    /**
+     * @brief Mixing parameters of a single play
+     */
+    struct PlayParams
+    {
+      int group{-1};              // Small non-negative id (e.g. the SoundId) for maxInstances, -1 = none
+      int priority{0};            // Higher wins when voices run out
+      int maxInstances{0};        // Concurrent real voices of this group (0 = unlimited)
+    };
+
     ProximitySoundSystem(ISoundController* soundController);
     virtual ~ProximitySoundSystem() = default;
 
@@ -42,10 +69,28 @@ namespace mecha
      * @param looped Whether sound should loop
      * @param baseVolume Base volume (0.0 to 1.0)
      * @param maxDistance Distance at which volume reaches 0
-     * @return Handle to the sound (can be used to update position or stop)
+     * @param params Priority and instance limit used by the mixer
+     * @return Handle to the sound (can be used to update position or stop); null when a
+     *         one-shot was inaudible or lost the voice contest and was not played at all
      */
+    void* RegisterSound(const char* filePath, const glm::vec3& position, bool looped, 
+                        float baseVolume, float maxDistance, const PlayParams& params);
+
     void* RegisterSound(const char* filePath, const glm::vec3& position, bool looped = false, 
-                        float baseVolume = 1.0f, float maxDistance = 50.0f);
+                        float baseVolume = 1.0f, float maxDistance = 50.0f)
+    {
+      return RegisterSound(filePath, position, looped, baseVolume, maxDistance, PlayParams());
+    }
+
+    /**
+     * @brief Cap real voices; sounds at or below audibleThreshold are never given one
+     */
+    void SetVoiceLimit(int maxVoices, float audibleThreshold);
+
+    /**
+     * @brief Set the pitch of a tracked sound (kept across virtualisation)
+     */
+    void SetSoundPitch(void* soundHandle, float pitch);
 
     /**
      * @brief Update the position of a tracked sound
@@ -69,23 +114,41 @@ namespace mecha
     void SetListenerPosition(const glm::vec3& position, const glm::vec3& forward, const glm::vec3& up);
 
     /**
-     * @brief Update the system - calculates distances and updates volumes
+     * @brief Update the system - a few times per second, hands voices to the most audible sounds
      */
     void Update(const UpdateContext& ctx) override;
 
+    int GetRealVoiceCount() const { return realVoices_; }
+    int GetVirtualVoiceCount() const { return static_cast<int>(activeSounds_.size()) - realVoices_; }
+
   private:
     ISoundController* soundController_;
-    std::vector<SoundInfo> activeSounds_;
+    std::vector<SoundInfo> activeSounds_; // Dense, unordered; removal swaps with the last entry
+
+    // Handles carry a slot and its generation; the slot maps to the sound's index in activeSounds_
+    std::vector<uint32_t> slotIndices_;
+    std::vector<uint32_t> slotGenerations_;
+    std::vector<uint32_t> freeSlots_;
+
+    std::vector<int> groupVoices_; // Real voices per group
+    int realVoices_{0};
     glm::vec3 listenerPosition_{0.0f};
     glm::vec3 listenerForward_{0.0f, 0.0f, -1.0f};
     glm::vec3 listenerUp_{0.0f, 1.0f, 0.0f};
+    float listenerTime_{-1.0f}; // When the listener position was last set (negative before the first)
+    float elapsedTime_{0.0f};
+    float voiceUpdateTimer_{0.0f};
+    int maxVoices_{32};
+    float audibleThreshold_{0.001f};
+    uint64_t nextSequence_{0};
+    std::vector<size_t> pendingVoices_; // Scratch list of virtual loops that became audible
 
     /**
-     * @brief Calculate volume based on linear distance attenuation
+     * @brief Estimate the volume the controller's linear attenuation produces (for voice management only)
      * @param distance Distance from listener to sound source
      * @param maxDistance Maximum distance (volume = 0 at this distance)
      * @param baseVolume Base volume multiplier
-     * @return Calculated volume (0.0 to baseVolume)
+     * @return Calculated volume (0.0 to 1.0)
      */
     static float CalculateVolume(float distance, float maxDistance, float baseVolume);
 
@@ -96,10 +159,38 @@ namespace mecha
      */
     SoundInfo* FindSoundInfo(void* soundHandle);
 
+    /**
+     * @brief Stop a tracked sound and drop it, moving the last sound into its place
+     */
+    void RemoveSound(size_t index);
+
     /**
      * @brief Remove finished sounds from tracking
      */
     void CleanupFinishedSounds();
+
+    float EvaluateAudibility(const SoundInfo& info) const;
+
+    /**
+     * @brief Make room for a sound within its group limit and the voice cap, stealing if it outranks a victim
+     * @param replaceEqual Whether an equally ranked voice may be replaced (new plays win ties)
+     * @return false if the sound must stay virtual
+     */
+    bool ReserveVoice(const SoundInfo& candidate, bool replaceEqual);
+
+    /**
+     * @brief Index of the real voice a sound with this rank may take, or -1
+     * @param group Only consider this group's voices (-1 = all)
+     */
+    int FindVictim(int priority, float audibility, int group, bool replaceEqual) const;
+
+    bool StartVoice(SoundInfo& info);
+    void Virtualize(SoundInfo& info);
+
+    /**
+     * @brief Prune finished sounds and move voices to the sounds that deserve them
+     */
+    void UpdateVoices();
   };
 
 } // namespace mecha
@@ -1,5 +1,7 @@
 #include "SoundManager.h"
+#include <algorithm>
 #include <iostream>
+#include <limits>
 
 namespace mecha
 {
@@ -17,112 +19,135 @@ namespace mecha
     proximitySystem_ = std::make_shared<ProximitySoundSystem>(soundController_);
   }
 
-  void SoundManager::RegisterSound(const std::string &name, const SoundConfig &config)
+  SoundId SoundManager::RegisterSound(const std::string &name, const SoundConfig &config)
   {
     if (config.filePath == nullptr)
     {
       std::cerr << "[SoundManager] Warning: Attempted to register sound '" << name
                 << "' with null file path" << std::endl;
-      return;
+      return kInvalidSoundId;
     }
 
-    registeredSounds_[name] = config;
+    SoundId id;
+    auto existing = soundIds_.find(name);
+    if (existing != soundIds_.end())
+    {
+      id = existing->second;
+      sounds_[id] = config;
+    }
+    else
+    {
+      if (sounds_.size() >= kInvalidSoundId)
+      {
+        std::cerr << "[SoundManager] Warning: Too many sounds, cannot register '" << name << "'" << std::endl;
+        return kInvalidSoundId;
+      }
+      id = static_cast<SoundId>(sounds_.size());
+      sounds_.push_back(config);
+      soundNames_.push_back(name);
+      lastPlayTime_.push_back(-std::numeric_limits<float>::infinity());
+      soundVolumes_.push_back(1.0f);
+      soundIds_.emplace(name, id);
+    }
+
+    // Effects are short and played often: decode once now so plays come straight from PCM
+    if (soundController_)
+    {
+      soundController_->DecodeSound(config.filePath);
+    }
+    return id;
   }
 
-  void *SoundManager::PlaySound3D(const std::string &name, const glm::vec3 &position,
-                                  float volumeOverride, float maxDistanceOverride)
+  SoundId SoundManager::FindSound(const std::string &name) const
   {
-    if (!soundController_ || !proximitySystem_)
+    auto it = soundIds_.find(name);
+    return it != soundIds_.end() ? it->second : kInvalidSoundId;
+  }
+
+  const SoundManager::SoundConfig *SoundManager::BeginPlay(SoundId id)
+  {
+    if (id >= sounds_.size())
     {
+      std::cerr << "[SoundManager] Warning: Sound id " << id << " not registered!" << std::endl;
       return nullptr;
     }
 
-    auto it = registeredSounds_.find(name);
-    if (it == registeredSounds_.end())
+    const SoundConfig &config = sounds_[id];
+    if (config.minInterval > 0.0f && (elapsedTime_ - lastPlayTime_[id]) < config.minInterval)
     {
-      std::cerr << "[SoundManager] Warning: Sound '" << name << "' not registered!" << std::endl;
       return nullptr;
     }
+    return &config;
+  }
 
-    const SoundConfig &config = it->second;
-    if (config.minInterval > 0.0f)
+  void SoundManager::SetMixerPolicy(const MixerPolicy &policy)
+  {
+    if (proximitySystem_)
     {
-      auto lastIt = lastPlayTime_.find(name);
-      if (lastIt != lastPlayTime_.end())
-      {
-        if ((elapsedTime_ - lastIt->second) < config.minInterval)
-        {
-          return nullptr;
-        }
-      }
+      proximitySystem_->SetVoiceLimit(policy.maxVoices, policy.audibleThreshold);
     }
+  }
 
-    float volume = (volumeOverride >= 0.0f) ? volumeOverride : config.defaultVolume;
+  void *SoundManager::PlaySound3D(SoundId id, const glm::vec3 &position,
+                                  float volumeOverride, float maxDistanceOverride)
+  {
+    if (!soundController_ || !proximitySystem_)
+    {
+      return nullptr;
+    }
 
-    // Apply per-sound volume multiplier if set
-    auto volumeIt = soundVolumes_.find(name);
-    if (volumeIt != soundVolumes_.end())
+    const SoundConfig *config = BeginPlay(id);
+    if (!config)
     {
-      volume *= volumeIt->second;
+      return nullptr;
     }
 
-    float maxDist = (maxDistanceOverride >= 0.0f) ? maxDistanceOverride : config.maxDistance;
+    // Apply per-sound volume multiplier
+    float volume = ((volumeOverride >= 0.0f) ? volumeOverride : config->defaultVolume) * soundVolumes_[id];
+    float maxDist = (maxDistanceOverride >= 0.0f) ? maxDistanceOverride : config->maxDistance;
+
+    // Instances are counted per sound id
+    ProximitySoundSystem::PlayParams params;
+    params.group = id;
+    params.priority = config->priority;
+    params.maxInstances = config->maxInstances;
 
     void *handle = proximitySystem_->RegisterSound(
-        config.filePath,
+        config->filePath,
         position,
-        config.isLooped,
+        config->isLooped,
         volume,
-        maxDist);
+        maxDist,
+        params);
 
-    if (handle && config.minInterval > 0.0f)
+    if (handle && config->minInterval > 0.0f)
     {
-      lastPlayTime_[name] = elapsedTime_;
+      lastPlayTime_[id] = elapsedTime_;
     }
 
     return handle;
   }
 
-  void *SoundManager::PlaySound2D(const std::string &name, float volumeOverride)
+  void *SoundManager::PlaySound2D(SoundId id, float volumeOverride)
   {
     if (!soundController_)
     {
       return nullptr;
     }
 
-    auto it = registeredSounds_.find(name);
-    if (it == registeredSounds_.end())
+    const SoundConfig *config = BeginPlay(id);
+    if (!config)
     {
-      std::cerr << "[SoundManager] Warning: Sound '" << name << "' not registered!" << std::endl;
       return nullptr;
     }
 
-    const SoundConfig &config = it->second;
-    if (config.minInterval > 0.0f)
-    {
-      auto lastIt = lastPlayTime_.find(name);
-      if (lastIt != lastPlayTime_.end())
-      {
-        if ((elapsedTime_ - lastIt->second) < config.minInterval)
-        {
-          return nullptr;
-        }
-      }
-    }
-
-    float volume = (volumeOverride >= 0.0f) ? volumeOverride : config.defaultVolume;
-
-    // Apply per-sound volume multiplier if set
-    auto volumeIt = soundVolumes_.find(name);
-    if (volumeIt != soundVolumes_.end())
-    {
-      volume *= volumeIt->second;
-    }
+    // Apply per-sound volume multiplier
+    float volume = ((volumeOverride >= 0.0f) ? volumeOverride : config->defaultVolume) * soundVolumes_[id];
 
-    void *handle = soundController_->Play2D(config.filePath, config.isLooped, volume);
-    if (handle && config.minInterval > 0.0f)
+    void *handle = soundController_->Play2D(config->filePath, config->isLooped, volume);
+    if (handle && config->minInterval > 0.0f)
     {
-      lastPlayTime_[name] = elapsedTime_;
+      lastPlayTime_[id] = elapsedTime_;
     }
     return handle;
   }
@@ -137,7 +162,11 @@ namespace mecha
 
   void SoundManager::SetSoundPitch(void *soundHandle, float pitch)
   {
-    if (soundController_)
+    if (proximitySystem_)
+    {
+      proximitySystem_->SetSoundPitch(soundHandle, pitch);
+    }
+    else if (soundController_)
     {
       soundController_->SetPitch(soundHandle, pitch);
     }
@@ -189,36 +218,27 @@ namespace mecha
     return 1.0f;
   }
 
-  void SoundManager::PreloadSound(const std::string &name)
+  void SoundManager::PreloadSound(SoundId id)
   {
-    if (!soundController_)
+    if (!soundController_ || id >= sounds_.size())
     {
       return;
     }
 
-    auto it = registeredSounds_.find(name);
-    if (it == registeredSounds_.end())
-    {
-      return;
-    }
-
-    soundController_->PreloadSound(it->second.filePath);
+    soundController_->PreloadSound(sounds_[id].filePath);
   }
 
-  void SoundManager::SetSoundVolume(const std::string &name, float volume)
+  void SoundManager::SetSoundVolume(SoundId id, float volume)
   {
-    volume = std::max(0.0f, std::min(1.0f, volume));
-    soundVolumes_[name] = volume;
+    if (id < soundVolumes_.size())
+    {
+      soundVolumes_[id] = std::max(0.0f, std::min(1.0f, volume));
+    }
   }
 
-  float SoundManager::GetSoundVolume(const std::string &name) const
+  float SoundManager::GetSoundVolume(SoundId id) const
   {
-    auto it = soundVolumes_.find(name);
-    if (it != soundVolumes_.end())
-    {
-      return it->second;
-    }
-    return 1.0f; // Default to full volume if not set
+    return id < soundVolumes_.size() ? soundVolumes_[id] : 1.0f; // Default to full volume if not set
   }
 
 } // namespace mecha
@@ -4,20 +4,30 @@
 #include "ProximitySoundSystem.h"
 #include "SoundRegistry.h"
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace mecha
 {
 
+  /**
+   * @brief Compact handle of a registered sound, an index into SoundManager's tables
+   */
+  using SoundId = uint16_t;
+  constexpr SoundId kInvalidSoundId = 0xFFFF;
+
   /**
    * @brief High-level sound manager that provides easy sound playback interface
    *
    * Wraps ISoundController and ProximitySoundSystem to provide a simple API
-   * for playing sounds by name. Handles sound registration, 3D positioning,
+   * for playing registered sounds. Handles sound registration, 3D positioning,
    * and proximity-based volume attenuation automatically.
    *
+   * Registration hands out a SoundId; configs, play timing and volume multipliers
+   * live in flat arrays indexed by it, so a play never hashes a name.
    * Entities don't need to know about file paths or sound system internals.
    */
   class SoundManager
@@ -33,36 +43,59 @@ namespace mecha
       float maxDistance{50.0f};
       bool isLooped{false};
       float minInterval{0.0f}; // Minimum seconds between plays (global)
+      int priority{0};         // 3D only: higher keeps its voice when the mixer runs out
+      int maxInstances{0};     // 3D only: concurrent audible instances (0 = unlimited)
+    };
+
+    /**
+     * @brief Voice budget of 3D sounds (2D sounds and music are not counted)
+     */
+    struct MixerPolicy
+    {
+      int maxVoices{32};              // Real voices shared by all 3D sounds
+      float audibleThreshold{0.001f}; // Attenuated volume at or below which a sound is virtual
     };
 
     SoundManager(ISoundController* soundController);
     ~SoundManager() = default;
 
     /**
-     * @brief Register a sound with a name for easy playback
-     * @param name Unique name identifier (e.g., "PLAYER_SHOOT")
+     * @brief Register a sound with a name and decode its clip
+     * @param name Unique name identifier (e.g., "PLAYER_SHOOT"); registering it again replaces the config
      * @param config Sound configuration
+     * @return Id to play the sound with (kInvalidSoundId if the config has no file)
+     */
+    SoundId RegisterSound(const std::string& name, const SoundConfig& config);
+
+    /**
+     * @brief Look up the id of a registered sound (for tools; not meant for per-play use)
+     * @return kInvalidSoundId if no sound has this name
      */
-    void RegisterSound(const std::string& name, const SoundConfig& config);
+    SoundId FindSound(const std::string& name) const;
 
     /**
-     * @brief Play a 3D positional sound by name
-     * @param name Sound name (must be registered)
+     * @brief Set the voice budget of 3D sounds
+     */
+    void SetMixerPolicy(const MixerPolicy& policy);
+
+    /**
+     * @brief Play a registered 3D positional sound
+     * @param id Id returned by RegisterSound
      * @param position World position of the sound
      * @param volumeOverride Optional volume override (uses default if not provided)
      * @param maxDistanceOverride Optional max distance override
      * @return Handle to the sound (nullptr if sound not found or failed to play)
      */
-    void* PlaySound3D(const std::string& name, const glm::vec3& position,
+    void* PlaySound3D(SoundId id, const glm::vec3& position,
                      float volumeOverride = -1.0f, float maxDistanceOverride = -1.0f);
 
     /**
-     * @brief Play a 2D sound by name (not positional, for UI/music)
-     * @param name Sound name (must be registered)
+     * @brief Play a registered 2D sound (not positional, for UI)
+     * @param id Id returned by RegisterSound
      * @param volumeOverride Optional volume override
      * @return Handle to the sound
      */
-    void* PlaySound2D(const std::string& name, float volumeOverride = -1.0f);
+    void* PlaySound2D(SoundId id, float volumeOverride = -1.0f);
 
     /**
      * @brief Update the position of a 3D sound
@@ -99,9 +132,9 @@ namespace mecha
     void Update(float deltaTime);
 
     /**
-     * @brief Preload a sound by name to avoid runtime IO
+     * @brief Preload a registered sound to avoid runtime IO
      */
-    void PreloadSound(const std::string& name);
+    void PreloadSound(SoundId id);
 
     /**
      * @brief Set the master volume for all sounds
@@ -117,17 +150,17 @@ namespace mecha
 
     /**
      * @brief Set the volume multiplier for a specific sound
-     * @param name Sound name (must be registered)
+     * @param id Id returned by RegisterSound
      * @param volume Volume multiplier (0.0 to 1.0, where 1.0 is full volume)
      */
-    void SetSoundVolume(const std::string& name, float volume);
+    void SetSoundVolume(SoundId id, float volume);
 
     /**
      * @brief Get the volume multiplier for a specific sound
-     * @param name Sound name (must be registered)
+     * @param id Id returned by RegisterSound
      * @return Volume multiplier (0.0 to 1.0), or 1.0 if not set
      */
-    float GetSoundVolume(const std::string& name) const;
+    float GetSoundVolume(SoundId id) const;
 
     /**
      * @brief Get the underlying proximity sound system (for advanced use)
@@ -135,18 +168,32 @@ namespace mecha
     std::shared_ptr<ProximitySoundSystem> GetProximitySystem() { return proximitySystem_; }
 
     /**
-     * @brief Get all registered sounds (read-only access)
-     * @return Const reference to the map of registered sounds
+     * @brief Get all registered sounds (read-only access), indexed by SoundId
+     */
+    const std::vector<SoundConfig>& GetRegisteredSounds() const { return sounds_; }
+
+    /**
+     * @brief Name a sound was registered with
      */
-    const std::unordered_map<std::string, SoundConfig>& GetRegisteredSounds() const { return registeredSounds_; }
+    const std::string& GetSoundName(SoundId id) const { return soundNames_[id]; }
 
   private:
     ISoundController* soundController_;
     std::shared_ptr<ProximitySoundSystem> proximitySystem_;
-    std::unordered_map<std::string, SoundConfig> registeredSounds_;
-    std::unordered_map<std::string, float> lastPlayTime_;
-    std::unordered_map<std::string, float> soundVolumes_; // Per-sound volume multipliers
+
+    // Indexed by SoundId
+    std::vector<SoundConfig> sounds_;
+    std::vector<std::string> soundNames_;
+    std::vector<float> lastPlayTime_;
+    std::vector<float> soundVolumes_; // Per-sound volume multipliers
+
+    std::unordered_map<std::string, SoundId> soundIds_; // Registration and FindSound only
     float elapsedTime_{0.0f};
+
+    /**
+     * @brief Config of a playable sound, or nullptr if it is unknown or still in its minInterval
+     */
+    const SoundConfig* BeginPlay(SoundId id);
   };
 
 } // namespace mecha
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace mecha
+{
+
+  /**
+   * @brief Bounded lock-free queue for exactly one producer thread and one consumer thread
+   *
+   * Elements are copied in and out of a power-of-two ring, so T must be trivially copyable.
+   * Push fails when the ring is full and Pop when it is empty; neither ever blocks or allocates.
+   * Elements come out in the order they went in.
+   */
+  template <typename T>
+  class SpscQueue
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "SpscQueue elements are copied as plain data");
+
+  public:
+    /**
+     * @param capacity Minimum number of elements; rounded up to a power of two
+     */
+    explicit SpscQueue(size_t capacity)
+    {
+      size_t size = 2;
+      while (size < capacity)
+      {
+        size <<= 1;
+      }
+      mask_ = size - 1;
+      slots_ = std::make_unique<T[]>(size);
+    }
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    /**
+     * @brief Producer side
+     * @return false if the queue is full
+     */
+    bool Push(const T &value)
+    {
+      const size_t tail = tail_.load(std::memory_order_relaxed);
+      if (tail - cachedHead_ > mask_)
+      {
+        cachedHead_ = head_.load(std::memory_order_acquire);
+        if (tail - cachedHead_ > mask_)
+        {
+          return false;
+        }
+      }
+      slots_[tail & mask_] = value;
+      tail_.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+
+    /**
+     * @brief Consumer side
+     * @return false if the queue is empty
+     */
+    bool Pop(T &value)
+    {
+      const size_t head = head_.load(std::memory_order_relaxed);
+      if (head == cachedTail_)
+      {
+        cachedTail_ = tail_.load(std::memory_order_acquire);
+        if (head == cachedTail_)
+        {
+          return false;
+        }
+      }
+      value = slots_[head & mask_];
+      head_.store(head + 1, std::memory_order_release);
+      return true;
+    }
+
+    size_t Capacity() const { return mask_ + 1; }
+
+  private:
+    static constexpr size_t kCacheLine = 64;
+
+    std::unique_ptr<T[]> slots_;
+    size_t mask_{0};
+
+    // Each side owns a cache line: its index plus its cached copy of the other side's index
+    alignas(kCacheLine) std::atomic<size_t> head_{0}; // Next slot to read, written by the consumer
+    size_t cachedTail_{0};
+    alignas(kCacheLine) std::atomic<size_t> tail_{0}; // Next slot to write, written by the producer
+    size_t cachedHead_{0};
+  };
+
+} // namespace mecha
@@ -1,4 +1,5 @@
 #include "ThirdPersonCamera.h"
+#include "../placeholder/HeightFieldRaycast.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <algorithm>
 
@@ -13,7 +14,7 @@ namespace mecha
         m_lastMouseX(0.0f),
         m_lastMouseY(0.0f),
         m_firstMouse(true),
-        m_terrainSampler{}
+        m_terrain(nullptr)
   {
   }
 
@@ -77,27 +78,17 @@ namespace mecha
 
   float ThirdPersonCamera::CheckTerrainCollision(const glm::vec3 &cameraPos, const glm::vec3 &targetPos, float desiredDistance)
   {
-    if (!m_terrainSampler.callback)
+    if (!m_terrain)
     {
       return desiredDistance;
     }
 
-    // Raycast from target towards camera
-    glm::vec3 rayDir = glm::normalize(cameraPos - targetPos);
-    float currentDist = 0.0f;
-
-    while (currentDist < desiredDistance)
+    // Raycast from target towards camera, keeping kCollisionOffset clearance above the surface
+    glm::vec3 rayOrigin = targetPos - glm::vec3(0.0f, kCollisionOffset, 0.0f);
+    float hitDistance = 0.0f;
+    if (RaycastTerrain(*m_terrain, rayOrigin, cameraPos - targetPos, desiredDistance, hitDistance))
     {
-      glm::vec3 checkPos = targetPos + rayDir * currentDist;
-      float terrainHeight = m_terrainSampler.callback(checkPos.x, checkPos.z);
-
-      // If camera ray goes below terrain, collision detected
-      if (checkPos.y < terrainHeight + kCollisionOffset)
-      {
-        return currentDist;
-      }
-
-      currentDist += kCollisionStepSize;
+      return hitDistance;
     }
 
     return desiredDistance;
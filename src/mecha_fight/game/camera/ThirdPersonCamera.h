@@ -7,6 +7,7 @@ namespace mecha
 {
 
   class MechaPlayer;
+  struct TerrainConfig;
 
   // Third-person camera that orbits around a target with collision detection
   class ThirdPersonCamera
@@ -19,14 +20,8 @@ namespace mecha
     static constexpr float kMouseSensitivity = 0.3f;
     static constexpr float kMinDistance = 0.5f;
     static constexpr float kCollisionOffset = 0.1f;
-    static constexpr float kCollisionStepSize = 0.05f;
     static constexpr float kDefaultNearPlane = 0.1f;
 
-    struct TerrainSampler
-    {
-      float (*callback)(float x, float z) = nullptr;
-    };
-
     ThirdPersonCamera();
 
     // Update camera based on target position and configuration
@@ -49,8 +44,8 @@ namespace mecha
     // Get dynamic near plane (for clipping through terrain)
     float GetNearPlane() const { return m_nearPlane; }
 
-    // Set terrain height sampler for collision detection
-    void SetTerrainSampler(TerrainSampler sampler) { m_terrainSampler = sampler; }
+    // Set the terrain the camera collides with (null disables collision)
+    void SetTerrain(const TerrainConfig *terrain) { m_terrain = terrain; }
 
   private:
     float CheckTerrainCollision(const glm::vec3 &cameraPos, const glm::vec3 &targetPos, float desiredDistance);
@@ -62,7 +57,7 @@ namespace mecha
     float m_lastMouseX;
     float m_lastMouseY;
     bool m_firstMouse;
-    TerrainSampler m_terrainSampler;
+    const TerrainConfig *m_terrain;
   };
 
 } // namespace mecha
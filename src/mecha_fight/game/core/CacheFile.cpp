@@ -0,0 +1,62 @@
+#include "CacheFile.h"
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+
+namespace mecha
+{
+
+  bool WriteFileAtomically(const std::string &path, const std::vector<FileChunk> &chunks, std::string &error)
+  {
+    namespace fs = std::filesystem;
+
+    std::error_code ec;
+    const fs::path target(path);
+    if (target.has_parent_path())
+    {
+      fs::create_directories(target.parent_path(), ec);
+    }
+
+    std::ostringstream tempName;
+    tempName << path << '.' << std::hex << std::hash<std::thread::id>{}(std::this_thread::get_id()) << ".tmp";
+    const fs::path tempPath(tempName.str());
+    {
+      std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+      if (!out)
+      {
+        error = "could not create " + tempPath.string();
+        return false;
+      }
+      for (const FileChunk &chunk : chunks)
+      {
+        out.write(static_cast<const char *>(chunk.data), static_cast<std::streamsize>(chunk.size));
+      }
+      if (!out)
+      {
+        error = "failed writing " + tempPath.string();
+        out.close();
+        fs::remove(tempPath, ec);
+        return false;
+      }
+    }
+
+    // Windows refuses to rename over an existing file, so retry once the old one is gone
+    fs::rename(tempPath, target, ec);
+    if (ec)
+    {
+      fs::remove(target, ec);
+      fs::rename(tempPath, target, ec);
+      if (ec)
+      {
+        error = "could not move " + tempPath.string() + " into place: " + ec.message();
+        fs::remove(tempPath, ec);
+        return false;
+      }
+    }
+    return true;
+  }
+
+} // namespace mecha
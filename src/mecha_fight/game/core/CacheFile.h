@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace mecha
+{
+
+  constexpr uint64_t kFnv1aOffset = 1469598103934665603ull;
+
+  /**
+   * @brief Fold bytes into a 64-bit FNV-1a hash (start from kFnv1aOffset); cache keys and change signatures
+   */
+  inline uint64_t Fnv1a(uint64_t hash, const void *data, size_t size)
+  {
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+      hash ^= bytes[i];
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+
+  /**
+   * @brief Fold the bytes of one value; hash fields one by one rather than structs with padding
+   */
+  template <typename T>
+  uint64_t Fnv1aValue(uint64_t hash, const T &value)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "Fnv1aValue hashes the object representation");
+    return Fnv1a(hash, &value, sizeof(T));
+  }
+
+  /**
+   * @brief A run of bytes written to a file, in order with the others
+   */
+  struct FileChunk
+  {
+    const void *data;
+    size_t size;
+  };
+
+  /**
+   * @brief Replace a file with the given chunks, never leaving a partial file at path
+   *
+   * Creates the parent directories, writes to a temporary next to path and renames it into place,
+   * so a crash or a failed write leaves either the old file or no file, never one that looks valid.
+   * Temporaries are named per thread: concurrent writers of the same path do not collide, the last
+   * rename wins. On failure the temporary is removed and error says why.
+   */
+  bool WriteFileAtomically(const std::string &path, const std::vector<FileChunk> &chunks, std::string &error);
+
+} // namespace mecha
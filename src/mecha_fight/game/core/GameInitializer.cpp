@@ -14,28 +14,7 @@
 #include <glm/glm.hpp>
 #include "../rendering/RenderConstants.h"
 #include "../systems/MissileSystem.h"
-
-namespace
-{
-  // Static storage for terrain config pointer used by camera collision
-  const mecha::TerrainConfig *g_terrainConfigForCamera = nullptr;
-
-  // Static function that can be used as a function pointer callback
-  float TerrainHeightCallback(float x, float z)
-  {
-    if (g_terrainConfigForCamera)
-    {
-      static bool loggedSample = false;
-      if (!loggedSample)
-      {
-        std::cout << "[GameInitializer] Terrain sampler active" << std::endl;
-        loggedSample = true;
-      }
-      return mecha::SampleTerrainHeight(x, z, *g_terrainConfigForCamera);
-    }
-    return 0.0f;
-  }
-} // anonymous namespace
+#include "../placeholder/HeightFieldCache.h"
 
 namespace mecha
 {
@@ -104,7 +83,8 @@ namespace mecha
     return result;
   }
 
-  bool GameInitializer::LoadResources(ResourceManager &resourceMgr, TerrainConfig &terrainConfig)
+  bool GameInitializer::LoadResources(ResourceManager &resourceMgr, TerrainConfig &terrainConfig,
+                                      const LoadProgressCallback &onProgress)
   {
     std::cout << "[GameInitializer] Loading game resources..." << std::endl;
 
@@ -115,6 +95,37 @@ namespace mecha
       return false;
     }
 
+    auto reportProgress = [&onProgress](float progress, const std::string &label)
+    {
+      if (onProgress)
+      {
+        onProgress(progress, label);
+      }
+    };
+
+    // Parse every model on worker threads up front. Shaders and the skybox need the GL context,
+    // so the main thread builds them while the workers run, then uploads models as they finish.
+    // Cooked binaries skip glTF parsing on later launches; they are rewritten when a source changes
+    const std::string terrainModelPath = FileSystem::getPath("resources/objects/mountain_range_01/scene.gltf");
+    resourceMgr.Models().SetCookedCacheDirectory(FileSystem::getPath("cache/models"));
+    // Images are hashed, so one shared by several models is decoded and compressed once, and the
+    // compressed mip chains are reused on later launches
+    resourceMgr.Textures().SetCacheDirectory(FileSystem::getPath("cache/textures"));
+    // Distance LODs (the trailing true) for the world props and enemies are simplified by the workers on a
+    // cache miss and cooked with the model. The player stays at full detail since it is always close to
+    // the camera; terrain LODs are handled by TerrainChunks, which builds a chain per chunk.
+    const ModelLoader::CpuRetention release = ModelLoader::CpuRetention::Release;
+    resourceMgr.Models().BeginLoadModels({
+        {"dragon_mecha", FileSystem::getPath("resources/objects/new-dragon/new-dragon-mech.gltf")},
+        {"hexapod_robot", FileSystem::getPath("resources/objects/episode_71_-_hexapod_robot/scene.gltf"), release, true},
+        {"energy_gun", FileSystem::getPath("resources/objects/energy_gun/scene.gltf"), release, true},
+        {"energy_gate", FileSystem::getPath("resources/objects/energy_gate_-_classical_style/scene.gltf"), release, true},
+        {"mecha_godzilla", FileSystem::getPath("resources/objects/deathbringer_from_horizon_zero_dawn/scene.gltf"), release, true},
+        {"r73_missile", FileSystem::getPath("resources/objects/r-73_vympel/scene.gltf"), release, true},
+        // The terrain keeps its CPU geometry for the heightfield bake and chunking; the caller releases it
+        {"mountain_range_01", terrainModelPath, ModelLoader::CpuRetention::Keep},
+    });
+
     // Load shaders
     resourceMgr.Shaders().LoadShader("mecha",
                                      FileSystem::getPath("src/mecha_fight/shaders/mecha.vs"),
@@ -128,21 +139,27 @@ namespace mecha
     resourceMgr.Shaders().LoadShader("ui",
                                      FileSystem::getPath("src/mecha_fight/shaders/ui.vs"),
                                      FileSystem::getPath("src/mecha_fight/shaders/ui.fs"));
+    resourceMgr.Shaders().LoadShader("ui_batch",
+                                     FileSystem::getPath("src/mecha_fight/shaders/ui_batch.vs"),
+                                     FileSystem::getPath("src/mecha_fight/shaders/ui_batch.fs"));
     resourceMgr.Shaders().LoadShader("color",
                                      FileSystem::getPath("src/mecha_fight/shaders/color.vs"),
                                      FileSystem::getPath("src/mecha_fight/shaders/color.fs"));
     resourceMgr.Shaders().LoadShader("skybox",
                                      FileSystem::getPath("src/mecha_fight/shaders/skybox.vs"),
                                      FileSystem::getPath("src/mecha_fight/shaders/skybox.fs"));
-    resourceMgr.Shaders().LoadShader("ssao_input",
-                                     FileSystem::getPath("src/mecha_fight/shaders/ssao_input.vs"),
-                                     FileSystem::getPath("src/mecha_fight/shaders/ssao_input.fs"));
     resourceMgr.Shaders().LoadShader("ssao",
                                      FileSystem::getPath("src/mecha_fight/shaders/ssao_quad.vs"),
                                      FileSystem::getPath("src/mecha_fight/shaders/ssao.fs"));
     resourceMgr.Shaders().LoadShader("ssao_blur",
                                      FileSystem::getPath("src/mecha_fight/shaders/ssao_quad.vs"),
                                      FileSystem::getPath("src/mecha_fight/shaders/ssao_blur.fs"));
+    resourceMgr.Shaders().LoadShader("ssao_upsample",
+                                     FileSystem::getPath("src/mecha_fight/shaders/ssao_quad.vs"),
+                                     FileSystem::getPath("src/mecha_fight/shaders/ssao_upsample.fs"));
+    resourceMgr.Shaders().LoadShader("ssao_composite",
+                                     FileSystem::getPath("src/mecha_fight/shaders/ssao_quad.vs"),
+                                     FileSystem::getPath("src/mecha_fight/shaders/ssao_composite.fs"));
 
     const std::string skyboxPath = FileSystem::getPath("resources/textures/skybox/SBS - Cloudy Skyboxes - Cubemap/Cubemap/Cubemap_Sky_05-512x512.png");
     if (!resourceMgr.LoadSkyboxCubemap(skyboxPath))
@@ -150,68 +167,28 @@ namespace mecha
       std::cerr << "[GameInitializer] Failed to load skybox cubemap: " << skyboxPath << std::endl;
     }
 
-    // Load player mecha model
-    Model *mechaModel = resourceMgr.Models().LoadModel("dragon_mecha",
-                                                       FileSystem::getPath("resources/objects/new-dragon/new-dragon-mech.gltf"));
-    if (!mechaModel)
-    {
-      std::cout << "[GameInitializer] Failed to load player mecha model" << std::endl;
-      return false;
-    }
-
-    // Load enemy shark mecha model
-    Model *dragonModel = resourceMgr.Models().GetModel("dragon_mecha");
-    if (!dragonModel)
-    {
-      std::cerr << "[GameInitializer] Failed to get dragon_mecha model" << std::endl;
-      return false;
-    }
-
-    // Load hexapod robot enemy model
-    bool hexapodLoaded = resourceMgr.Models().LoadModel("hexapod_robot",
-                                                        FileSystem::getPath("resources/objects/episode_71_-_hexapod_robot/scene.gltf"));
-    if (!hexapodLoaded)
-    {
-      std::cerr << "[GameInitializer] Failed to load hexapod_robot model" << std::endl;
-      return false;
-    }
-
-    // Load energy gun turret model
-    bool energyGunLoaded = resourceMgr.Models().LoadModel("energy_gun",
-                                                         FileSystem::getPath("resources/objects/energy_gun/scene.gltf"));
-    if (!energyGunLoaded)
-    {
-      std::cerr << "[GameInitializer] Failed to load energy_gun model" << std::endl;
-      return false;
-    }
+    reportProgress(0.1f, "Shaders");
 
-    // Load energy gate portal model
-    bool energyGateLoaded = resourceMgr.Models().LoadModel("energy_gate",
-                                                           FileSystem::getPath("resources/objects/energy_gate_-_classical_style/scene.gltf"));
-    if (!energyGateLoaded)
-    {
-      std::cerr << "[GameInitializer] Failed to load energy_gate model" << std::endl;
-      return false;
-    }
+    // Models account for most of the bar; the heightfield bake takes the rest
+    resourceMgr.Models().FinishLoadModels([&reportProgress](size_t completed, size_t total, const std::string &name)
+                                          { reportProgress(0.1f + 0.7f * static_cast<float>(completed) / static_cast<float>(total), name); });
 
-    bool godzillaLoaded = resourceMgr.Models().LoadModel("mecha_godzilla",
-                                                         FileSystem::getPath("resources/objects/deathbringer_from_horizon_zero_dawn/scene.gltf"));
-    if (!godzillaLoaded)
+    // The missile is optional; every other model is required
+    for (const char *requiredModel : {"dragon_mecha", "hexapod_robot", "energy_gun", "energy_gate", "mecha_godzilla"})
     {
-      std::cerr << "[GameInitializer] Failed to load deathbringer model" << std::endl;
-      return false;
+      if (!resourceMgr.Models().HasModel(requiredModel))
+      {
+        std::cerr << "[GameInitializer] Failed to load " << requiredModel << " model" << std::endl;
+        return false;
+      }
     }
-
-    bool missileLoaded = resourceMgr.Models().LoadModel("r73_missile",
-                                                        FileSystem::getPath("resources/objects/r-73_vympel/scene.gltf"));
-    if (!missileLoaded)
+    if (!resourceMgr.Models().HasModel("r73_missile"))
     {
       std::cerr << "[GameInitializer] Failed to load r-73_vympel missile model" << std::endl;
     }
 
-    // Load icy terrain model and build collision heightfield
-    Model *terrainModel = resourceMgr.Models().LoadModel("mountain_range_01",
-                                                         FileSystem::getPath("resources/objects/mountain_range_01/scene.gltf"));
+    // Icy terrain model, used to build the collision heightfield
+    Model *terrainModel = resourceMgr.Models().GetModel("mountain_range_01");
     if (!terrainModel)
     {
       std::cerr << "[GameInitializer] Failed to load mountain_range_01 terrain model" << std::endl;
@@ -259,20 +236,41 @@ namespace mecha
       std::cout << "[GameInitializer] Terrain model info missing, using fallback bounds" << std::endl;
     }
 
+    // Baking rasterises every terrain triangle; reuse the previous bake while model and grid are unchanged
     constexpr int kTerrainHeightSamples = 1024;
-    BuildHeightFieldFromModel(*terrainModel, terrainConfig, kTerrainHeightSamples, kTerrainHeightSamples);
+    const std::string heightCachePath = FileSystem::getPath("cache/mountain_range_01.heightfield");
+    const uint64_t heightCacheKey = ComputeHeightFieldCacheKey(terrainModelPath, terrainConfig, kTerrainHeightSamples, kTerrainHeightSamples);
+    if (!LoadHeightFieldCache(heightCachePath, heightCacheKey, terrainConfig))
+    {
+      BuildHeightFieldFromModel(*terrainModel, terrainConfig, kTerrainHeightSamples, kTerrainHeightSamples);
+      SaveHeightFieldCache(heightCachePath, heightCacheKey, terrainConfig);
+    }
+
+    reportProgress(0.95f, "Terrain heightfield");
+
+    // LODs and the heightfield are built; every other model is only drawn from here on
+    resourceMgr.Models().ReleaseCpuData();
 
     // Generate meshes
     resourceMgr.Meshes().GenerateSphere("enemy_sphere");
 
+    reportProgress(1.0f, "Ready");
+
     std::cout << "[GameInitializer] All resources loaded successfully" << std::endl;
     return true;
   }
 
-  bool GameInitializer::InitializeDebugSystems(DebugTextRenderer &debugText, unsigned int screenWidth, unsigned int screenHeight)
+  bool GameInitializer::InitializeDebugSystems(FontService &fonts, DebugTextRenderer &debugText, unsigned int screenWidth,
+                                               unsigned int screenHeight)
   {
+    if (!fonts.Init(screenWidth, screenHeight))
+    {
+      std::cout << "[GameInitializer] Failed to initialize the font service" << std::endl;
+      return false;
+    }
+
     const std::string debugFontPath = FileSystem::getPath("resources/fonts/Antonio-Regular.ttf");
-    if (!debugText.Init(screenWidth, screenHeight, debugFontPath, 42))
+    if (!debugText.Init(fonts, debugFontPath, 42))
     {
       std::cout << "[GameInitializer] Failed to initialize debug font: " << debugFontPath << std::endl;
       return false;
@@ -319,13 +317,20 @@ namespace mecha
     const float horizontalOffset = orthoHalf * 0.35f;
     shadowConfig.lightPosition = terrainCenter + glm::vec3(horizontalOffset, lightHeight, horizontalOffset);
     shadowConfig.target = terrainCenter;
+
+    // Cascades follow the camera and only receive dynamic casters; the terrain and the
+    // gates are baked once into a static layer covering the ortho volume above.
+    shadowConfig.cascadeCount = kShadowCascadeCount;
+    shadowConfig.casterMargin = shadowConfig.farPlane;
+    shadowConfig.staticResolution = kStaticShadowMapResolution;
     if (!shadowMapper.Init(shadowConfig))
     {
       std::cout << "[GameInitializer] Failed to initialize shadow mapper" << std::endl;
       return false;
     }
 
-    std::cout << "[GameInitializer] Shadow mapper initialized (extent ~" << orthoHalf * 2.0f << "m)" << std::endl;
+    std::cout << "[GameInitializer] Shadow mapper initialized (" << shadowMapper.GetCascadeCount()
+              << " cascades, caster margin ~" << shadowConfig.casterMargin << "m)" << std::endl;
     return true;
   }
 
@@ -729,13 +734,7 @@ namespace mecha
       return;
     }
 
-    // Store the terrain config pointer in the static variable
-    g_terrainConfigForCamera = terrainConfigPtr;
-
-    // Set up the terrain sampler with our static function
-    ThirdPersonCamera::TerrainSampler terrainSampler;
-    terrainSampler.callback = TerrainHeightCallback;
-    camera.SetTerrainSampler(terrainSampler);
+    camera.SetTerrain(terrainConfigPtr);
 
     std::cout << "[GameInitializer] Camera terrain sampler configured" << std::endl;
   }
@@ -2,6 +2,7 @@
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <functional>
 #include <memory>
 #include <string>
 #include "../entities/MechaPlayer.h"
@@ -19,6 +20,7 @@
 #include "../rendering/ResourceManager.h"
 #include "../rendering/ShadowMapper.h"
 #include "../ui/DebugTextRenderer.h"
+#include "../ui/FontService.h"
 #include "../placeholder/TerrainPlaceholder.h"
 #include "../../core/GameWorld.h"
 
@@ -56,6 +58,11 @@ namespace mecha
       std::string errorMessage;
     };
 
+    /**
+     * @brief Loading progress in [0, 1] with a label for the step that just finished
+     */
+    using LoadProgressCallback = std::function<void(float progress, const std::string &label)>;
+
     GameInitializer();
     ~GameInitializer();
 
@@ -68,18 +75,22 @@ namespace mecha
      * @brief Load all game resources (shaders, models, meshes)
      * @param resourceMgr Resource manager to load into
      * @param terrainConfig Terrain configuration that will be updated with model data
+     * @param onProgress Called on the main thread as loading advances (may render a loading screen)
      * @return true if all resources loaded successfully
      */
-    bool LoadResources(ResourceManager &resourceMgr, TerrainConfig &terrainConfig);
+    bool LoadResources(ResourceManager &resourceMgr, TerrainConfig &terrainConfig,
+                       const LoadProgressCallback &onProgress = {});
 
     /**
      * @brief Initialize debug rendering systems
+     * @param fonts Font service shared by every UI screen
      * @param debugText Debug text renderer
      * @param screenWidth Screen width
      * @param screenHeight Screen height
      * @return true if initialization successful
      */
-    bool InitializeDebugSystems(DebugTextRenderer &debugText, unsigned int screenWidth, unsigned int screenHeight);
+    bool InitializeDebugSystems(FontService &fonts, DebugTextRenderer &debugText, unsigned int screenWidth,
+                                unsigned int screenHeight);
 
     /**
      * @brief Initialize shadow mapping system
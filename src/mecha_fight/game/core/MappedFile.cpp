@@ -0,0 +1,92 @@
+// Windows-specific defines to prevent conflicts - must be before any includes
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#endif
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mecha
+{
+
+  MappedFile::MappedFile(const std::string &path)
+  {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+      return;
+    }
+    m_file = file;
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+      return;
+    }
+    m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mapping)
+    {
+      return;
+    }
+    m_data = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+    if (m_data)
+    {
+      m_size = static_cast<size_t>(size.QuadPart);
+    }
+#else
+    m_fd = open(path.c_str(), O_RDONLY);
+    if (m_fd < 0)
+    {
+      return;
+    }
+    struct stat st{};
+    if (fstat(m_fd, &st) != 0 || st.st_size <= 0)
+    {
+      return;
+    }
+    void *data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (data != MAP_FAILED)
+    {
+      m_data = data;
+      m_size = static_cast<size_t>(st.st_size);
+    }
+#endif
+  }
+
+  MappedFile::~MappedFile()
+  {
+#ifdef _WIN32
+    if (m_data)
+    {
+      UnmapViewOfFile(m_data);
+    }
+    if (m_mapping)
+    {
+      CloseHandle(m_mapping);
+    }
+    if (m_file)
+    {
+      CloseHandle(m_file);
+    }
+#else
+    if (m_data)
+    {
+      munmap(m_data, m_size);
+    }
+    if (m_fd >= 0)
+    {
+      close(m_fd);
+    }
+#endif
+  }
+
+} // namespace mecha
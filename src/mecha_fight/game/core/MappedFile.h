@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace mecha
+{
+
+  /**
+   * @brief Read-only memory mapping of a whole file, unmapped on destruction
+   *
+   * Data() is null when the file is missing, empty or cannot be mapped.
+   */
+  class MappedFile
+  {
+  public:
+    explicit MappedFile(const std::string &path);
+    ~MappedFile();
+
+    // Non-copyable
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const unsigned char *Data() const { return static_cast<const unsigned char *>(m_data); }
+    size_t Size() const { return m_size; }
+
+  private:
+    void *m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    void *m_file = nullptr;    ///< HANDLE
+    void *m_mapping = nullptr; ///< HANDLE
+#else
+    int m_fd = -1;
+#endif
+  };
+
+} // namespace mecha
@@ -9,6 +9,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "../rendering/RenderConstants.h"
+#include "../rendering/ShadowMapper.h"
 #include "../systems/ProjectileSystem.h"
 #include "MechaPlayer.h"
 #include "PortalGate.h"
@@ -32,29 +33,6 @@ namespace mecha
     constexpr float kMinPlayerDistance = 10.0f;
     constexpr float kSpawnExtent = 90.0f;
     constexpr float kEnemyBulletSpeed = 12.0f;
-    constexpr int kMaxConcurrentMovementLoops = 3;
-    int gActiveMovementLoops = 0;
-
-    void IncrementMovementLoopCount()
-    {
-      if (gActiveMovementLoops < kMaxConcurrentMovementLoops)
-      {
-        ++gActiveMovementLoops;
-      }
-    }
-
-    void DecrementMovementLoopCount()
-    {
-      if (gActiveMovementLoops > 0)
-      {
-        --gActiveMovementLoops;
-      }
-    }
-
-    bool HasMovementSlotAvailable()
-    {
-      return gActiveMovementLoops < kMaxConcurrentMovementLoops;
-    }
   }
 
   EnemyDrone::EnemyDrone()
@@ -135,14 +113,13 @@ namespace mecha
         {
           params->soundManager->StopSound(movementSoundHandle_);
           movementSoundHandle_ = nullptr;
-          DecrementMovementLoopCount();
         }
-        params->soundManager->PlaySound3D("ENEMY_DEATH", transform_.position);
+        params->soundManager->PlaySound3D(params->sounds.enemyDeath, transform_.position);
       }
     }
   }
 
-  void EnemyDrone::RespawnAwayFromPlayer(const MechaPlayer *player, TerrainHeightSampler sampler)
+  void EnemyDrone::RespawnAwayFromPlayer(const MechaPlayer *player, const HeightField &terrain)
   {
     glm::vec3 candidate = transform_.position;
     for (int i = 0; i < 50; ++i)
@@ -158,7 +135,7 @@ namespace mecha
         }
       }
 
-      candidate = glm::vec3(rx, sampler(rx, rz) + kRadius + kHoverOffset, rz);
+      candidate = glm::vec3(rx, terrain.Sample(rx, rz) + kRadius + kHoverOffset, rz);
       break;
     }
 
@@ -174,7 +151,7 @@ namespace mecha
     animationController_.SetAction(static_cast<int>(actionState_));
   }
 
-void EnemyDrone::RespawnNearGate(TerrainHeightSampler sampler)
+void EnemyDrone::RespawnNearGate(const HeightField &terrain)
 {
   if (!associatedGate_ || !associatedGate_->IsAlive())
   {
@@ -193,7 +170,7 @@ void EnemyDrone::RespawnNearGate(TerrainHeightSampler sampler)
     float rx = gatePos.x + std::cos(angle) * radius;
     float rz = gatePos.z + std::sin(angle) * radius;
 
-      candidate = glm::vec3(rx, sampler(rx, rz) + kRadius + kHoverOffset, rz);
+      candidate = glm::vec3(rx, terrain.Sample(rx, rz) + kRadius + kHoverOffset, rz);
       break;
     }
 
@@ -232,7 +209,6 @@ void EnemyDrone::RespawnNearGate(TerrainHeightSampler sampler)
         {
           params->soundManager->StopSound(movementSoundHandle_);
           movementSoundHandle_ = nullptr;
-          DecrementMovementLoopCount();
         }
         return;
       }
@@ -264,7 +240,7 @@ void EnemyDrone::RespawnNearGate(TerrainHeightSampler sampler)
         velocity_ = -velocity_;
       }
 
-      transform_.position.y = params->terrainSampler(transform_.position.x, transform_.position.z) + kRadius + kHoverOffset;
+      transform_.position.y = params->terrain(transform_.position.x, transform_.position.z) + kRadius + kHoverOffset;
 
       shootTimer_ += deltaTime;
       if (shootTimer_ >= kShootInterval && params->projectiles && params->player)
@@ -276,7 +252,7 @@ void EnemyDrone::RespawnNearGate(TerrainHeightSampler sampler)
         // Play shoot sound
         if (params->soundManager)
         {
-          params->soundManager->PlaySound3D("ENEMY_SHOOT", transform_.position);
+          params->soundManager->PlaySound3D(params->sounds.enemyShoot, transform_.position);
         }
       }
     }
@@ -293,7 +269,7 @@ void EnemyDrone::RespawnNearGate(TerrainHeightSampler sampler)
       }
       if (respawnTimer_ <= 0.0f)
       {
-        RespawnNearGate(params->terrainSampler);
+        RespawnNearGate(params->terrain);
       }
     }
 
@@ -308,19 +284,15 @@ void EnemyDrone::RespawnNearGate(TerrainHeightSampler sampler)
     // Manage looping movement sound (limit concurrent loops to avoid stacking)
     if (params && params->soundManager)
     {
-      if (alive_ && hasVelocity && !movementSoundHandle_ && HasMovementSlotAvailable())
+      if (alive_ && hasVelocity && !movementSoundHandle_)
       {
-        movementSoundHandle_ = params->soundManager->PlaySound3D("ENEMY_DRONE_MOVEMENT", transform_.position);
-        if (movementSoundHandle_)
-        {
-          IncrementMovementLoopCount();
-        }
+        // The mixer keeps only the nearest few drone hums audible (maxInstances)
+        movementSoundHandle_ = params->soundManager->PlaySound3D(params->sounds.enemyDroneMovement, transform_.position);
       }
       else if ((!alive_ || !hasVelocity) && movementSoundHandle_)
       {
         params->soundManager->StopSound(movementSoundHandle_);
         movementSoundHandle_ = nullptr;
-        DecrementMovementLoopCount();
       }
       else if (alive_ && hasVelocity && movementSoundHandle_)
       {
@@ -351,8 +323,14 @@ void EnemyDrone::RespawnNearGate(TerrainHeightSampler sampler)
         return;
       }
 
+      if (ctx.shadowCascade >= 0 &&
+          !ShadowMapper::BoundsInLightVolume(ctx.lightSpaceMatrix, model, model_->GetBoundingMin(), model_->GetBoundingMax()))
+      {
+        return;
+      }
+
       ctx.overrideShader->setMat4("model", model);
-      model_->Draw(*ctx.overrideShader);
+      model_->Draw(*ctx.overrideShader, lod_.Level());
       return;
     }
 
@@ -362,35 +340,22 @@ void EnemyDrone::RespawnNearGate(TerrainHeightSampler sampler)
     }
 
     shader_->use();
-    shader_->setMat4("projection", ctx.projection);
-    shader_->setMat4("view", ctx.view);
-    shader_->setMat4("lightSpaceMatrix", ctx.lightSpaceMatrix);
-    shader_->setVec3("viewPos", ctx.viewPos);
-    shader_->setVec3("lightPos", ctx.lightPos);
-    shader_->setVec3("lightIntensity", ctx.lightIntensity);
     shader_->setBool("useBaseColor", useBaseColor_);
     if (useBaseColor_)
     {
       shader_->setVec3("baseColor", baseColor_);
     }
 
-    glActiveTexture(GL_TEXTURE0 + kShadowMapTextureUnit);
-    glBindTexture(GL_TEXTURE_2D, ctx.shadowMapTexture);
-    shader_->setInt("shadowMap", kShadowMapTextureUnit);
-
-    bool useSSAO = ctx.ssaoEnabled && ctx.ssaoTexture != 0;
-    shader_->setBool("useSSAO", useSSAO);
-    shader_->setVec2("screenSize", ctx.screenSize);
-    shader_->setFloat("aoStrength", ctx.ssaoStrength);
-    if (useSSAO)
+    if (ctx.shadowMapper)
     {
-      glActiveTexture(GL_TEXTURE0 + kSSAOTexUnit);
-      glBindTexture(GL_TEXTURE_2D, ctx.ssaoTexture);
-      shader_->setInt("ssaoMap", kSSAOTexUnit);
+      ctx.shadowMapper->BindShadowMaps(*shader_, kShadowMapTextureUnit);
     }
+
+    lod_.Update(ctx.projection, ctx.viewPos, model, model_->GetBoundingMin(), model_->GetBoundingMax(),
+                model_->GetLodCount());
     shader_->setMat4("model", model);
 
-    model_->Draw(*shader_);
+    model_->Draw(*shader_, lod_.Level());
   }
 
   void EnemyDrone::SetRenderResources(Shader *shader, Model *model, bool useBaseColor, const glm::vec3 &baseColor)
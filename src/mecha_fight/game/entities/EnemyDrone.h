@@ -8,6 +8,8 @@ class Shader;
 #include "../../core/Entity.h"
 #include "Enemy.h"
 #include "../GameplayTypes.h"
+#include "../audio/GameSounds.h"
+#include "../rendering/LodSelector.h"
 #include "../animation/AnimationController.h"
 
 namespace mecha
@@ -28,9 +30,10 @@ namespace mecha
     {
       const MechaPlayer *player{nullptr};
       ProjectileSystem *projectiles{nullptr};
-      TerrainHeightSampler terrainSampler{};
+      HeightField terrain{};
       std::vector<SparkParticle> *sparkParticles{nullptr};
       class SoundManager *soundManager{nullptr};
+      GameSounds sounds{};
     };
 
     EnemyDrone();
@@ -56,8 +59,8 @@ namespace mecha
     PortalGate *AssociatedGate() const { return associatedGate_; }
 
   private:
-    void RespawnAwayFromPlayer(const MechaPlayer *player, TerrainHeightSampler sampler);
-    void RespawnNearGate(TerrainHeightSampler sampler);
+    void RespawnAwayFromPlayer(const MechaPlayer *player, const HeightField &terrain);
+    void RespawnNearGate(const HeightField &terrain);
     void SpawnSparkParticles(const glm::vec3 &hitPosition, const UpdateParams *params) const;
     PortalGate *associatedGate_{nullptr};
     glm::vec3 homeCenter_{0.0f, 0.0f, 0.0f};
@@ -74,6 +77,7 @@ namespace mecha
     glm::vec3 pivotOffset_{0.0f};
     Shader *shader_{nullptr};
     Model *model_{nullptr};
+    LodSelector lod_{};
     bool useBaseColor_{false};
     glm::vec3 baseColor_{1.0f};
     AnimationController animationController_{};
@@ -8,6 +8,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "../rendering/RenderConstants.h"
+#include "../rendering/ShadowMapper.h"
 #include "../systems/ProjectileSystem.h"
 #include "../audio/SoundManager.h"
 #include "MechaPlayer.h"
@@ -123,7 +124,7 @@ namespace mecha
     float groundHeight = spawnPosition_.y;
     if (params)
     {
-      groundHeight = params->terrainSampler(spawnPosition_.x, spawnPosition_.z);
+      groundHeight = params->terrain(spawnPosition_.x, spawnPosition_.z);
     }
 
     if (forceImmediate)
@@ -373,7 +374,7 @@ namespace mecha
   {
     if (params && params->soundManager && !movementSoundHandle_)
     {
-      movementSoundHandle_ = params->soundManager->PlaySound3D("BOSS_MOVEMENT", transform_.position);
+      movementSoundHandle_ = params->soundManager->PlaySound3D(params->sounds.bossMovement, transform_.position);
     }
   }
 
@@ -397,7 +398,7 @@ namespace mecha
     const auto *params = static_cast<const UpdateParams *>(GetFramePayload());
     if (params && params->soundManager)
     {
-      params->soundManager->PlaySound3D("BOSS_SHOCKWAVE", transform_.position);
+      params->soundManager->PlaySound3D(params->sounds.bossShockwave, transform_.position);
     }
 
     ShockwaveParticle wave{};
@@ -421,7 +422,7 @@ namespace mecha
     {
       return worldPos.y;
     }
-    return params->terrainSampler(worldPos.x, worldPos.z);
+    return params->terrain(worldPos.x, worldPos.z);
   }
 
   void GodzillaEnemy::EnterState(State newState)
@@ -471,7 +472,7 @@ namespace mecha
       StopMovementSound(params);
       if (params && params->soundManager)
       {
-        params->soundManager->PlaySound3D("BOSS_DEATH", transform_.position);
+        params->soundManager->PlaySound3D(params->sounds.bossDeath, transform_.position);
       }
     }
 
@@ -503,40 +504,36 @@ namespace mecha
       model = glm::scale(model, glm::vec3(modelScale_));
       model = glm::translate(model, -pivotOffset_);
 
+      if (ctx.shadowCascade >= 0 &&
+          !ShadowMapper::BoundsInLightVolume(ctx.lightSpaceMatrix, model, model_->GetBoundingMin(), model_->GetBoundingMax()))
+      {
+        return;
+      }
+
       ctx.overrideShader->setMat4("model", model);
-      model_->Draw(*ctx.overrideShader);
+      model_->Draw(*ctx.overrideShader, lod_.Level());
       return;
     }
 
     shader_->use();
-    shader_->setMat4("projection", ctx.projection);
-    shader_->setMat4("view", ctx.view);
-    shader_->setMat4("lightSpaceMatrix", ctx.lightSpaceMatrix);
-    shader_->setVec3("viewPos", ctx.viewPos);
-    shader_->setVec3("lightPos", ctx.lightPos);
-    shader_->setVec3("lightIntensity", ctx.lightIntensity);
 
-    glActiveTexture(GL_TEXTURE0 + kShadowMapTextureUnit);
-    glBindTexture(GL_TEXTURE_2D, ctx.shadowMapTexture);
-    shader_->setInt("shadowMap", kShadowMapTextureUnit);
-
-    shader_->setBool("useBaseColor", false);
-    shader_->setBool("useSSAO", ctx.ssaoEnabled && ctx.ssaoTexture != 0);
-    if (ctx.ssaoEnabled && ctx.ssaoTexture != 0)
+    if (ctx.shadowMapper)
     {
-      glActiveTexture(GL_TEXTURE0 + kSSAOTexUnit);
-      glBindTexture(GL_TEXTURE_2D, ctx.ssaoTexture);
-      shader_->setInt("ssaoMap", kSSAOTexUnit);
+      ctx.shadowMapper->BindShadowMaps(*shader_, kShadowMapTextureUnit);
     }
 
+    shader_->setBool("useBaseColor", false);
+
     glm::mat4 modelMatrix = glm::mat4(1.0f);
     modelMatrix = glm::translate(modelMatrix, transform_.position);
     modelMatrix = glm::rotate(modelMatrix, glm::radians(transform_.rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
     modelMatrix = glm::scale(modelMatrix, glm::vec3(modelScale_));
     modelMatrix = glm::translate(modelMatrix, -pivotOffset_);
 
+    lod_.Update(ctx.projection, ctx.viewPos, modelMatrix, model_->GetBoundingMin(), model_->GetBoundingMax(),
+                model_->GetLodCount());
     shader_->setMat4("model", modelMatrix);
-    model_->Draw(*shader_);
+    model_->Draw(*shader_, lod_.Level());
   }
 
   void GodzillaEnemy::InitializeGuns()
@@ -658,7 +655,7 @@ namespace mecha
 
         if (params->soundManager)
         {
-          params->soundManager->PlaySound3D("BOSS_PROJECTILE", gunWorldPos);
+          params->soundManager->PlaySound3D(params->sounds.bossProjectile, gunWorldPos);
         }
       }
     }
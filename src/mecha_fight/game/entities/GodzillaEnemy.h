@@ -8,6 +8,8 @@ class Shader;
 
 #include "Enemy.h"
 #include "../GameplayTypes.h"
+#include "../audio/GameSounds.h"
+#include "../rendering/LodSelector.h"
 #include "../animation/AnimationController.h"
 
 namespace mecha
@@ -43,11 +45,12 @@ namespace mecha
     struct UpdateParams
     {
       const MechaPlayer *player{nullptr};
-      TerrainHeightSampler terrainSampler{};
+      HeightField terrain{};
       std::vector<ShockwaveParticle> *shockwaveParticles{nullptr};
       std::vector<ThrusterParticle> *thrusterParticles{nullptr};
       class ProjectileSystem *projectiles{nullptr};
       class SoundManager *soundManager{nullptr};
+      GameSounds sounds{};
     };
 
     GodzillaEnemy();
@@ -98,6 +101,7 @@ namespace mecha
     AnimationController animationController_{};
     Shader *shader_{nullptr};
     Model *model_{nullptr};
+    LodSelector lod_{};
     glm::vec3 pivotOffset_{0.0f};
     float modelScale_{1.0f};
 
@@ -1,6 +1,7 @@
 #include "MechaPlayer.h"
 
 #include "../rendering/RenderConstants.h"
+#include "../rendering/ShadowMapper.h"
 #include "../systems/ProjectileSystem.h"
 #include "../systems/MissileSystem.h"
 #include "../ui/DeveloperOverlayUI.h"
@@ -495,7 +496,7 @@ namespace mecha
         // Play dash sound
         if (params && params->soundManager)
         {
-          params->soundManager->PlaySound3D("PLAYER_DASH", movement_.position);
+          params->soundManager->PlaySound3D(params->sounds.playerDash, movement_.position);
         }
       }
     }
@@ -669,11 +670,15 @@ namespace mecha
       glm::vec3 wheelRL = movement_.position - mechaForward * kMechaWheelbase + mechaRight * kMechaTrackWidth;
       glm::vec3 wheelRR = movement_.position - mechaForward * kMechaWheelbase - mechaRight * kMechaTrackWidth;
 
-      TerrainHeightSampler sampler = params ? params->terrainSampler : TerrainHeightSampler{};
-      float heightFL = sampler(wheelFL.x, wheelFL.z);
-      float heightFR = sampler(wheelFR.x, wheelFR.z);
-      float heightRL = sampler(wheelRL.x, wheelRL.z);
-      float heightRR = sampler(wheelRR.x, wheelRR.z);
+      static const HeightField kFlatGround{};
+      const HeightField &terrain = params ? params->terrain : kFlatGround;
+      const glm::vec3 wheels[4] = {wheelFL, wheelFR, wheelRL, wheelRR};
+      float wheelHeights[4];
+      terrain.SampleBatch(wheels, wheelHeights, 4);
+      float heightFL = wheelHeights[0];
+      float heightFR = wheelHeights[1];
+      float heightRL = wheelHeights[2];
+      float heightRR = wheelHeights[3];
 
       float frontHeight = (heightFL + heightFR) * 0.5f;
       float rearHeight = (heightRL + heightRR) * 0.5f;
@@ -784,7 +789,7 @@ namespace mecha
       if (isUsingThruster && !flightSoundHandle_)
       {
         // Start flight sound
-        flightSoundHandle_ = params->soundManager->PlaySound3D("PLAYER_FLIGHT", movement_.position);
+        flightSoundHandle_ = params->soundManager->PlaySound3D(params->sounds.playerFlight, movement_.position);
 
         // Stop walking sound when flying starts
         if (walkingSoundHandle_)
@@ -811,7 +816,7 @@ namespace mecha
         walkingSoundGraceTimer_ = 0.0f;
         if (!walkingSoundHandle_)
         {
-          walkingSoundHandle_ = params->soundManager->PlaySound3D("PLAYER_WALKING", movement_.position);
+          walkingSoundHandle_ = params->soundManager->PlaySound3D(params->sounds.playerWalking, movement_.position);
           // Increase playback speed for walking sound (1.5x = 50% faster)
           if (walkingSoundHandle_)
           {
@@ -911,7 +916,7 @@ namespace mecha
     // Play damage sound (throttled)
     if (playDamageSound && params && params->soundManager && damageSoundCooldown_ <= 0.0f)
     {
-      params->soundManager->PlaySound3D("PLAYER_DAMAGE", movement_.position);
+      params->soundManager->PlaySound3D(params->sounds.playerDamage, movement_.position);
       damageSoundCooldown_ = kPlayerDamageSoundCooldown;
     }
   }
@@ -990,7 +995,7 @@ namespace mecha
     const auto *params = static_cast<const UpdateParams *>(GetFramePayload());
     if (params && params->soundManager)
     {
-      params->soundManager->PlaySound3D("PLAYER_SHOOT", spawn);
+      params->soundManager->PlaySound3D(params->sounds.playerShoot, spawn);
     }
   }
 
@@ -1038,8 +1043,8 @@ namespace mecha
       glm::vec3 dirToEnemy = glm::normalize(toEnemy);
       float dotProduct = glm::dot(playerForward, dirToEnemy);
 
-      // If within cone and better aligned than current best target
-      if (dotProduct >= coneThreshold && dotProduct > bestAlignment)
+      // If within cone, not behind terrain and better aligned than current best target
+      if (dotProduct >= coneThreshold && dotProduct > bestAlignment && HasLaserLineOfSight(enemy))
       {
         bestAlignment = dotProduct;
         target = enemy;
@@ -1126,6 +1131,12 @@ namespace mecha
         return;
       }
 
+      if (ctx.shadowCascade >= 0 &&
+          !ShadowMapper::BoundsInLightVolume(ctx.lightSpaceMatrix, model, mechaModel_->GetBoundingMin(), mechaModel_->GetBoundingMax()))
+      {
+        return;
+      }
+
       ctx.overrideShader->setMat4("model", model);
       mechaModel_->Draw(*ctx.overrideShader);
       return;
@@ -1137,28 +1148,13 @@ namespace mecha
     }
 
     mechaShader_->use();
-    mechaShader_->setMat4("projection", ctx.projection);
-    mechaShader_->setMat4("view", ctx.view);
-    mechaShader_->setMat4("lightSpaceMatrix", ctx.lightSpaceMatrix);
-    mechaShader_->setVec3("viewPos", ctx.viewPos);
-    mechaShader_->setVec3("lightPos", ctx.lightPos);
-    mechaShader_->setVec3("lightIntensity", ctx.lightIntensity);
     mechaShader_->setBool("useBaseColor", false);
 
-    glActiveTexture(GL_TEXTURE0 + kShadowMapTextureUnit);
-    glBindTexture(GL_TEXTURE_2D, ctx.shadowMapTexture);
-    mechaShader_->setInt("shadowMap", kShadowMapTextureUnit);
-
-    bool useSSAO = ctx.ssaoEnabled && ctx.ssaoTexture != 0;
-    mechaShader_->setBool("useSSAO", useSSAO);
-    mechaShader_->setVec2("screenSize", ctx.screenSize);
-    mechaShader_->setFloat("aoStrength", ctx.ssaoStrength);
-    if (useSSAO)
+    if (ctx.shadowMapper)
     {
-      glActiveTexture(GL_TEXTURE0 + kSSAOTexUnit);
-      glBindTexture(GL_TEXTURE_2D, ctx.ssaoTexture);
-      mechaShader_->setInt("ssaoMap", kSSAOTexUnit);
+      ctx.shadowMapper->BindShadowMaps(*mechaShader_, kShadowMapTextureUnit);
     }
+
     mechaShader_->setMat4("model", model);
 
     mechaModel_->Draw(*mechaShader_);
@@ -1232,8 +1228,6 @@ namespace mecha
     if (melee_.showHitbox1)
     {
       colorShader_->use();
-      colorShader_->setMat4("projection", ctx.projection);
-      colorShader_->setMat4("view", ctx.view);
 
       glm::mat4 model = glm::mat4(1.0f);
       model = glm::translate(model, melee_.hitbox1Position);
@@ -1250,8 +1244,6 @@ namespace mecha
     if (melee_.showHitbox2)
     {
       colorShader_->use();
-      colorShader_->setMat4("projection", ctx.projection);
-      colorShader_->setMat4("view", ctx.view);
 
       glm::mat4 model = glm::mat4(1.0f);
       model = glm::translate(model, melee_.hitbox2Position);
@@ -1300,8 +1292,8 @@ namespace mecha
     const auto *params = static_cast<const UpdateParams *>(GetFramePayload());
     if (params && params->soundManager)
     {
-      params->soundManager->PlaySound3D("PLAYER_MELEE", movement_.position);
-      melee_.meleeSoundHandle_ = params->soundManager->PlaySound3D("PLAYER_MELEE_CONTINUE", movement_.position);
+      params->soundManager->PlaySound3D(params->sounds.playerMelee, movement_.position);
+      melee_.meleeSoundHandle_ = params->soundManager->PlaySound3D(params->sounds.playerMeleeContinue, movement_.position);
     }
 
     // Force action state change to ensure animation starts
@@ -1553,8 +1545,8 @@ namespace mecha
       glm::vec3 dirToEnemy = glm::normalize(toEnemy);
       float dotProduct = glm::dot(playerForward, dirToEnemy);
 
-      // If within cone and better aligned than current best target
-      if (dotProduct >= coneThreshold && dotProduct > bestAlignment)
+      // If within cone, not behind terrain and better aligned than current best target
+      if (dotProduct >= coneThreshold && dotProduct > bestAlignment && HasLaserLineOfSight(enemy))
       {
         bestAlignment = dotProduct;
         target = enemy;
@@ -1571,7 +1563,7 @@ namespace mecha
       const auto *params = static_cast<const UpdateParams *>(GetFramePayload());
       if (params && params->soundManager && !laserSoundHandle_)
       {
-        laserSoundHandle_ = params->soundManager->PlaySound3D("PLAYER_LASER", movement_.position);
+        laserSoundHandle_ = params->soundManager->PlaySound3D(params->sounds.playerLaser, movement_.position);
       }
     }
     else
@@ -1644,13 +1636,28 @@ namespace mecha
 
     // Re-check target validity and update if needed
     if (laserTarget_ && (!laserTarget_->IsAlive() ||
-                         glm::distance(movement_.position, laserTarget_->Position()) > LaserState::kLaserRange))
+                         glm::distance(movement_.position, laserTarget_->Position()) > LaserState::kLaserRange ||
+                         !HasLaserLineOfSight(laserTarget_)))
     {
       laser_.active = false;
       laserTarget_ = nullptr;
     }
   }
 
+  bool MechaPlayer::HasLaserLineOfSight(const Enemy *target) const
+  {
+    const auto *params = static_cast<const UpdateParams *>(GetFramePayload());
+    if (!params || !target)
+    {
+      return true;
+    }
+
+    // Same endpoints as the rendered beam
+    glm::vec3 beamStart = movement_.position + glm::vec3(0.0f, kSpawnHeightOffset, 0.0f);
+    glm::vec3 beamEnd = target->Position() + glm::vec3(0.0f, 1.0f, 0.0f);
+    return params->terrain.LineOfSight(beamStart, beamEnd);
+  }
+
   void MechaPlayer::RenderLaserBeam(const RenderContext &ctx)
   {
     if (ctx.shadowPass || !laser_.active || !laserTarget_ || !colorShader_ || laserBeamVAO_ == 0)
@@ -1746,8 +1753,6 @@ namespace mecha
 
     // Render laser beam
     colorShader_->use();
-    colorShader_->setMat4("projection", ctx.projection);
-    colorShader_->setMat4("view", ctx.view);
     colorShader_->setMat4("model", glm::mat4(1.0f));
     colorShader_->setVec4("color", glm::vec4(0.8f, 0.2f, 1.0f, 0.8f)); // Purple laser beam
 
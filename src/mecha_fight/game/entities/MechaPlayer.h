@@ -9,6 +9,7 @@ class Model;
 
 #include "../../core/Entity.h"
 #include "../GameplayTypes.h"
+#include "../audio/GameSounds.h"
 #include "../animation/AnimationController.h"
 
 namespace mecha
@@ -175,7 +176,7 @@ namespace mecha
     struct UpdateParams
     {
       DeveloperOverlayState *overlay{nullptr};
-      TerrainHeightSampler terrainSampler{};
+      HeightField terrain{};
       std::vector<ThrusterParticle> *thrusterParticles{nullptr};
       std::vector<DashParticle> *dashParticles{nullptr};
       std::vector<AfterimageParticle> *afterimageParticles{nullptr};
@@ -183,6 +184,7 @@ namespace mecha
       std::vector<class Enemy *> enemies; // All enemies for melee hit detection (unified)
       std::vector<ShockwaveParticle> *shockwaveParticles{nullptr};
       class SoundManager *soundManager{nullptr}; // Sound manager for playing sounds
+      GameSounds sounds{}; // Ids of the sounds played through soundManager
     };
 
     MechaPlayer();
@@ -248,6 +250,7 @@ namespace mecha
     void ProcessMeleeHitFrames();
     void RenderMeleeHitbox(const RenderContext &ctx);
     void RenderLaserBeam(const RenderContext &ctx);
+    bool HasLaserLineOfSight(const Enemy *target) const;
 
     MovementState movement_{};
     FlightState flight_{};
@@ -10,6 +10,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "../rendering/RenderConstants.h"
+#include "../rendering/ShadowMapper.h"
 #include "../GameplayTypes.h"
 #include "../audio/SoundManager.h"
 #include "../audio/SoundRegistry.h"
@@ -75,7 +76,7 @@ namespace mecha
       // Play gate collapsing sound
       if (params && params->soundManager)
       {
-        params->soundManager->PlaySound3D("GATE_COLLAPSE", transform_.position);
+        params->soundManager->PlaySound3D(params->sounds.gateCollapse, transform_.position);
       }
       
       std::cout << "[PortalGate] Gate destroyed at position (" 
@@ -123,7 +124,7 @@ namespace mecha
     if (alive_)
     {
       // Update position based on terrain height with offset
-      transform_.position.y = params->terrainSampler(transform_.position.x, transform_.position.z) + kHeightOffset;
+      transform_.position.y = params->terrain(transform_.position.x, transform_.position.z) + kHeightOffset;
     }
   }
 
@@ -156,8 +157,16 @@ namespace mecha
       {
         return;
       }
+      if (ctx.shadowCascade >= 0 &&
+          !ShadowMapper::BoundsInLightVolume(ctx.lightSpaceMatrix, model, model_->GetBoundingMin(), model_->GetBoundingMax()))
+      {
+        return;
+      }
+
+      // The cached static shadow layer outlives the current LOD, so bake it at full detail
+      const int shadowLod = ctx.shadowCasters == ShadowCasterSet::StaticOnly ? 0 : lod_.Level();
       ctx.overrideShader->setMat4("model", model);
-      model_->Draw(*ctx.overrideShader);
+      model_->Draw(*ctx.overrideShader, shadowLod);
       return;
     }
 
@@ -167,35 +176,22 @@ namespace mecha
     }
 
     shader_->use();
-    shader_->setMat4("projection", ctx.projection);
-    shader_->setMat4("view", ctx.view);
-    shader_->setMat4("lightSpaceMatrix", ctx.lightSpaceMatrix);
-    shader_->setVec3("viewPos", ctx.viewPos);
-    shader_->setVec3("lightPos", ctx.lightPos);
-    shader_->setVec3("lightIntensity", ctx.lightIntensity);
     shader_->setBool("useBaseColor", useBaseColor_);
     if (useBaseColor_)
     {
       shader_->setVec3("baseColor", baseColor_);
     }
 
-    glActiveTexture(GL_TEXTURE0 + kShadowMapTextureUnit);
-    glBindTexture(GL_TEXTURE_2D, ctx.shadowMapTexture);
-    shader_->setInt("shadowMap", kShadowMapTextureUnit);
-
-    bool useSSAO = ctx.ssaoEnabled && ctx.ssaoTexture != 0;
-    shader_->setBool("useSSAO", useSSAO);
-    shader_->setVec2("screenSize", ctx.screenSize);
-    shader_->setFloat("aoStrength", ctx.ssaoStrength);
-    if (useSSAO)
+    if (ctx.shadowMapper)
     {
-      glActiveTexture(GL_TEXTURE0 + kSSAOTexUnit);
-      glBindTexture(GL_TEXTURE_2D, ctx.ssaoTexture);
-      shader_->setInt("ssaoMap", kSSAOTexUnit);
+      ctx.shadowMapper->BindShadowMaps(*shader_, kShadowMapTextureUnit);
     }
 
+
+    lod_.Update(ctx.projection, ctx.viewPos, model, model_->GetBoundingMin(), model_->GetBoundingMax(),
+                model_->GetLodCount());
     shader_->setMat4("model", model);
-    model_->Draw(*shader_);
+    model_->Draw(*shader_, lod_.Level());
   }
 
   void PortalGate::SetRenderResources(Shader *shader, Model *model, bool useBaseColor, const glm::vec3 &baseColor)
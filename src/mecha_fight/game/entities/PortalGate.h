@@ -8,6 +8,8 @@ class Shader;
 #include "../../core/Entity.h"
 #include "Enemy.h"
 #include "../GameplayTypes.h"
+#include "../audio/GameSounds.h"
+#include "../rendering/LodSelector.h"
 
 namespace mecha
 {
@@ -16,9 +18,10 @@ namespace mecha
   public:
     struct UpdateParams
     {
-      TerrainHeightSampler terrainSampler{};
+      HeightField terrain{};
       std::vector<SparkParticle> *sparkParticles{nullptr};
       class SoundManager *soundManager{nullptr};
+      GameSounds sounds{};
     };
 
     PortalGate();
@@ -26,6 +29,7 @@ namespace mecha
 
     void Update(const UpdateContext &ctx) override;
     void Render(const RenderContext &ctx) override;
+    bool IsStaticShadowCaster() const override { return alive_; }
     void SetRenderResources(Shader *shader, Model *model, bool useBaseColor = false, const glm::vec3 &baseColor = glm::vec3(1.0f));
 
     bool IsAlive() const override;
@@ -48,6 +52,7 @@ namespace mecha
     glm::vec3 pivotOffset_{0.0f};
     Shader *shader_{nullptr};
     Model *model_{nullptr};
+    LodSelector lod_{};
     bool useBaseColor_{false};
     glm::vec3 baseColor_{1.0f};
   };
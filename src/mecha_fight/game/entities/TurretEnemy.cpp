@@ -11,6 +11,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "../rendering/RenderConstants.h"
+#include "../rendering/ShadowMapper.h"
 #include "MechaPlayer.h"
 #include "../GameplayTypes.h"
 #include "../audio/SoundManager.h"
@@ -26,6 +27,7 @@ namespace mecha
     constexpr float kMaxHP = 100.0f;
     constexpr float kRespawnDelay = 3.0f;
     constexpr float kAttackRange = 60.0f; // Range at which turret starts attacking (increased from 30.0f)
+    constexpr float kLineOfSightHeight = 1.0f; // Above turret base and player feet for visibility checks
     constexpr float kRotationSpeed = 90.0f; // Degrees per second
     constexpr float kDamagePerSecond = 20.0f; // Continuous damage rate
     constexpr float kDamageWindowStart = 0.70f; // 70% of animation
@@ -108,7 +110,7 @@ namespace mecha
       // Play death sound
       if (params && params->soundManager)
       {
-        params->soundManager->PlaySound3D("ENEMY_DEATH", transform_.position);
+        params->soundManager->PlaySound3D(params->sounds.enemyDeath, transform_.position);
       }
     }
   }
@@ -210,7 +212,16 @@ namespace mecha
     glm::vec3 toPlayer = params->player->Movement().position - transform_.position;
     float distance = glm::length(glm::vec2(toPlayer.x, toPlayer.z));
     
-    TurretState newState = (distance <= kAttackRange) ? TurretState::Attacking : TurretState::Idle;
+    bool canAttack = distance <= kAttackRange;
+    if (canAttack)
+    {
+      // Hold fire while the player is behind terrain
+      glm::vec3 eye = transform_.position + glm::vec3(0.0f, kLineOfSightHeight, 0.0f);
+      glm::vec3 playerCenter = params->player->Movement().position + glm::vec3(0.0f, kLineOfSightHeight, 0.0f);
+      canAttack = params->terrain.LineOfSight(eye, playerCenter);
+    }
+
+    TurretState newState = canAttack ? TurretState::Attacking : TurretState::Idle;
     
     if (newState != currentState_)
     {
@@ -301,7 +312,7 @@ namespace mecha
         // Start looping laser sound if not already playing
         if (params && params->soundManager && !laserSoundHandle_)
         {
-          laserSoundHandle_ = params->soundManager->PlaySound3D("ENEMY_TURRET_LASER", transform_.position);
+          laserSoundHandle_ = params->soundManager->PlaySound3D(params->sounds.enemyTurretLaser, transform_.position);
         }
         else if (params && params->soundManager && laserSoundHandle_)
         {
@@ -350,7 +361,7 @@ namespace mecha
     if (alive_)
     {
       // Update terrain height
-      transform_.position.y = params->terrainSampler(transform_.position.x, transform_.position.z) + kHeightOffset;
+      transform_.position.y = params->terrain(transform_.position.x, transform_.position.z) + kHeightOffset;
       
       // Update state based on player distance
       UpdateState(params);
@@ -398,8 +409,14 @@ namespace mecha
         return;
       }
 
+      if (ctx.shadowCascade >= 0 &&
+          !ShadowMapper::BoundsInLightVolume(ctx.lightSpaceMatrix, model, model_->GetBoundingMin(), model_->GetBoundingMax()))
+      {
+        return;
+      }
+
       ctx.overrideShader->setMat4("model", model);
-      model_->Draw(*ctx.overrideShader);
+      model_->Draw(*ctx.overrideShader, lod_.Level());
       return;
     }
 
@@ -409,35 +426,22 @@ namespace mecha
     }
 
     shader_->use();
-    shader_->setMat4("projection", ctx.projection);
-    shader_->setMat4("view", ctx.view);
-    shader_->setMat4("lightSpaceMatrix", ctx.lightSpaceMatrix);
-    shader_->setVec3("viewPos", ctx.viewPos);
-    shader_->setVec3("lightPos", ctx.lightPos);
-    shader_->setVec3("lightIntensity", ctx.lightIntensity);
     shader_->setBool("useBaseColor", useBaseColor_);
     if (useBaseColor_)
     {
       shader_->setVec3("baseColor", baseColor_);
     }
 
-    glActiveTexture(GL_TEXTURE0 + kShadowMapTextureUnit);
-    glBindTexture(GL_TEXTURE_2D, ctx.shadowMapTexture);
-    shader_->setInt("shadowMap", kShadowMapTextureUnit);
-
-    bool useSSAO = ctx.ssaoEnabled && ctx.ssaoTexture != 0;
-    shader_->setBool("useSSAO", useSSAO);
-    shader_->setVec2("screenSize", ctx.screenSize);
-    shader_->setFloat("aoStrength", ctx.ssaoStrength);
-    if (useSSAO)
+    if (ctx.shadowMapper)
     {
-      glActiveTexture(GL_TEXTURE0 + kSSAOTexUnit);
-      glBindTexture(GL_TEXTURE_2D, ctx.ssaoTexture);
-      shader_->setInt("ssaoMap", kSSAOTexUnit);
+      ctx.shadowMapper->BindShadowMaps(*shader_, kShadowMapTextureUnit);
     }
 
+
+    lod_.Update(ctx.projection, ctx.viewPos, model, model_->GetBoundingMin(), model_->GetBoundingMax(),
+                model_->GetLodCount());
     shader_->setMat4("model", model);
-    model_->Draw(*shader_);
+    model_->Draw(*shader_, lod_.Level());
     
     // Render laser beam when attacking and in damage window
     const auto *params = static_cast<const UpdateParams *>(GetFramePayload());
@@ -537,8 +541,6 @@ namespace mecha
     glEnable(GL_DEPTH_TEST); // Still test depth to avoid rendering through objects
     
     colorShader_->use();
-    colorShader_->setMat4("projection", ctx.projection);
-    colorShader_->setMat4("view", ctx.view);
     colorShader_->setMat4("model", glm::mat4(1.0f));
     colorShader_->setVec4("color", glm::vec4(0.0f, 1.0f, 0.3f, 0.7f)); // Bright green laser beam with reduced alpha
     
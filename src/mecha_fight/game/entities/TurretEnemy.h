@@ -8,6 +8,8 @@ class Shader;
 #include "../../core/Entity.h"
 #include "Enemy.h"
 #include "../GameplayTypes.h"
+#include "../audio/GameSounds.h"
+#include "../rendering/LodSelector.h"
 #include "../animation/AnimationController.h"
 
 namespace mecha
@@ -26,9 +28,10 @@ namespace mecha
     struct UpdateParams
     {
       const MechaPlayer *player{nullptr};
-      TerrainHeightSampler terrainSampler{};
+      HeightField terrain{};
       std::vector<SparkParticle> *sparkParticles{nullptr};
       class SoundManager *soundManager{nullptr};
+      GameSounds sounds{};
     };
 
     TurretEnemy();
@@ -68,6 +71,7 @@ namespace mecha
     glm::vec3 pivotOffset_{0.0f};
     Shader *shader_{nullptr};
     Model *model_{nullptr};
+    LodSelector lod_{};
     bool useBaseColor_{false};
     glm::vec3 baseColor_{1.0f};
     AnimationController animationController_{};
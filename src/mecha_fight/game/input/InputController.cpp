@@ -44,20 +44,22 @@ namespace mecha
 
   void InputController::SetupEntityParameters()
   {
+    // One view of the terrain shared by every entity's params this frame
+    m_heightField = m_deps.terrainConfig ? HeightField::FromConfig(*m_deps.terrainConfig) : HeightField{};
 
     // Setup player parameters
     if (m_deps.player)
     {
       m_playerParams = MechaPlayer::UpdateParams{};
       m_playerParams.overlay = m_deps.overlay;
-      m_playerParams.terrainSampler.callback = [this](float x, float z)
-      { return GetTerrainHeight(x, z); };
+      m_playerParams.terrain = m_heightField;
       m_playerParams.thrusterParticles = m_deps.thrusterParticles;
       m_playerParams.dashParticles = m_deps.dashParticles;
       m_playerParams.afterimageParticles = m_deps.afterimageParticles;
       m_playerParams.sparkParticles = m_deps.sparkParticles;
       m_playerParams.shockwaveParticles = m_deps.shockwaveParticles;
       m_playerParams.soundManager = m_deps.soundManager;
+      m_playerParams.sounds = m_deps.sounds;
       // Set all enemies for melee hit detection (unified vector)
       m_playerParams.enemies.clear();
       size_t extraSlots = m_deps.gates.size();
@@ -106,10 +108,10 @@ namespace mecha
       m_enemyParams = EnemyDrone::UpdateParams{};
       m_enemyParams.player = m_deps.player;
       m_enemyParams.projectiles = m_deps.projectileSystem.get();
-      m_enemyParams.terrainSampler.callback = [this](float x, float z)
-      { return GetTerrainHeight(x, z); };
+      m_enemyParams.terrain = m_heightField;
       m_enemyParams.sparkParticles = m_deps.sparkParticles;
       m_enemyParams.soundManager = m_deps.soundManager;
+      m_enemyParams.sounds = m_deps.sounds;
 
       bool paused = m_deps.overlay ? m_deps.overlay->animationPaused : false;
       // Apply slower animation speed for enemy drones (0.5x multiplier)
@@ -131,10 +133,10 @@ namespace mecha
     {
       m_turretParams = TurretEnemy::UpdateParams{};
       m_turretParams.player = m_deps.player;
-      m_turretParams.terrainSampler.callback = [this](float x, float z)
-      { return GetTerrainHeight(x, z); };
+      m_turretParams.terrain = m_heightField;
       m_turretParams.sparkParticles = m_deps.sparkParticles;
       m_turretParams.soundManager = m_deps.soundManager;
+      m_turretParams.sounds = m_deps.sounds;
 
       bool paused = m_deps.overlay ? m_deps.overlay->animationPaused : false;
       float speed = m_deps.overlay ? m_deps.overlay->animationSpeed * 1.0f : 1.0f;
@@ -153,10 +155,10 @@ namespace mecha
     if (!m_deps.gates.empty())
     {
       m_gateParams = PortalGate::UpdateParams{};
-      m_gateParams.terrainSampler.callback = [this](float x, float z)
-      { return GetTerrainHeight(x, z); };
+      m_gateParams.terrain = m_heightField;
       m_gateParams.sparkParticles = m_deps.sparkParticles;
       m_gateParams.soundManager = m_deps.soundManager;
+      m_gateParams.sounds = m_deps.sounds;
 
       for (const auto &gate : m_deps.gates)
       {
@@ -172,12 +174,12 @@ namespace mecha
     {
       m_godzillaParams = GodzillaEnemy::UpdateParams{};
       m_godzillaParams.player = m_deps.player;
-      m_godzillaParams.terrainSampler.callback = [this](float x, float z)
-      { return GetTerrainHeight(x, z); };
+      m_godzillaParams.terrain = m_heightField;
       m_godzillaParams.shockwaveParticles = m_deps.shockwaveParticles;
       m_godzillaParams.thrusterParticles = m_deps.thrusterParticles;
       m_godzillaParams.projectiles = m_deps.projectileSystem.get();
       m_godzillaParams.soundManager = m_deps.soundManager;
+      m_godzillaParams.sounds = m_deps.sounds;
       m_deps.godzilla->SetFramePayload(&m_godzillaParams);
     }
 
@@ -223,6 +225,7 @@ namespace mecha
       }
       m_projectileParams.overlay = m_deps.overlay;
       m_projectileParams.soundManager = m_deps.soundManager;
+      m_projectileParams.sounds = m_deps.sounds;
       m_deps.projectileSystem->SetFramePayload(&m_projectileParams);
     }
 
@@ -233,8 +236,7 @@ namespace mecha
       m_missileParams.player = m_deps.player;
       m_missileParams.thrusterParticles = m_deps.thrusterParticles;
       m_missileParams.shockwaveParticles = m_deps.shockwaveParticles;
-      m_missileParams.terrainSampler.callback = [this](float x, float z)
-      { return GetTerrainHeight(x, z); };
+      m_missileParams.terrain = m_heightField;
       // Add all enemies
       m_missileParams.enemies.clear();
       m_missileParams.enemies.reserve(m_deps.enemies.size() + m_deps.turrets.size() + m_deps.gates.size() + (m_deps.godzilla ? 1 : 0));
@@ -264,6 +266,7 @@ namespace mecha
         m_missileParams.enemies.push_back(static_cast<Enemy *>(m_deps.godzilla.get()));
       }
       m_missileParams.soundManager = m_deps.soundManager;
+      m_missileParams.sounds = m_deps.sounds;
       m_deps.missileSystem->SetFramePayload(&m_missileParams);
     }
 
@@ -380,13 +383,4 @@ namespace mecha
     }
   }
 
-  float InputController::GetTerrainHeight(float x, float z) const
-  {
-    if (m_deps.terrainConfig)
-    {
-      return SampleTerrainHeight(x, z, *m_deps.terrainConfig);
-    }
-    return 0.0f;
-  }
-
 } // namespace mecha
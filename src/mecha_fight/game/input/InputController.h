@@ -62,6 +62,7 @@ namespace mecha
 
       // Sound system
       class SoundManager *soundManager = nullptr;
+      GameSounds sounds{};
     };
 
     InputController();
@@ -89,11 +90,11 @@ namespace mecha
     GodzillaEnemy::UpdateParams m_godzillaParams;
     ProjectileSystem::UpdateParams m_projectileParams;
     MissileSystem::UpdateParams m_missileParams;
+    HeightField m_heightField;
 
     void SetupEntityParameters();
     void UpdateCamera(float deltaTime);
     void ApplyShockwaveRumble(float deltaTime);
-    float GetTerrainHeight(float x, float z) const;
   };
 
 } // namespace mecha
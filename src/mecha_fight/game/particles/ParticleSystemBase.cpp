@@ -26,8 +26,6 @@ namespace mecha
     glDepthMask(GL_FALSE);
 
     shader_->use();
-    shader_->setMat4("projection", ctx.projection);
-    shader_->setMat4("view", ctx.view);
 
     glBindVertexArray(sphereVAO_);
 
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include "TerrainPlaceholder.h"
+#include "HeightFieldRaycast.h"
+
+namespace mecha
+{
+
+  // Non-owning view of the terrain heightfield, small enough to copy into per-entity params.
+  // Sampling matches SampleTerrainHeight: bilinear with clamped edges over the baked grid, or the
+  // procedural surface when nothing is baked. A default-constructed view is flat ground at y = 0.
+  struct HeightField
+  {
+    const float *samples{nullptr};
+    int samplesX{0};
+    int samplesZ{0};
+    glm::vec2 origin{0.0f};
+    glm::vec2 invCellSize{1.0f};
+    float proceduralScale{0.0f};
+    float proceduralOffset{0.0f};
+    const TerrainConfig *config{nullptr}; // Source for ray queries; without it rays never hit
+
+    static HeightField FromConfig(const TerrainConfig &terrain)
+    {
+      HeightField view;
+      view.config = &terrain;
+      view.proceduralScale = terrain.heightScale;
+      view.proceduralOffset = terrain.yOffset;
+      if (terrain.heightFieldReady && terrain.samplesX > 1 && terrain.samplesZ > 1 && !terrain.heightSamples.empty())
+      {
+        view.samples = terrain.heightSamples.data();
+        view.samplesX = terrain.samplesX;
+        view.samplesZ = terrain.samplesZ;
+        view.origin = terrain.gridOrigin;
+        view.invCellSize = glm::vec2(1.0f / terrain.cellSize.x, 1.0f / terrain.cellSize.y);
+      }
+      return view;
+    }
+
+    bool IsBaked() const { return samples != nullptr; }
+
+    float Sample(float x, float z) const
+    {
+      return samples ? SampleBaked(x, z) : SampleProcedural(x, z);
+    }
+
+    float operator()(float x, float z) const { return Sample(x, z); }
+
+    // Samples count points in one pass; the baked/procedural branch is taken once for the batch
+    void SampleBatch(const float *xs, const float *zs, float *heights, size_t count) const
+    {
+      if (samples)
+      {
+        for (size_t i = 0; i < count; ++i)
+        {
+          heights[i] = SampleBaked(xs[i], zs[i]);
+        }
+      }
+      else
+      {
+        for (size_t i = 0; i < count; ++i)
+        {
+          heights[i] = SampleProcedural(xs[i], zs[i]);
+        }
+      }
+    }
+
+    // Batch form for world positions; y is ignored
+    void SampleBatch(const glm::vec3 *points, float *heights, size_t count) const
+    {
+      if (samples)
+      {
+        for (size_t i = 0; i < count; ++i)
+        {
+          heights[i] = SampleBaked(points[i].x, points[i].z);
+        }
+      }
+      else
+      {
+        for (size_t i = 0; i < count; ++i)
+        {
+          heights[i] = SampleProcedural(points[i].x, points[i].z);
+        }
+      }
+    }
+
+    bool Raycast(const glm::vec3 &rayOrigin, const glm::vec3 &dir, float maxDist, float &hitDistance) const
+    {
+      return config && RaycastTerrain(*config, rayOrigin, dir, maxDist, hitDistance);
+    }
+
+    bool LineOfSight(const glm::vec3 &from, const glm::vec3 &to) const
+    {
+      return !config || TerrainLineOfSight(*config, from, to);
+    }
+
+  private:
+    float SampleBaked(float x, float z) const
+    {
+      float gx = std::clamp((x - origin.x) * invCellSize.x, 0.0f, static_cast<float>(samplesX - 1));
+      float gz = std::clamp((z - origin.y) * invCellSize.y, 0.0f, static_cast<float>(samplesZ - 1));
+
+      int x0 = std::min(static_cast<int>(gx), samplesX - 2);
+      int z0 = std::min(static_cast<int>(gz), samplesZ - 2);
+      float tx = gx - static_cast<float>(x0);
+      float tz = gz - static_cast<float>(z0);
+
+      const float *row0 = samples + static_cast<size_t>(z0) * samplesX + x0;
+      const float *row1 = row0 + samplesX;
+      float h0 = row0[0] + (row0[1] - row0[0]) * tx;
+      float h1 = row1[0] + (row1[1] - row1[0]) * tx;
+      return h0 + (h1 - h0) * tz;
+    }
+
+    float SampleProcedural(float x, float z) const
+    {
+      return std::sin(x * 0.1f) * std::cos(z * 0.1f) * proceduralScale + proceduralOffset;
+    }
+  };
+
+} // namespace mecha
@@ -0,0 +1,171 @@
+#include "HeightFieldCache.h"
+#include "HeightFieldRaycast.h"
+#include "../core/CacheFile.h"
+#include "../core/MappedFile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace mecha
+{
+
+  namespace
+  {
+    constexpr char kCacheMagic[4] = {'M', 'H', 'F', 'C'};
+
+    struct CacheHeader
+    {
+      char magic[4];
+      uint32_t version;
+      uint64_t key;
+      int32_t samplesX;
+      int32_t samplesZ;
+      float gridOriginX;
+      float gridOriginZ;
+      float cellSizeX;
+      float cellSizeZ;
+    };
+
+    bool HashFile(uint64_t &hash, const std::filesystem::path &path)
+    {
+      std::ifstream file(path, std::ios::binary);
+      if (!file)
+      {
+        return false;
+      }
+      std::vector<char> buffer(1 << 16);
+      while (file)
+      {
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        hash = Fnv1a(hash, buffer.data(), static_cast<size_t>(file.gcount()));
+      }
+      return true;
+    }
+  } // namespace
+
+  uint64_t ComputeHeightFieldCacheKey(const std::string &modelPath, const TerrainConfig &config, int samplesX, int samplesZ)
+  {
+    namespace fs = std::filesystem;
+
+    uint64_t hash = Fnv1aValue(kFnv1aOffset, kHeightFieldCacheVersion);
+
+    // Geometry lives in the .gltf and its external buffers; textures do not affect heights
+    std::vector<fs::path> geometryFiles;
+    std::error_code ec;
+    const fs::path modelFile(modelPath);
+    for (const auto &entry : fs::directory_iterator(modelFile.parent_path(), ec))
+    {
+      if (!entry.is_regular_file(ec))
+      {
+        continue;
+      }
+      std::string ext = entry.path().extension().string();
+      std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c)
+                     { return static_cast<char>(std::tolower(c)); });
+      if (ext == ".gltf" || ext == ".glb" || ext == ".bin")
+      {
+        geometryFiles.push_back(entry.path());
+      }
+    }
+    if (geometryFiles.empty())
+    {
+      geometryFiles.push_back(modelFile);
+    }
+    std::sort(geometryFiles.begin(), geometryFiles.end());
+    for (const auto &path : geometryFiles)
+    {
+      const std::string name = path.filename().string();
+      hash = Fnv1a(hash, name.data(), name.size());
+      if (!HashFile(hash, path))
+      {
+        std::cerr << "[HeightFieldCache] Could not read " << path.string() << " for cache key" << std::endl;
+      }
+    }
+
+    hash = Fnv1aValue(hash, samplesX);
+    hash = Fnv1aValue(hash, samplesZ);
+    hash = Fnv1aValue(hash, config.modelScale);
+    hash = Fnv1aValue(hash, config.modelTranslation);
+    hash = Fnv1aValue(hash, config.boundsMin);
+    hash = Fnv1aValue(hash, config.boundsMax);
+    hash = Fnv1aValue(hash, config.defaultHeight);
+    return hash;
+  }
+
+  bool LoadHeightFieldCache(const std::string &cachePath, uint64_t key, TerrainConfig &config)
+  {
+    MappedFile file(cachePath);
+    if (!file.Data() || file.Size() < sizeof(CacheHeader))
+    {
+      return false;
+    }
+
+    CacheHeader header{};
+    std::memcpy(&header, file.Data(), sizeof(CacheHeader));
+    if (std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) != 0 ||
+        header.version != kHeightFieldCacheVersion || header.key != key)
+    {
+      std::cout << "[HeightFieldCache] Stale cache " << cachePath << ", rebuilding" << std::endl;
+      return false;
+    }
+    if (header.samplesX < 2 || header.samplesZ < 2)
+    {
+      return false;
+    }
+
+    const size_t sampleCount = static_cast<size_t>(header.samplesX) * static_cast<size_t>(header.samplesZ);
+    if (file.Size() != sizeof(CacheHeader) + sampleCount * sizeof(float))
+    {
+      std::cerr << "[HeightFieldCache] Truncated cache " << cachePath << ", rebuilding" << std::endl;
+      return false;
+    }
+
+    config.samplesX = header.samplesX;
+    config.samplesZ = header.samplesZ;
+    config.gridOrigin = glm::vec2(header.gridOriginX, header.gridOriginZ);
+    config.cellSize = glm::vec2(header.cellSizeX, header.cellSizeZ);
+    config.heightSamples.resize(sampleCount);
+    std::memcpy(config.heightSamples.data(), file.Data() + sizeof(CacheHeader), sampleCount * sizeof(float));
+    config.heightFieldReady = true;
+    BuildHeightFieldMinMax(config);
+
+    std::cout << "[HeightFieldCache] Loaded " << header.samplesX << "x" << header.samplesZ << " heightfield from " << cachePath << std::endl;
+    return true;
+  }
+
+  bool SaveHeightFieldCache(const std::string &cachePath, uint64_t key, const TerrainConfig &config)
+  {
+    if (!config.heightFieldReady || config.heightSamples.size() != static_cast<size_t>(config.samplesX) * static_cast<size_t>(config.samplesZ))
+    {
+      return false;
+    }
+
+    CacheHeader header{};
+    std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+    header.version = kHeightFieldCacheVersion;
+    header.key = key;
+    header.samplesX = config.samplesX;
+    header.samplesZ = config.samplesZ;
+    header.gridOriginX = config.gridOrigin.x;
+    header.gridOriginZ = config.gridOrigin.y;
+    header.cellSizeX = config.cellSize.x;
+    header.cellSizeZ = config.cellSize.y;
+
+    const size_t sampleBytes = config.heightSamples.size() * sizeof(float);
+    std::string error;
+    if (!WriteFileAtomically(cachePath, {{&header, sizeof(header)}, {config.heightSamples.data(), sampleBytes}}, error))
+    {
+      std::cerr << "[HeightFieldCache] Could not save " << cachePath << ": " << error << std::endl;
+      return false;
+    }
+
+    std::cout << "[HeightFieldCache] Saved heightfield to " << cachePath << std::endl;
+    return true;
+  }
+
+} // namespace mecha
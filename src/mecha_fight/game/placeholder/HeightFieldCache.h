@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "TerrainPlaceholder.h"
+
+namespace mecha
+{
+
+  // Bump whenever BuildHeightFieldFromModel output or the cache layout changes.
+  inline constexpr uint32_t kHeightFieldCacheVersion = 2;
+
+  // Key identifying a baked heightfield: hash of the model's geometry files (.gltf/.glb/.bin
+  // next to modelPath) plus every TerrainConfig input BuildHeightFieldFromModel reads.
+  uint64_t ComputeHeightFieldCacheKey(const std::string &modelPath, const TerrainConfig &config, int samplesX, int samplesZ);
+
+  // Memory-maps a cache file and copies the samples into config when version, key and size match.
+  // Returns false (config untouched) when the cache is missing or stale so the caller rebuilds.
+  bool LoadHeightFieldCache(const std::string &cachePath, uint64_t key, TerrainConfig &config);
+
+  // Writes config's heightfield to cachePath, creating parent directories as needed.
+  bool SaveHeightFieldCache(const std::string &cachePath, uint64_t key, const TerrainConfig &config);
+
+} // namespace mecha
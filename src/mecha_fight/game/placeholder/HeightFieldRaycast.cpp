@@ -0,0 +1,372 @@
+#include "HeightFieldRaycast.h"
+#include "TerrainPlaceholder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <glm/geometric.hpp>
+
+namespace mecha
+{
+
+  namespace
+  {
+    // Step used to ray-march the procedural surface when no heightfield is baked
+    constexpr float kFallbackMarchStep = 0.25f;
+    // Pending pyramid nodes: each level leaves at most 3 siblings behind the child being descended
+    constexpr int kMaxTraversalStack = 3 * 32 + 1;
+
+    // Ray with x/z in grid cells and y in world units; the parameter t is world distance
+    struct GridRay
+    {
+      glm::vec3 origin;
+      glm::vec3 dir;
+    };
+
+    struct PendingNode
+    {
+      int level;
+      int x;
+      int z;
+      float tEnter;
+    };
+
+    // Height bounds of a pyramid node; level 0 is a single grid cell read straight from the samples
+    void NodeBounds(const TerrainConfig &config, int level, int x, int z, float &minHeight, float &maxHeight)
+    {
+      if (level == 0)
+      {
+        const float *row0 = config.heightSamples.data() + static_cast<size_t>(z) * config.samplesX + x;
+        const float *row1 = row0 + config.samplesX;
+        minHeight = std::min(std::min(row0[0], row0[1]), std::min(row1[0], row1[1]));
+        maxHeight = std::max(std::max(row0[0], row0[1]), std::max(row1[0], row1[1]));
+        return;
+      }
+
+      const HeightFieldMinMaxLevel &pyramidLevel = config.minMaxLevels[level - 1];
+      const size_t idx = static_cast<size_t>(z) * pyramidLevel.width + x;
+      minHeight = pyramidLevel.minHeights[idx];
+      maxHeight = pyramidLevel.maxHeights[idx];
+    }
+
+    // Slab test against [boxMin, boxMax] clipped to [tMin, tMax]
+    bool IntersectBox(const GridRay &ray, const glm::vec3 &boxMin, const glm::vec3 &boxMax, float tMin, float tMax,
+                      float &tEnter)
+    {
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        const float o = ray.origin[axis];
+        const float d = ray.dir[axis];
+        if (std::abs(d) < 1e-8f)
+        {
+          if (o < boxMin[axis] || o > boxMax[axis])
+          {
+            return false;
+          }
+          continue;
+        }
+
+        const float invD = 1.0f / d;
+        float t0 = (boxMin[axis] - o) * invD;
+        float t1 = (boxMax[axis] - o) * invD;
+        if (t0 > t1)
+        {
+          std::swap(t0, t1);
+        }
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+        if (tMin > tMax)
+        {
+          return false;
+        }
+      }
+
+      tEnter = tMin;
+      return true;
+    }
+
+    // Smallest t in [tEnter, tExit] where the ray reaches the bilinear patch of cell (cx, cz).
+    // Along the ray the patch height is quadratic in t, so the crossing is solved in closed form.
+    bool IntersectCell(const TerrainConfig &config, const GridRay &ray, int cx, int cz, float tEnter, float tExit,
+                       float &hitT)
+    {
+      const float *row0 = config.heightSamples.data() + static_cast<size_t>(cz) * config.samplesX + cx;
+      const float *row1 = row0 + config.samplesX;
+      const float h00 = row0[0];
+      const float h10 = row0[1];
+      const float h01 = row1[0];
+      const float h11 = row1[1];
+      const float b = h10 - h00;
+      const float c = h01 - h00;
+      const float e = h00 - h10 - h01 + h11;
+
+      // Re-origin at the cell entry so u, v stay in [0, 1]
+      const float u0 = ray.origin.x + ray.dir.x * tEnter - static_cast<float>(cx);
+      const float v0 = ray.origin.z + ray.dir.z * tEnter - static_cast<float>(cz);
+      const float y0 = ray.origin.y + ray.dir.y * tEnter;
+      const float du = ray.dir.x;
+      const float dv = ray.dir.z;
+
+      // f(s) = ray height - surface height at t = tEnter + s
+      const float qa = -e * du * dv;
+      const float qb = ray.dir.y - b * du - c * dv - e * (u0 * dv + v0 * du);
+      const float qc = y0 - (h00 + b * u0 + c * v0 + e * u0 * v0);
+
+      if (qc <= 0.0f)
+      {
+        hitT = tEnter;
+        return true;
+      }
+
+      float s = 0.0f;
+      if (std::abs(qa) < 1e-12f)
+      {
+        if (qb >= 0.0f)
+        {
+          return false;
+        }
+        s = -qc / qb;
+      }
+      else
+      {
+        const float disc = qb * qb - 4.0f * qa * qc;
+        if (disc < 0.0f)
+        {
+          return false;
+        }
+        const float q = -0.5f * (qb + std::copysign(std::sqrt(disc), qb));
+        float r0 = q / qa;
+        float r1 = qc / q;
+        if (r0 > r1)
+        {
+          std::swap(r0, r1);
+        }
+        s = (r0 >= 0.0f) ? r0 : r1;
+        if (s < 0.0f)
+        {
+          return false;
+        }
+      }
+
+      if (s > tExit - tEnter)
+      {
+        return false;
+      }
+      hitT = tEnter + s;
+      return true;
+    }
+
+    bool MarchProceduralSurface(const TerrainConfig &config, const glm::vec3 &origin, const glm::vec3 &dir,
+                                float maxDist, float &hitDistance)
+    {
+      for (float t = 0.0f;; t += kFallbackMarchStep)
+      {
+        t = std::min(t, maxDist);
+        glm::vec3 p = origin + dir * t;
+        if (p.y <= SampleTerrainHeight(p.x, p.z, config))
+        {
+          hitDistance = t;
+          return true;
+        }
+        if (t >= maxDist)
+        {
+          return false;
+        }
+      }
+    }
+  } // namespace
+
+  void BuildHeightFieldMinMax(TerrainConfig &config)
+  {
+    config.minMaxLevels.clear();
+    if (!config.heightFieldReady || config.samplesX < 2 || config.samplesZ < 2 ||
+        config.heightSamples.size() != static_cast<size_t>(config.samplesX) * static_cast<size_t>(config.samplesZ))
+    {
+      return;
+    }
+
+    int childWidth = config.samplesX - 1;
+    int childHeight = config.samplesZ - 1;
+    int level = 0;
+    while (childWidth > 1 || childHeight > 1)
+    {
+      HeightFieldMinMaxLevel next;
+      next.width = (childWidth + 1) / 2;
+      next.height = (childHeight + 1) / 2;
+      next.minHeights.resize(static_cast<size_t>(next.width) * next.height);
+      next.maxHeights.resize(next.minHeights.size());
+
+      for (int z = 0; z < next.height; ++z)
+      {
+        for (int x = 0; x < next.width; ++x)
+        {
+          float minHeight = std::numeric_limits<float>::max();
+          float maxHeight = std::numeric_limits<float>::lowest();
+          for (int cz = 2 * z; cz < std::min(2 * z + 2, childHeight); ++cz)
+          {
+            for (int cx = 2 * x; cx < std::min(2 * x + 2, childWidth); ++cx)
+            {
+              float childMin = 0.0f;
+              float childMax = 0.0f;
+              NodeBounds(config, level, cx, cz, childMin, childMax);
+              minHeight = std::min(minHeight, childMin);
+              maxHeight = std::max(maxHeight, childMax);
+            }
+          }
+          const size_t idx = static_cast<size_t>(z) * next.width + x;
+          next.minHeights[idx] = minHeight;
+          next.maxHeights[idx] = maxHeight;
+        }
+      }
+
+      childWidth = next.width;
+      childHeight = next.height;
+      config.minMaxLevels.push_back(std::move(next));
+      ++level;
+    }
+  }
+
+  bool RaycastTerrain(const TerrainConfig &config, const glm::vec3 &origin, const glm::vec3 &dir, float maxDist,
+                      float &hitDistance)
+  {
+    const float dirLength = glm::length(dir);
+    if (dirLength < 1e-6f || maxDist < 0.0f)
+    {
+      return false;
+    }
+    const glm::vec3 rayDir = dir / dirLength;
+
+    const int cellsX = config.samplesX - 1;
+    const int cellsZ = config.samplesZ - 1;
+    const bool pyramidReady = config.heightFieldReady && cellsX > 0 && cellsZ > 0 &&
+                              (!config.minMaxLevels.empty() || (cellsX == 1 && cellsZ == 1));
+    if (!pyramidReady)
+    {
+      return MarchProceduralSurface(config, origin, rayDir, maxDist, hitDistance);
+    }
+
+    GridRay ray;
+    ray.origin = glm::vec3((origin.x - config.gridOrigin.x) / config.cellSize.x, origin.y,
+                           (origin.z - config.gridOrigin.y) / config.cellSize.y);
+    ray.dir = glm::vec3(rayDir.x / config.cellSize.x, rayDir.y, rayDir.z / config.cellSize.y);
+
+    // The terrain is solid below the surface, so a node's box extends downward without limit
+    const float kBelowAll = std::numeric_limits<float>::lowest();
+    auto nodeBox = [&](int level, int x, int z, float maxHeight, glm::vec3 &boxMin, glm::vec3 &boxMax)
+    {
+      const int span = 1 << level;
+      boxMin = glm::vec3(static_cast<float>(x * span), kBelowAll, static_cast<float>(z * span));
+      boxMax = glm::vec3(static_cast<float>(std::min((x + 1) * span, cellsX)), maxHeight,
+                         static_cast<float>(std::min((z + 1) * span, cellsZ)));
+    };
+
+    PendingNode stack[kMaxTraversalStack];
+    int stackSize = 0;
+    float bestT = maxDist;
+    bool hit = false;
+
+    const int topLevel = static_cast<int>(config.minMaxLevels.size());
+    {
+      float minHeight = 0.0f;
+      float maxHeight = 0.0f;
+      NodeBounds(config, topLevel, 0, 0, minHeight, maxHeight);
+      glm::vec3 boxMin, boxMax;
+      nodeBox(topLevel, 0, 0, maxHeight, boxMin, boxMax);
+      float tEnter = 0.0f;
+      if (IntersectBox(ray, boxMin, boxMax, 0.0f, bestT, tEnter))
+      {
+        stack[stackSize++] = PendingNode{topLevel, 0, 0, tEnter};
+      }
+    }
+
+    while (stackSize > 0)
+    {
+      const PendingNode node = stack[--stackSize];
+      if (node.tEnter > bestT)
+      {
+        continue;
+      }
+
+      float minHeight = 0.0f;
+      float maxHeight = 0.0f;
+      NodeBounds(config, node.level, node.x, node.z, minHeight, maxHeight);
+
+      // Entering a node below its lowest sample means the ray is already inside the terrain
+      if (ray.origin.y + ray.dir.y * node.tEnter <= minHeight)
+      {
+        bestT = node.tEnter;
+        hit = true;
+        continue;
+      }
+
+      if (node.level == 0)
+      {
+        glm::vec3 boxMin, boxMax;
+        nodeBox(0, node.x, node.z, maxHeight, boxMin, boxMax);
+        float tExit = bestT;
+        for (int axis = 0; axis < 3; axis += 2)
+        {
+          if (std::abs(ray.dir[axis]) >= 1e-8f)
+          {
+            float bound = (ray.dir[axis] > 0.0f) ? boxMax[axis] : boxMin[axis];
+            tExit = std::min(tExit, (bound - ray.origin[axis]) / ray.dir[axis]);
+          }
+        }
+        float cellT = 0.0f;
+        if (IntersectCell(config, ray, node.x, node.z, node.tEnter, tExit, cellT) && cellT <= bestT)
+        {
+          bestT = cellT;
+          hit = true;
+        }
+        continue;
+      }
+
+      // Queue the children that the ray can still reach, nearest on top of the stack
+      const int childLevel = node.level - 1;
+      const int childSpan = 1 << childLevel;
+      PendingNode children[4];
+      int childCount = 0;
+      for (int dz = 0; dz < 2; ++dz)
+      {
+        for (int dx = 0; dx < 2; ++dx)
+        {
+          const int cx = node.x * 2 + dx;
+          const int cz = node.z * 2 + dz;
+          if (cx * childSpan >= cellsX || cz * childSpan >= cellsZ)
+          {
+            continue;
+          }
+          float childMin = 0.0f;
+          float childMax = 0.0f;
+          NodeBounds(config, childLevel, cx, cz, childMin, childMax);
+          glm::vec3 boxMin, boxMax;
+          nodeBox(childLevel, cx, cz, childMax, boxMin, boxMax);
+          float tEnter = 0.0f;
+          if (IntersectBox(ray, boxMin, boxMax, 0.0f, bestT, tEnter))
+          {
+            children[childCount++] = PendingNode{childLevel, cx, cz, tEnter};
+          }
+        }
+      }
+      std::sort(children, children + childCount, [](const PendingNode &a, const PendingNode &b)
+                { return a.tEnter > b.tEnter; });
+      for (int i = 0; i < childCount; ++i)
+      {
+        stack[stackSize++] = children[i];
+      }
+    }
+
+    if (hit)
+    {
+      hitDistance = bestT;
+    }
+    return hit;
+  }
+
+  bool TerrainLineOfSight(const TerrainConfig &config, const glm::vec3 &from, const glm::vec3 &to)
+  {
+    float hitDistance = 0.0f;
+    return !RaycastTerrain(config, from, to - from, glm::length(to - from), hitDistance);
+  }
+
+} // namespace mecha
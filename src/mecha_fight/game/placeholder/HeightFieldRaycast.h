@@ -0,0 +1,25 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+
+namespace mecha
+{
+
+  struct TerrainConfig;
+
+  // Rebuilds config.minMaxLevels from config.heightSamples. Level 0 bounds each grid cell
+  // by its four corner samples; every further level halves the grid until one node remains.
+  void BuildHeightFieldMinMax(TerrainConfig &config);
+
+  // Casts a ray against the terrain surface, descending the min/max pyramid to skip cells the
+  // ray passes over and solving the bilinear patch exactly in the cells it reaches.
+  // dir need not be normalised; hitDistance is measured along normalize(dir) and is 0 when the
+  // origin already lies below the surface. Rays are only tested over the heightfield footprint.
+  // Without a baked heightfield the procedural surface is ray-marched instead.
+  bool RaycastTerrain(const TerrainConfig &config, const glm::vec3 &origin, const glm::vec3 &dir, float maxDist,
+                      float &hitDistance);
+
+  // True when the segment from -> to does not pass below the terrain surface.
+  bool TerrainLineOfSight(const TerrainConfig &config, const glm::vec3 &from, const glm::vec3 &to);
+
+} // namespace mecha
@@ -1,9 +1,14 @@
 #include "TerrainPlaceholder.h"
+#include "HeightField.h"
+#include "HeightFieldRaycast.h"
 
 #include <vector>
 #include <cmath>
 #include <cfloat>
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
 #include <glm/common.hpp>
 #include <learnopengl/model.h>
 #include <learnopengl/mesh.h>
@@ -11,6 +16,189 @@
 namespace mecha
 {
 
+  namespace
+  {
+    // Grid cells per side of a rasterisation tile; each tile is written by one worker
+    constexpr int kHeightFieldTileSize = 64;
+    // Frontier cells averaged per job during hole filling
+    constexpr size_t kHoleFillBatchSize = 4096;
+
+    struct RasterTriangle
+    {
+      glm::vec3 p0, p1, p2; // world space
+      glm::vec2 g0, g1, g2; // grid space
+      int minX, maxX, minZ, maxZ;
+    };
+
+    // Runs fn(i) for i in [0, jobCount) on up to workerCount threads (the caller included)
+    template <typename Fn>
+    void ParallelFor(size_t jobCount, unsigned int workerCount, Fn &&fn)
+    {
+      const unsigned int threadCount = static_cast<unsigned int>(std::min<size_t>(workerCount, jobCount));
+      if (threadCount <= 1)
+      {
+        for (size_t i = 0; i < jobCount; ++i)
+        {
+          fn(i);
+        }
+        return;
+      }
+
+      std::atomic<size_t> nextJob{0};
+      auto worker = [&]()
+      {
+        for (size_t i = nextJob.fetch_add(1); i < jobCount; i = nextJob.fetch_add(1))
+        {
+          fn(i);
+        }
+      };
+
+      std::vector<std::thread> threads;
+      threads.reserve(threadCount - 1);
+      for (unsigned int t = 1; t < threadCount; ++t)
+      {
+        threads.emplace_back(worker);
+      }
+      worker();
+      for (auto &thread : threads)
+      {
+        thread.join();
+      }
+    }
+
+    bool PointInsideTriangle(const glm::vec2 &p, const glm::vec2 &a, const glm::vec2 &b, const glm::vec2 &c)
+    {
+      auto edge = [](const glm::vec2 &u, const glm::vec2 &v, const glm::vec2 &w)
+      {
+        return (w.x - u.x) * (v.y - u.y) - (w.y - u.y) * (v.x - u.x);
+      };
+      bool b1 = edge(p, a, b) >= 0.0f;
+      bool b2 = edge(p, b, c) >= 0.0f;
+      bool b3 = edge(p, c, a) >= 0.0f;
+      return (b1 == b2) && (b2 == b3);
+    }
+
+    float SamplePlaneHeight(const glm::vec3 &p0, const glm::vec3 &p1, const glm::vec3 &p2, float x, float z)
+    {
+      glm::vec3 v0 = p1 - p0;
+      glm::vec3 v1 = p2 - p0;
+      glm::vec3 normal = glm::cross(v0, v1);
+      float denom = normal.y;
+      if (std::abs(denom) < 1e-6f)
+      {
+        return p0.y;
+      }
+      float d = glm::dot(normal, p0);
+      return (d - normal.x * x - normal.z * z) / denom;
+    }
+
+    // Fill cells the mesh did not cover (e.g., outside its footprint) by dilating inward:
+    // each pass gives every empty cell bordering a filled one the average of its filled
+    // neighbours. Passes read only the previous state, so any worker count gives the same grid.
+    void FillHeightFieldHoles(TerrainConfig &config, unsigned int workerCount)
+    {
+      const int samplesX = config.samplesX;
+      const int samplesZ = config.samplesZ;
+      const size_t cellCount = config.heightSamples.size();
+      float *heights = config.heightSamples.data();
+
+      std::vector<uint8_t> filled(cellCount);
+      for (size_t i = 0; i < cellCount; ++i)
+      {
+        filled[i] = heights[i] != config.defaultHeight ? 1 : 0;
+      }
+
+      std::vector<uint8_t> queued(cellCount, 0);
+      std::vector<size_t> frontier;
+      auto enqueueEmptyNeighbours = [&](int x, int z)
+      {
+        for (int dz = -1; dz <= 1; ++dz)
+        {
+          for (int dx = -1; dx <= 1; ++dx)
+          {
+            int sx = x + dx;
+            int sz = z + dz;
+            if ((dx == 0 && dz == 0) || sx < 0 || sx >= samplesX || sz < 0 || sz >= samplesZ)
+            {
+              continue;
+            }
+            size_t neighbourIdx = static_cast<size_t>(sz) * samplesX + sx;
+            if (!filled[neighbourIdx] && !queued[neighbourIdx])
+            {
+              queued[neighbourIdx] = 1;
+              frontier.push_back(neighbourIdx);
+            }
+          }
+        }
+      };
+
+      for (int z = 0; z < samplesZ; ++z)
+      {
+        for (int x = 0; x < samplesX; ++x)
+        {
+          if (filled[static_cast<size_t>(z) * samplesX + x])
+          {
+            enqueueEmptyNeighbours(x, z);
+          }
+        }
+      }
+
+      std::vector<float> values;
+      while (!frontier.empty())
+      {
+        // Cells in the frontier are kept in discovery order so the commit below is deterministic
+        std::sort(frontier.begin(), frontier.end());
+        values.assign(frontier.size(), config.defaultHeight);
+        const size_t batchCount = (frontier.size() + kHoleFillBatchSize - 1) / kHoleFillBatchSize;
+        ParallelFor(batchCount, workerCount, [&](size_t batch)
+                    {
+          const size_t begin = batch * kHoleFillBatchSize;
+          const size_t end = std::min(begin + kHoleFillBatchSize, frontier.size());
+          for (size_t i = begin; i < end; ++i)
+          {
+            const int x = static_cast<int>(frontier[i] % samplesX);
+            const int z = static_cast<int>(frontier[i] / samplesX);
+            float accum = 0.0f;
+            int count = 0;
+            for (int dz = -1; dz <= 1; ++dz)
+            {
+              for (int dx = -1; dx <= 1; ++dx)
+              {
+                int sx = x + dx;
+                int sz = z + dz;
+                if ((dx == 0 && dz == 0) || sx < 0 || sx >= samplesX || sz < 0 || sz >= samplesZ)
+                {
+                  continue;
+                }
+                size_t neighbourIdx = static_cast<size_t>(sz) * samplesX + sx;
+                if (filled[neighbourIdx])
+                {
+                  accum += heights[neighbourIdx];
+                  ++count;
+                }
+              }
+            }
+            if (count > 0)
+            {
+              values[i] = accum / static_cast<float>(count);
+            }
+          } });
+
+        std::vector<size_t> committed;
+        committed.swap(frontier);
+        for (size_t i = 0; i < committed.size(); ++i)
+        {
+          heights[committed[i]] = values[i];
+          filled[committed[i]] = 1;
+        }
+        for (size_t idx : committed)
+        {
+          enqueueEmptyNeighbours(static_cast<int>(idx % samplesX), static_cast<int>(idx / samplesX));
+        }
+      }
+    }
+  } // namespace
+
   TerrainMeshHandle CreateTerrainPlaceholder(const TerrainConfig &config)
   {
     TerrainMeshHandle handle{};
@@ -110,40 +298,11 @@ namespace mecha
 
   float SampleTerrainHeight(float worldX, float worldZ, const TerrainConfig &config)
   {
-    if (config.heightFieldReady && config.samplesX > 1 && config.samplesZ > 1 && !config.heightSamples.empty())
-    {
-      float normalizedX = (worldX - config.gridOrigin.x) / config.cellSize.x;
-      float normalizedZ = (worldZ - config.gridOrigin.y) / config.cellSize.y;
-      normalizedX = glm::clamp(normalizedX, 0.0f, static_cast<float>(config.samplesX - 1));
-      normalizedZ = glm::clamp(normalizedZ, 0.0f, static_cast<float>(config.samplesZ - 1));
-
-      int x0 = static_cast<int>(std::floor(normalizedX));
-      int z0 = static_cast<int>(std::floor(normalizedZ));
-      int x1 = std::min(x0 + 1, config.samplesX - 1);
-      int z1 = std::min(z0 + 1, config.samplesZ - 1);
-      float tx = normalizedX - static_cast<float>(x0);
-      float tz = normalizedZ - static_cast<float>(z0);
-
-      auto sample = [&](int sx, int sz)
-      {
-        return config.heightSamples[sz * config.samplesX + sx];
-      };
-
-      float h00 = sample(x0, z0);
-      float h10 = sample(x1, z0);
-      float h01 = sample(x0, z1);
-      float h11 = sample(x1, z1);
-      float h0 = glm::mix(h00, h10, tx);
-      float h1 = glm::mix(h01, h11, tx);
-      return glm::mix(h0, h1, tz);
-    }
-
-    // Fallback to procedural surface if no heightfield exists (legacy behavior)
-    float height = std::sin(worldX * 0.1f) * std::cos(worldZ * 0.1f) * config.heightScale;
-    return height + config.yOffset;
+    return HeightField::FromConfig(config).Sample(worldX, worldZ);
   }
 
-  void BuildHeightFieldFromModel(const Model &model, TerrainConfig &config, int samplesX, int samplesZ)
+
+  void BuildHeightFieldFromModel(const Model &model, TerrainConfig &config, int samplesX, int samplesZ, unsigned int workerCount)
   {
     if (samplesX < 2 || samplesZ < 2)
     {
@@ -151,9 +310,14 @@ namespace mecha
       return;
     }
 
+    if (workerCount == 0)
+    {
+      workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
     config.samplesX = samplesX;
     config.samplesZ = samplesZ;
-    config.heightSamples.assign(samplesX * samplesZ, config.defaultHeight);
+    config.heightSamples.assign(static_cast<size_t>(samplesX) * static_cast<size_t>(samplesZ), config.defaultHeight);
 
     config.gridOrigin = glm::vec2(config.boundsMin.x, config.boundsMin.z);
     glm::vec2 totalSize = glm::vec2(config.boundsMax.x - config.boundsMin.x, config.boundsMax.z - config.boundsMin.z);
@@ -175,126 +339,94 @@ namespace mecha
       return glm::vec2(fx, fz);
     };
 
-    auto pointInsideTriangle = [](const glm::vec2 &p, const glm::vec2 &a, const glm::vec2 &b, const glm::vec2 &c)
-    {
-      auto edge = [](const glm::vec2 &u, const glm::vec2 &v, const glm::vec2 &w)
-      {
-        return (w.x - u.x) * (v.y - u.y) - (w.y - u.y) * (v.x - u.x);
-      };
-      bool b1 = edge(p, a, b) >= 0.0f;
-      bool b2 = edge(p, b, c) >= 0.0f;
-      bool b3 = edge(p, c, a) >= 0.0f;
-      return (b1 == b2) && (b2 == b3);
-    };
-
-    auto samplePlaneHeight = [](const glm::vec3 &p0, const glm::vec3 &p1, const glm::vec3 &p2, float x, float z)
-    {
-      glm::vec3 v0 = p1 - p0;
-      glm::vec3 v1 = p2 - p0;
-      glm::vec3 normal = glm::cross(v0, v1);
-      float denom = normal.y;
-      if (std::abs(denom) < 1e-6f)
-      {
-        return p0.y;
-      }
-      float d = glm::dot(normal, p0);
-      return (d - normal.x * x - normal.z * z) / denom;
-    };
-
-    auto updateCell = [&](int gx, int gz, float height)
-    {
-      if (gx < 0 || gx >= samplesX || gz < 0 || gz >= samplesZ)
-      {
-        return;
-      }
-      int idx = gz * samplesX + gx;
-      config.heightSamples[idx] = std::max(config.heightSamples[idx], height);
-    };
+    // Transform every triangle once and bin it into the tiles its grid footprint touches
+    const int tilesX = (samplesX + kHeightFieldTileSize - 1) / kHeightFieldTileSize;
+    const int tilesZ = (samplesZ + kHeightFieldTileSize - 1) / kHeightFieldTileSize;
+    std::vector<RasterTriangle> triangles;
+    std::vector<std::vector<uint32_t>> tileBins(static_cast<size_t>(tilesX) * static_cast<size_t>(tilesZ));
 
     for (const auto &mesh : model.meshes)
     {
       const auto &indices = mesh.indices;
       for (size_t tri = 0; tri + 2 < indices.size(); tri += 3)
       {
-        const Vertex &v0 = mesh.vertices[indices[tri]];
-        const Vertex &v1 = mesh.vertices[indices[tri + 1]];
-        const Vertex &v2 = mesh.vertices[indices[tri + 2]];
-
-        glm::vec3 p0 = v0.Position * config.modelScale + config.modelTranslation;
-        glm::vec3 p1 = v1.Position * config.modelScale + config.modelTranslation;
-        glm::vec3 p2 = v2.Position * config.modelScale + config.modelTranslation;
-
-        glm::vec2 g0 = worldToGrid(p0);
-        glm::vec2 g1 = worldToGrid(p1);
-        glm::vec2 g2 = worldToGrid(p2);
-
-        float minX = std::floor(std::min({g0.x, g1.x, g2.x}));
-        float maxX = std::ceil(std::max({g0.x, g1.x, g2.x}));
-        float minZ = std::floor(std::min({g0.y, g1.y, g2.y}));
-        float maxZ = std::ceil(std::max({g0.y, g1.y, g2.y}));
+        RasterTriangle t{};
+        t.p0 = mesh.vertices[indices[tri]].Position * config.modelScale + config.modelTranslation;
+        t.p1 = mesh.vertices[indices[tri + 1]].Position * config.modelScale + config.modelTranslation;
+        t.p2 = mesh.vertices[indices[tri + 2]].Position * config.modelScale + config.modelTranslation;
+        t.g0 = worldToGrid(t.p0);
+        t.g1 = worldToGrid(t.p1);
+        t.g2 = worldToGrid(t.p2);
+
+        float minX = std::floor(std::min({t.g0.x, t.g1.x, t.g2.x}));
+        float maxX = std::ceil(std::max({t.g0.x, t.g1.x, t.g2.x}));
+        float minZ = std::floor(std::min({t.g0.y, t.g1.y, t.g2.y}));
+        float maxZ = std::ceil(std::max({t.g0.y, t.g1.y, t.g2.y}));
+        if (!std::isfinite(minX) || !std::isfinite(maxX) || !std::isfinite(minZ) || !std::isfinite(maxZ) ||
+            maxX < 0.0f || maxZ < 0.0f || minX > static_cast<float>(samplesX - 1) || minZ > static_cast<float>(samplesZ - 1))
+        {
+          continue;
+        }
+        t.minX = std::max(static_cast<int>(minX), 0);
+        t.maxX = std::min(static_cast<int>(maxX), samplesX - 1);
+        t.minZ = std::max(static_cast<int>(minZ), 0);
+        t.maxZ = std::min(static_cast<int>(maxZ), samplesZ - 1);
+
+        const uint32_t triIndex = static_cast<uint32_t>(triangles.size());
+        triangles.push_back(t);
+        for (int tz = t.minZ / kHeightFieldTileSize; tz <= t.maxZ / kHeightFieldTileSize; ++tz)
+        {
+          for (int tx = t.minX / kHeightFieldTileSize; tx <= t.maxX / kHeightFieldTileSize; ++tx)
+          {
+            tileBins[static_cast<size_t>(tz) * tilesX + tx].push_back(triIndex);
+          }
+        }
+      }
+    }
 
-        for (int gz = static_cast<int>(minZ); gz <= static_cast<int>(maxZ); ++gz)
+    // Each tile owns its cells, so max-height writes need no synchronisation and the
+    // result does not depend on the worker count
+    float *heights = config.heightSamples.data();
+    ParallelFor(tileBins.size(), workerCount, [&](size_t tileIndex)
+                {
+      const int tileX0 = static_cast<int>(tileIndex % tilesX) * kHeightFieldTileSize;
+      const int tileZ0 = static_cast<int>(tileIndex / tilesX) * kHeightFieldTileSize;
+      const int tileX1 = std::min(tileX0 + kHeightFieldTileSize, samplesX) - 1;
+      const int tileZ1 = std::min(tileZ0 + kHeightFieldTileSize, samplesZ) - 1;
+
+      for (uint32_t triIndex : tileBins[tileIndex])
+      {
+        const RasterTriangle &t = triangles[triIndex];
+        const int gz0 = std::max(t.minZ, tileZ0);
+        const int gz1 = std::min(t.maxZ, tileZ1);
+        const int gx0 = std::max(t.minX, tileX0);
+        const int gx1 = std::min(t.maxX, tileX1);
+        for (int gz = gz0; gz <= gz1; ++gz)
         {
-          for (int gx = static_cast<int>(minX); gx <= static_cast<int>(maxX); ++gx)
+          for (int gx = gx0; gx <= gx1; ++gx)
           {
             glm::vec2 cellCenter(static_cast<float>(gx), static_cast<float>(gz));
-            if (!pointInsideTriangle(cellCenter, g0, g1, g2))
+            if (!PointInsideTriangle(cellCenter, t.g0, t.g1, t.g2))
             {
               continue;
             }
 
             float worldX = config.gridOrigin.x + cellCenter.x * config.cellSize.x;
             float worldZ = config.gridOrigin.y + cellCenter.y * config.cellSize.y;
-            float height = samplePlaneHeight(p0, p1, p2, worldX, worldZ);
+            float height = SamplePlaneHeight(t.p0, t.p1, t.p2, worldX, worldZ);
             if (std::isfinite(height))
             {
-              updateCell(gx, gz, height);
+              float &cell = heights[static_cast<size_t>(gz) * samplesX + gx];
+              cell = std::max(cell, height);
             }
           }
         }
-      }
-    }
-
-    // Fill remaining cells (e.g., outside mesh footprint) via neighbor averaging
-    for (int z = 0; z < samplesZ; ++z)
-    {
-      for (int x = 0; x < samplesX; ++x)
-      {
-        int idx = z * samplesX + x;
-        if (config.heightSamples[idx] != config.defaultHeight)
-        {
-          continue;
-        }
+      } });
 
-        float accum = 0.0f;
-        int count = 0;
-        for (int dz = -1; dz <= 1; ++dz)
-        {
-          for (int dx = -1; dx <= 1; ++dx)
-          {
-            if (dx == 0 && dz == 0)
-              continue;
-            int sx = x + dx;
-            int sz = z + dz;
-            if (sx >= 0 && sx < samplesX && sz >= 0 && sz < samplesZ)
-            {
-              int neighborIdx = sz * samplesX + sx;
-              if (config.heightSamples[neighborIdx] != config.defaultHeight)
-              {
-                accum += config.heightSamples[neighborIdx];
-                ++count;
-              }
-            }
-          }
-        }
-        if (count > 0)
-        {
-          config.heightSamples[idx] = accum / static_cast<float>(count);
-        }
-      }
-    }
+    FillHeightFieldHoles(config, workerCount);
 
     config.heightFieldReady = true;
+    BuildHeightFieldMinMax(config);
   }
 
 } // namespace mecha
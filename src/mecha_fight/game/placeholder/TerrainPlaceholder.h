@@ -19,6 +19,16 @@ namespace mecha
     int indexCount = 0;
   };
 
+  // One level of the min/max height pyramid walked by RaycastTerrain (HeightFieldRaycast.h).
+  // Level i bounds blocks of 2^(i+1) x 2^(i+1) grid cells; single cells are read from heightSamples.
+  struct HeightFieldMinMaxLevel
+  {
+    int width{0};
+    int height{0};
+    std::vector<float> minHeights;
+    std::vector<float> maxHeights;
+  };
+
   // Configuration for procedural terrain generation
   struct TerrainConfig
   {
@@ -40,17 +50,21 @@ namespace mecha
     float defaultHeight{-3.0f};
     bool heightFieldReady{false};
     std::vector<float> heightSamples;
+    std::vector<HeightFieldMinMaxLevel> minMaxLevels;
   };
 
   // Creates a placeholder procedural terrain mesh until a terrain model is integrated.
   // Uses sine wave height variation for simple rolling hills effect.
   TerrainMeshHandle CreateTerrainPlaceholder(const TerrainConfig &config = TerrainConfig{});
 
-  // Height sampling function matching the generated terrain
-  // Used for collision detection and camera terrain avoidance
+  // Height sampling function matching the generated terrain.
+  // Hot paths should build a HeightField view (HeightField.h) once and sample through it.
   float SampleTerrainHeight(float worldX, float worldZ, const TerrainConfig &config = TerrainConfig{});
 
-  // Builds a heightfield lookup from a static model to enable collision sampling
-  void BuildHeightFieldFromModel(const Model &model, TerrainConfig &config, int samplesX = 256, int samplesZ = 256);
+  // Builds a heightfield lookup from a static model to enable collision sampling.
+  // Triangles are rasterised in grid tiles across workerCount threads (0 = hardware concurrency,
+  // 1 = serially on the calling thread); the result is bit-identical for any worker count.
+  void BuildHeightFieldFromModel(const Model &model, TerrainConfig &config, int samplesX = 256, int samplesZ = 256,
+                                 unsigned int workerCount = 0);
 
 } // namespace mecha
@@ -0,0 +1,232 @@
+#include "BlockCompression.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <glm/glm.hpp>
+
+namespace mecha
+{
+
+  namespace
+  {
+
+    struct Block
+    {
+      uint8_t texels[16][4];
+    };
+
+    Block FetchBlock(const unsigned char *pixels, int width, int height, int components, int blockX, int blockY)
+    {
+      Block block{};
+      for (int y = 0; y < 4; ++y)
+      {
+        const int sy = std::min(blockY * 4 + y, height - 1);
+        for (int x = 0; x < 4; ++x)
+        {
+          const int sx = std::min(blockX * 4 + x, width - 1);
+          const unsigned char *src = pixels + (static_cast<size_t>(sy) * width + sx) * components;
+          uint8_t *dst = block.texels[y * 4 + x];
+          dst[0] = src[0];
+          dst[1] = components > 1 ? src[1] : src[0];
+          dst[2] = components > 2 ? src[2] : (components > 1 ? 0 : src[0]);
+          dst[3] = components > 3 ? src[3] : 255;
+        }
+      }
+      return block;
+    }
+
+    uint16_t PackRgb565(const glm::vec3 &color)
+    {
+      const glm::vec3 c = glm::clamp(color, glm::vec3(0.0f), glm::vec3(255.0f));
+      const int r = static_cast<int>(c.r * 31.0f / 255.0f + 0.5f);
+      const int g = static_cast<int>(c.g * 63.0f / 255.0f + 0.5f);
+      const int b = static_cast<int>(c.b * 31.0f / 255.0f + 0.5f);
+      return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    glm::ivec3 UnpackRgb565(uint16_t packed)
+    {
+      const int r = (packed >> 11) & 31;
+      const int g = (packed >> 5) & 63;
+      const int b = packed & 31;
+      return glm::ivec3((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+    }
+
+    // Endpoints span the block along its principal colour axis; indices pick the nearest of the
+    // four-colour palette. color0 > color1 keeps BC1 out of its three-colour/transparent mode.
+    void EncodeColorBlock(const Block &block, unsigned char *out)
+    {
+      glm::vec3 colors[16];
+      glm::vec3 mean(0.0f);
+      for (int i = 0; i < 16; ++i)
+      {
+        colors[i] = glm::vec3(block.texels[i][0], block.texels[i][1], block.texels[i][2]);
+        mean += colors[i];
+      }
+      mean /= 16.0f;
+
+      float cov[6] = {0.0f}; // xx xy xz yy yz zz
+      for (const glm::vec3 &color : colors)
+      {
+        const glm::vec3 d = color - mean;
+        cov[0] += d.x * d.x;
+        cov[1] += d.x * d.y;
+        cov[2] += d.x * d.z;
+        cov[3] += d.y * d.y;
+        cov[4] += d.y * d.z;
+        cov[5] += d.z * d.z;
+      }
+
+      glm::vec3 axis(1.0f);
+      for (int iteration = 0; iteration < 8; ++iteration)
+      {
+        const glm::vec3 next(cov[0] * axis.x + cov[1] * axis.y + cov[2] * axis.z,
+                             cov[1] * axis.x + cov[3] * axis.y + cov[4] * axis.z,
+                             cov[2] * axis.x + cov[4] * axis.y + cov[5] * axis.z);
+        const float length = glm::length(next);
+        if (length < 1e-6f)
+        {
+          break;
+        }
+        axis = next / length;
+      }
+
+      float minT = 0.0f;
+      float maxT = 0.0f;
+      for (const glm::vec3 &color : colors)
+      {
+        const float t = glm::dot(color - mean, axis);
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+      }
+
+      uint16_t color0 = PackRgb565(mean + axis * maxT);
+      uint16_t color1 = PackRgb565(mean + axis * minT);
+      if (color0 < color1)
+      {
+        std::swap(color0, color1);
+      }
+
+      uint32_t indices = 0;
+      if (color0 != color1)
+      {
+        const glm::ivec3 c0 = UnpackRgb565(color0);
+        const glm::ivec3 c1 = UnpackRgb565(color1);
+        const glm::ivec3 palette[4] = {c0, c1, (c0 * 2 + c1) / 3, (c0 + c1 * 2) / 3};
+        for (int i = 0; i < 16; ++i)
+        {
+          const glm::ivec3 texel(block.texels[i][0], block.texels[i][1], block.texels[i][2]);
+          int best = 0;
+          int bestError = INT32_MAX;
+          for (int p = 0; p < 4; ++p)
+          {
+            const glm::ivec3 d = texel - palette[p];
+            const int error = d.x * d.x + d.y * d.y + d.z * d.z;
+            if (error < bestError)
+            {
+              bestError = error;
+              best = p;
+            }
+          }
+          indices |= static_cast<uint32_t>(best) << (2 * i);
+        }
+      }
+
+      std::memcpy(out, &color0, 2);
+      std::memcpy(out + 2, &color1, 2);
+      std::memcpy(out + 4, &indices, 4);
+    }
+
+    // BC4 layout, also the alpha half of BC3: two endpoints and 3-bit indices into 8 interpolated values
+    void EncodeChannelBlock(const Block &block, int channel, unsigned char *out)
+    {
+      uint8_t high = 0;
+      uint8_t low = 255;
+      for (const auto &texel : block.texels)
+      {
+        high = std::max(high, texel[channel]);
+        low = std::min(low, texel[channel]);
+      }
+
+      uint64_t indices = 0;
+      if (high != low)
+      {
+        int palette[8] = {high, low};
+        for (int i = 2; i < 8; ++i)
+        {
+          palette[i] = ((8 - i) * high + (i - 1) * low) / 7;
+        }
+        for (int i = 0; i < 16; ++i)
+        {
+          const int value = block.texels[i][channel];
+          int best = 0;
+          for (int p = 1; p < 8; ++p)
+          {
+            if (std::abs(value - palette[p]) < std::abs(value - palette[best]))
+            {
+              best = p;
+            }
+          }
+          indices |= static_cast<uint64_t>(best) << (3 * i);
+        }
+      }
+
+      out[0] = high;
+      out[1] = low;
+      for (int i = 0; i < 6; ++i)
+      {
+        out[2 + i] = static_cast<unsigned char>(indices >> (8 * i));
+      }
+    }
+
+  } // namespace
+
+  size_t GetBlockBytes(BlockFormat format)
+  {
+    return (format == BlockFormat::BC1 || format == BlockFormat::BC4) ? 8 : 16;
+  }
+
+  size_t GetCompressedSize(BlockFormat format, int width, int height)
+  {
+    const size_t blocksX = static_cast<size_t>(std::max(1, (width + 3) / 4));
+    const size_t blocksY = static_cast<size_t>(std::max(1, (height + 3) / 4));
+    return blocksX * blocksY * GetBlockBytes(format);
+  }
+
+  std::vector<unsigned char> CompressBlocks(BlockFormat format, const unsigned char *pixels, int width, int height,
+                                            int components)
+  {
+    std::vector<unsigned char> out(GetCompressedSize(format, width, height));
+    const int blocksX = std::max(1, (width + 3) / 4);
+    const int blocksY = std::max(1, (height + 3) / 4);
+    const size_t blockBytes = GetBlockBytes(format);
+
+    unsigned char *dst = out.data();
+    for (int by = 0; by < blocksY; ++by)
+    {
+      for (int bx = 0; bx < blocksX; ++bx, dst += blockBytes)
+      {
+        const Block block = FetchBlock(pixels, width, height, components, bx, by);
+        switch (format)
+        {
+        case BlockFormat::BC1:
+          EncodeColorBlock(block, dst);
+          break;
+        case BlockFormat::BC3:
+          EncodeChannelBlock(block, 3, dst);
+          EncodeColorBlock(block, dst + 8);
+          break;
+        case BlockFormat::BC4:
+          EncodeChannelBlock(block, 0, dst);
+          break;
+        case BlockFormat::BC5:
+          EncodeChannelBlock(block, 0, dst);
+          EncodeChannelBlock(block, 1, dst + 8);
+          break;
+        }
+      }
+    }
+    return out;
+  }
+
+} // namespace mecha
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mecha
+{
+
+  /**
+   * @brief GPU block formats produced by CompressBlocks (4x4 texel blocks)
+   */
+  enum class BlockFormat : uint32_t
+  {
+    BC1, ///< RGB, 8 bytes per block (S3TC DXT1)
+    BC3, ///< RGBA, BC1 colour plus an interpolated alpha block, 16 bytes (S3TC DXT5)
+    BC4, ///< Single channel, 8 bytes (RGTC1)
+    BC5  ///< Two channels, 16 bytes (RGTC2)
+  };
+
+  size_t GetBlockBytes(BlockFormat format);
+
+  /**
+   * @brief Bytes of one mip level: partial edge blocks round up, so a 1x1 level is one block
+   */
+  size_t GetCompressedSize(BlockFormat format, int width, int height);
+
+  /**
+   * @brief Encode an 8-bit image with 1-4 interleaved channels into blocks, rows of blocks top to bottom
+   *
+   * Colour endpoints follow the principal axis of each block, alpha/channel blocks use the 8-value
+   * mode between the block minimum and maximum. Edge blocks repeat the last row/column.
+   */
+  std::vector<unsigned char> CompressBlocks(BlockFormat format, const unsigned char *pixels, int width, int height,
+                                            int components);
+
+} // namespace mecha
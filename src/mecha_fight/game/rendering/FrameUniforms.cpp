@@ -0,0 +1,56 @@
+#include "FrameUniforms.h"
+
+#include <glad/glad.h>
+#include <iostream>
+
+namespace mecha
+{
+
+  FrameUniforms::FrameUniforms()
+  {
+  }
+
+  FrameUniforms::~FrameUniforms()
+  {
+    Cleanup();
+  }
+
+  bool FrameUniforms::Init()
+  {
+    Cleanup();
+
+    glGenBuffers(1, &m_ubo);
+    if (m_ubo == 0)
+    {
+      std::cerr << "[FrameUniforms] Failed to create uniform buffer" << std::endl;
+      return false;
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, m_ubo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(Data), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, kFrameConstantsBinding, m_ubo);
+    return true;
+  }
+
+  void FrameUniforms::Upload(const Data &data)
+  {
+    if (m_ubo == 0)
+    {
+      return;
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, m_ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Data), &data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+  }
+
+  void FrameUniforms::Cleanup()
+  {
+    if (m_ubo)
+    {
+      glDeleteBuffers(1, &m_ubo);
+      m_ubo = 0;
+    }
+  }
+
+} // namespace mecha
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <glm/glm.hpp>
+#include "RenderConstants.h"
+
+namespace mecha
+{
+
+  /**
+   * @brief Per-frame camera, light and shadow constants shared by every scene shader
+   *
+   * Owns a std140 uniform buffer bound at kFrameConstantsBinding. It is written once per
+   * frame after the shadow cascades are fitted, so lit shaders no longer need the matrices
+   * uploaded per program per pass.
+   */
+  class FrameUniforms
+  {
+  public:
+    /**
+     * @brief CPU mirror of the FrameConstants block declared in the shaders (std140)
+     */
+    struct Data
+    {
+      glm::mat4 projection{1.0f};
+      glm::mat4 view{1.0f};
+      glm::mat4 invProjection{1.0f};
+      glm::mat4 cascadeMatrices[kMaxShadowCascades]{};
+      glm::mat4 staticLightSpaceMatrix{1.0f};
+      glm::vec4 cascadeSplits{0.0f}; ///< Far view-space distance of each cascade
+      glm::vec3 viewPos{0.0f};
+      float time{0.0f};
+      glm::vec3 lightPos{0.0f};
+      int cascadeCount{0};
+      glm::vec3 lightIntensity{1.0f};
+      int useStaticShadow{0};
+    };
+
+    FrameUniforms();
+    ~FrameUniforms();
+
+    // Non-copyable
+    FrameUniforms(const FrameUniforms &) = delete;
+    FrameUniforms &operator=(const FrameUniforms &) = delete;
+
+    /**
+     * @brief Create the uniform buffer and attach it to its binding point
+     * @return true if the buffer was created
+     */
+    bool Init();
+
+    /**
+     * @brief Upload the constants for this frame
+     */
+    void Upload(const Data &data);
+
+    void Cleanup();
+
+  private:
+    unsigned int m_ubo{0};
+  };
+
+  static_assert(sizeof(FrameUniforms::Data) == 576, "FrameUniforms::Data must match the std140 FrameConstants block");
+  static_assert(offsetof(FrameUniforms::Data, cascadeSplits) == 512, "FrameConstants cascadeSplits offset");
+  static_assert(offsetof(FrameUniforms::Data, useStaticShadow) == 572, "FrameConstants useStaticShadow offset");
+
+} // namespace mecha
@@ -0,0 +1,91 @@
+#include "LodSelector.h"
+#include "RenderConstants.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace mecha
+{
+
+  void LodSelector::WorldBoundingSphere(const glm::mat4 &modelMatrix, const glm::vec3 &boundsMin,
+                                        const glm::vec3 &boundsMax, glm::vec3 &outCenter, float &outRadius)
+  {
+    const glm::vec3 localCenter = (boundsMin + boundsMax) * 0.5f;
+    const float maxScale = std::max({glm::length(glm::vec3(modelMatrix[0])),
+                                     glm::length(glm::vec3(modelMatrix[1])),
+                                     glm::length(glm::vec3(modelMatrix[2]))});
+    outCenter = glm::vec3(modelMatrix * glm::vec4(localCenter, 1.0f));
+    outRadius = glm::length(boundsMax - boundsMin) * 0.5f * maxScale;
+  }
+
+  float LodSelector::ScreenCoverage(const glm::mat4 &projection, const glm::vec3 &viewPos,
+                                    const glm::vec3 &center, float radius)
+  {
+    float distance = glm::length(center - viewPos);
+    if (distance <= radius)
+    {
+      return std::numeric_limits<float>::max();
+    }
+    // projection[1][1] = cot(fovY / 2) for perspective matrices
+    return radius * projection[1][1] / distance;
+  }
+
+  int LodSelector::SelectLevel(const glm::mat4 &projection, const glm::vec3 &viewPos,
+                               const glm::vec3 &center, float radius, int lodCount)
+  {
+    const int maxLevel = std::min(lodCount, kMaxLodLevels) - 1;
+    const float coverage = ScreenCoverage(projection, viewPos, center, radius);
+    int level = 0;
+    while (level < maxLevel && coverage < kLodScreenCoverage[level])
+    {
+      ++level;
+    }
+    return level;
+  }
+
+  int LodSelector::SelectLevel(const glm::mat4 &projection, const glm::vec3 &viewPos, const glm::mat4 &modelMatrix,
+                               const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, int lodCount)
+  {
+    glm::vec3 center;
+    float radius = 0.0f;
+    WorldBoundingSphere(modelMatrix, boundsMin, boundsMax, center, radius);
+    return SelectLevel(projection, viewPos, center, radius, lodCount);
+  }
+
+  int LodSelector::Update(const glm::mat4 &projection, const glm::vec3 &viewPos, const glm::mat4 &modelMatrix,
+                          const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, int lodCount)
+  {
+    glm::vec3 center;
+    float radius = 0.0f;
+    WorldBoundingSphere(modelMatrix, boundsMin, boundsMax, center, radius);
+    return Update(projection, viewPos, center, radius, lodCount);
+  }
+
+  int LodSelector::Update(const glm::mat4 &projection, const glm::vec3 &viewPos,
+                          const glm::vec3 &center, float radius, int lodCount)
+  {
+    const int maxLevel = std::min(lodCount, kMaxLodLevels) - 1;
+    if (maxLevel <= 0)
+    {
+      level_ = 0;
+      return level_;
+    }
+
+    const float coverage = ScreenCoverage(projection, viewPos, center, radius);
+    int level = std::min(level_, maxLevel);
+
+    // Coarsen only once clearly below a threshold, refine only once clearly above it
+    while (level < maxLevel && coverage < kLodScreenCoverage[level] * (1.0f - kLodHysteresis))
+    {
+      ++level;
+    }
+    while (level > 0 && coverage > kLodScreenCoverage[level - 1] * (1.0f + kLodHysteresis))
+    {
+      --level;
+    }
+
+    level_ = level;
+    return level_;
+  }
+
+} // namespace mecha
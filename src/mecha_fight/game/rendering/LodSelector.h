@@ -0,0 +1,62 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace mecha
+{
+
+  /**
+   * @brief Screen-size based LOD selection with hysteresis
+   *
+   * Keeps the last chosen level so an object hovering around a threshold
+   * does not flip between levels every frame.
+   */
+  class LodSelector
+  {
+  public:
+    /**
+     * @brief Re-evaluate the level for the current camera
+     * @param projection Camera projection matrix
+     * @param viewPos Camera position
+     * @param center World-space bounding sphere center
+     * @param radius World-space bounding sphere radius
+     * @param lodCount Number of levels available on the model
+     * @return Selected level (0 = full detail)
+     */
+    int Update(const glm::mat4 &projection, const glm::vec3 &viewPos,
+               const glm::vec3 &center, float radius, int lodCount);
+
+    /**
+     * @brief Re-evaluate the level from a model matrix and model-space bounds
+     */
+    int Update(const glm::mat4 &projection, const glm::vec3 &viewPos, const glm::mat4 &modelMatrix,
+               const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, int lodCount);
+
+    int Level() const { return level_; }
+    void Reset() { level_ = 0; }
+
+    /**
+     * @brief Stateless selection for short-lived objects (no hysteresis)
+     */
+    static int SelectLevel(const glm::mat4 &projection, const glm::vec3 &viewPos,
+                           const glm::vec3 &center, float radius, int lodCount);
+    static int SelectLevel(const glm::mat4 &projection, const glm::vec3 &viewPos, const glm::mat4 &modelMatrix,
+                           const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, int lodCount);
+
+    /**
+     * @brief Projected bounding sphere size as a fraction of half the viewport height
+     */
+    static float ScreenCoverage(const glm::mat4 &projection, const glm::vec3 &viewPos,
+                                const glm::vec3 &center, float radius);
+
+    /**
+     * @brief World-space bounding sphere of model-space bounds under a model matrix
+     */
+    static void WorldBoundingSphere(const glm::mat4 &modelMatrix, const glm::vec3 &boundsMin,
+                                    const glm::vec3 &boundsMax, glm::vec3 &outCenter, float &outRadius);
+
+  private:
+    int level_{0};
+  };
+
+} // namespace mecha
@@ -0,0 +1,341 @@
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace mecha
+{
+
+  namespace
+  {
+    constexpr int kMaxSimplifyPasses = 32;
+
+    // Symmetric 4x4 error quadric (Garland & Heckbert), upper triangle only.
+    struct Quadric
+    {
+      double a00 = 0.0, a01 = 0.0, a02 = 0.0, a03 = 0.0;
+      double a11 = 0.0, a12 = 0.0, a13 = 0.0;
+      double a22 = 0.0, a23 = 0.0;
+      double a33 = 0.0;
+
+      void AddPlane(double a, double b, double c, double d, double weight)
+      {
+        a00 += weight * a * a;
+        a01 += weight * a * b;
+        a02 += weight * a * c;
+        a03 += weight * a * d;
+        a11 += weight * b * b;
+        a12 += weight * b * c;
+        a13 += weight * b * d;
+        a22 += weight * c * c;
+        a23 += weight * c * d;
+        a33 += weight * d * d;
+      }
+
+      void Add(const Quadric &other)
+      {
+        a00 += other.a00;
+        a01 += other.a01;
+        a02 += other.a02;
+        a03 += other.a03;
+        a11 += other.a11;
+        a12 += other.a12;
+        a13 += other.a13;
+        a22 += other.a22;
+        a23 += other.a23;
+        a33 += other.a33;
+      }
+
+      double Evaluate(const glm::vec3 &p) const
+      {
+        const double x = p.x;
+        const double y = p.y;
+        const double z = p.z;
+        return a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z + 2.0 * a03 * x +
+               a11 * y * y + 2.0 * a12 * y * z + 2.0 * a13 * y +
+               a22 * z * z + 2.0 * a23 * z +
+               a33;
+      }
+    };
+
+    struct Collapse
+    {
+      double cost;
+      unsigned int from;
+      unsigned int to;
+    };
+
+    uint64_t EdgeKey(unsigned int a, unsigned int b)
+    {
+      return (static_cast<uint64_t>(a) << 32) | static_cast<uint64_t>(b);
+    }
+  } // namespace
+
+  std::vector<unsigned int> SimplifyMesh(const std::vector<Vertex> &vertices,
+                                         const std::vector<unsigned int> &indices,
+                                         size_t targetIndexCount,
+                                         float *outError)
+  {
+    std::vector<unsigned int> result(indices.begin(), indices.end() - (indices.size() % 3));
+    if (outError)
+    {
+      *outError = 0.0f;
+    }
+
+    const size_t vertexCount = vertices.size();
+    if (result.size() <= targetIndexCount || vertexCount == 0)
+    {
+      return result;
+    }
+
+    for (unsigned int index : result)
+    {
+      if (index >= vertexCount)
+      {
+        return result;
+      }
+    }
+
+    glm::vec3 minPos(FLT_MAX);
+    glm::vec3 maxPos(-FLT_MAX);
+    for (const Vertex &v : vertices)
+    {
+      minPos = glm::min(minPos, v.Position);
+      maxPos = glm::max(maxPos, v.Position);
+    }
+    float extent = glm::length(maxPos - minPos);
+    if (!std::isfinite(extent) || extent <= 0.0f)
+    {
+      extent = 1.0f;
+    }
+
+    // Accumulate area-weighted plane quadrics per vertex
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t tri = 0; tri < result.size(); tri += 3)
+    {
+      const glm::vec3 &p0 = vertices[result[tri]].Position;
+      const glm::vec3 &p1 = vertices[result[tri + 1]].Position;
+      const glm::vec3 &p2 = vertices[result[tri + 2]].Position;
+      glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+      float doubleArea = glm::length(normal);
+      if (doubleArea <= 0.0f || !std::isfinite(doubleArea))
+      {
+        continue;
+      }
+      normal /= doubleArea;
+      const double d = -static_cast<double>(glm::dot(normal, p0));
+      const double weight = 0.5 * static_cast<double>(doubleArea);
+      for (int k = 0; k < 3; ++k)
+      {
+        quadrics[result[tri + k]].AddPlane(normal.x, normal.y, normal.z, d, weight);
+      }
+    }
+
+    // Lock vertices on open edges. UV seams split vertices, so seam edges show up
+    // as open edges here as well and stay intact.
+    std::vector<unsigned char> locked(vertexCount, 0);
+    {
+      std::unordered_map<uint64_t, int> edgeCounts;
+      edgeCounts.reserve(result.size());
+      for (size_t tri = 0; tri < result.size(); tri += 3)
+      {
+        for (int k = 0; k < 3; ++k)
+        {
+          ++edgeCounts[EdgeKey(result[tri + k], result[tri + (k + 1) % 3])];
+        }
+      }
+      for (size_t tri = 0; tri < result.size(); tri += 3)
+      {
+        for (int k = 0; k < 3; ++k)
+        {
+          unsigned int a = result[tri + k];
+          unsigned int b = result[tri + (k + 1) % 3];
+          if (edgeCounts.find(EdgeKey(b, a)) == edgeCounts.end())
+          {
+            locked[a] = 1;
+            locked[b] = 1;
+          }
+        }
+      }
+    }
+
+    std::vector<unsigned int> remap(vertexCount);
+    std::vector<unsigned char> touched(vertexCount);
+    std::vector<unsigned int> adjacencyOffsets(vertexCount + 1);
+    std::vector<unsigned int> adjacencyFill(vertexCount);
+    std::vector<unsigned int> adjacency;
+    std::vector<Collapse> candidates;
+    double maxAppliedCost = 0.0;
+
+    auto collapseKeepsOrientation = [&](const Collapse &collapse)
+    {
+      const glm::vec3 &target = vertices[collapse.to].Position;
+      for (unsigned int i = adjacencyOffsets[collapse.from]; i < adjacencyOffsets[collapse.from + 1]; ++i)
+      {
+        const size_t tri = static_cast<size_t>(adjacency[i]) * 3;
+        const unsigned int a = result[tri];
+        const unsigned int b = result[tri + 1];
+        const unsigned int c = result[tri + 2];
+        if (a == collapse.to || b == collapse.to || c == collapse.to)
+        {
+          continue; // triangle disappears with the collapse
+        }
+
+        glm::vec3 p0 = vertices[a].Position;
+        glm::vec3 p1 = vertices[b].Position;
+        glm::vec3 p2 = vertices[c].Position;
+        glm::vec3 before = glm::cross(p1 - p0, p2 - p0);
+        if (a == collapse.from)
+          p0 = target;
+        else if (b == collapse.from)
+          p1 = target;
+        else
+          p2 = target;
+        glm::vec3 after = glm::cross(p1 - p0, p2 - p0);
+        if (glm::dot(before, after) <= 0.0f)
+        {
+          return false;
+        }
+      }
+      return true;
+    };
+
+    for (int pass = 0; pass < kMaxSimplifyPasses && result.size() > targetIndexCount; ++pass)
+    {
+      const size_t triangleCount = result.size() / 3;
+
+      // Vertex -> triangle adjacency for the current triangle list
+      std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0u);
+      for (unsigned int index : result)
+      {
+        ++adjacencyOffsets[index + 1];
+      }
+      for (size_t v = 0; v < vertexCount; ++v)
+      {
+        adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+      }
+      std::copy(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1, adjacencyFill.begin());
+      adjacency.resize(result.size());
+      for (size_t tri = 0; tri < triangleCount; ++tri)
+      {
+        for (int k = 0; k < 3; ++k)
+        {
+          adjacency[adjacencyFill[result[tri * 3 + k]]++] = static_cast<unsigned int>(tri);
+        }
+      }
+
+      // Score every collapsible edge once
+      candidates.clear();
+      for (size_t tri = 0; tri < result.size(); tri += 3)
+      {
+        for (int k = 0; k < 3; ++k)
+        {
+          unsigned int a = result[tri + k];
+          unsigned int b = result[tri + (k + 1) % 3];
+          if (a > b || (locked[a] && locked[b]))
+          {
+            continue;
+          }
+
+          Quadric combined = quadrics[a];
+          combined.Add(quadrics[b]);
+          const double costToB = locked[a] ? std::numeric_limits<double>::max() : combined.Evaluate(vertices[b].Position);
+          const double costToA = locked[b] ? std::numeric_limits<double>::max() : combined.Evaluate(vertices[a].Position);
+          if (costToB <= costToA)
+          {
+            candidates.push_back({costToB, a, b});
+          }
+          else
+          {
+            candidates.push_back({costToA, b, a});
+          }
+        }
+      }
+
+      if (candidates.empty())
+      {
+        break;
+      }
+
+      std::sort(candidates.begin(), candidates.end(), [](const Collapse &lhs, const Collapse &rhs)
+                { return lhs.cost < rhs.cost; });
+
+      std::iota(remap.begin(), remap.end(), 0u);
+      std::fill(touched.begin(), touched.end(), 0);
+
+      const size_t trianglesToRemove = triangleCount - targetIndexCount / 3;
+      size_t trianglesRemoved = 0;
+      size_t collapsesApplied = 0;
+      for (const Collapse &collapse : candidates)
+      {
+        if (trianglesRemoved >= trianglesToRemove)
+        {
+          break;
+        }
+        if (touched[collapse.from] || touched[collapse.to])
+        {
+          continue;
+        }
+        if (!collapseKeepsOrientation(collapse))
+        {
+          continue;
+        }
+
+        // Freeze the one-ring for the rest of this pass so later orientation
+        // checks never see connectivity that is about to change.
+        for (unsigned int i = adjacencyOffsets[collapse.from]; i < adjacencyOffsets[collapse.from + 1]; ++i)
+        {
+          const size_t tri = static_cast<size_t>(adjacency[i]) * 3;
+          bool containsTarget = false;
+          for (int k = 0; k < 3; ++k)
+          {
+            touched[result[tri + k]] = 1;
+            containsTarget = containsTarget || result[tri + k] == collapse.to;
+          }
+          if (containsTarget)
+          {
+            ++trianglesRemoved;
+          }
+        }
+
+        remap[collapse.from] = collapse.to;
+        quadrics[collapse.to].Add(quadrics[collapse.from]);
+        maxAppliedCost = std::max(maxAppliedCost, collapse.cost);
+        ++collapsesApplied;
+      }
+
+      if (collapsesApplied == 0)
+      {
+        break;
+      }
+
+      size_t write = 0;
+      for (size_t tri = 0; tri < result.size(); tri += 3)
+      {
+        unsigned int a = remap[result[tri]];
+        unsigned int b = remap[result[tri + 1]];
+        unsigned int c = remap[result[tri + 2]];
+        if (a == b || b == c || a == c)
+        {
+          continue;
+        }
+        result[write++] = a;
+        result[write++] = b;
+        result[write++] = c;
+      }
+      result.resize(write);
+    }
+
+    if (outError)
+    {
+      *outError = static_cast<float>(std::sqrt(std::max(maxAppliedCost, 0.0))) / extent;
+    }
+    return result;
+  }
+
+} // namespace mecha
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <learnopengl/mesh.h>
+
+namespace mecha
+{
+
+  /**
+   * @brief Quadric edge-collapse mesh simplification
+   *
+   * Collapses edges onto one of their existing endpoints, so the simplified
+   * index list still references the source vertex buffer and can be uploaded
+   * as an extra LOD range without duplicating vertex data. Boundary and UV
+   * seam vertices are locked to avoid opening cracks in the surface.
+   *
+   * @param vertices Source vertex buffer
+   * @param indices Source triangle list
+   * @param targetIndexCount Desired index count (multiple of 3)
+   * @param outError Optional relative geometric error of the result (0..1 of mesh extent)
+   * @return Simplified triangle list (may be larger than the target if the mesh is locked)
+   */
+  std::vector<unsigned int> SimplifyMesh(const std::vector<Vertex> &vertices,
+                                         const std::vector<unsigned int> &indices,
+                                         size_t targetIndexCount,
+                                         float *outError = nullptr);
+
+} // namespace mecha
@@ -0,0 +1,156 @@
+#include "ModelCache.h"
+#include "../core/CacheFile.h"
+#include "../core/MappedFile.h"
+
+#include <learnopengl/model.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+namespace mecha
+{
+
+  namespace
+  {
+    constexpr char kCacheMagic[4] = {'M', 'M', 'D', 'L'};
+
+    struct CacheHeader
+    {
+      char magic[4];
+      uint32_t version;
+      uint32_t modelFormatVersion;
+      uint32_t vertexSize; // Guards against Vertex layout changes without a version bump
+      uint64_t lodKey;     // LOD settings the cooked levels were built with
+      uint64_t payloadSize;
+    };
+
+    // Newest write time among the files the parser reads geometry and animation from
+    bool NewestSourceTime(const std::filesystem::path &sourcePath, std::filesystem::file_time_type &newest)
+    {
+      namespace fs = std::filesystem;
+
+      std::error_code ec;
+      newest = fs::last_write_time(sourcePath, ec);
+      if (ec)
+      {
+        return false;
+      }
+
+      for (const auto &entry : fs::directory_iterator(sourcePath.parent_path(), ec))
+      {
+        if (!entry.is_regular_file(ec))
+        {
+          continue;
+        }
+        std::string ext = entry.path().extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c)
+                       { return static_cast<char>(std::tolower(c)); });
+        if (ext == ".gltf" || ext == ".glb" || ext == ".bin")
+        {
+          const auto time = entry.last_write_time(ec);
+          if (!ec)
+          {
+            newest = std::max(newest, time);
+          }
+        }
+      }
+      return true;
+    }
+  } // namespace
+
+  std::string GetModelCachePath(const std::string &cacheDirectory, const std::string &name)
+  {
+    return (std::filesystem::path(cacheDirectory) / (name + ".mmodel")).string();
+  }
+
+  std::unique_ptr<Model> LoadModelCache(const std::string &cachePath, const std::string &sourcePath, bool gamma,
+                                        TextureProvider *textures, uint64_t lodKey)
+  {
+    namespace fs = std::filesystem;
+
+    std::error_code ec;
+    const fs::file_time_type cacheTime = fs::last_write_time(cachePath, ec);
+    if (ec)
+    {
+      return nullptr;
+    }
+
+    fs::file_time_type sourceTime;
+    if (NewestSourceTime(fs::path(sourcePath), sourceTime) && sourceTime > cacheTime)
+    {
+      std::cout << "[ModelCache] Source newer than " << cachePath << ", re-cooking" << std::endl;
+      return nullptr;
+    }
+
+    MappedFile file(cachePath);
+    if (!file.Data() || file.Size() < sizeof(CacheHeader))
+    {
+      return nullptr;
+    }
+
+    CacheHeader header{};
+    std::memcpy(&header, file.Data(), sizeof(CacheHeader));
+    if (std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) != 0 || header.version != kModelCacheVersion ||
+        header.modelFormatVersion != Model::CookedFormatVersion || header.vertexSize != sizeof(Vertex))
+    {
+      std::cout << "[ModelCache] Stale cache " << cachePath << ", re-cooking" << std::endl;
+      return nullptr;
+    }
+    if (header.lodKey != lodKey)
+    {
+      std::cout << "[ModelCache] LOD settings changed for " << cachePath << ", re-cooking" << std::endl;
+      return nullptr;
+    }
+    if (file.Size() != sizeof(CacheHeader) + header.payloadSize)
+    {
+      std::cerr << "[ModelCache] Truncated cache " << cachePath << ", re-cooking" << std::endl;
+      return nullptr;
+    }
+
+    auto model = std::make_unique<Model>(Model::DeferUpload{}, gamma, textures);
+    if (!model->Deserialize(file.Data() + sizeof(CacheHeader), static_cast<size_t>(header.payloadSize)))
+    {
+      std::cerr << "[ModelCache] Corrupt cache " << cachePath << ", re-cooking" << std::endl;
+      return nullptr;
+    }
+
+    std::cout << "[ModelCache] Loaded " << model->meshes.size() << " mesh(es) from " << cachePath << std::endl;
+    return model;
+  }
+
+  bool SaveModelCache(const std::string &cachePath, const Model &model, uint64_t lodKey)
+  {
+    if (model.IsUploaded())
+    {
+      std::cerr << "[ModelCache] Cannot cook " << cachePath << ", model was already uploaded" << std::endl;
+      return false;
+    }
+
+    std::vector<unsigned char> payload;
+    model.Serialize(payload);
+
+    CacheHeader header{};
+    std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+    header.version = kModelCacheVersion;
+    header.modelFormatVersion = Model::CookedFormatVersion;
+    header.vertexSize = static_cast<uint32_t>(sizeof(Vertex));
+    header.lodKey = lodKey;
+    header.payloadSize = payload.size();
+
+    std::string error;
+    if (!WriteFileAtomically(cachePath, {{&header, sizeof(header)}, {payload.data(), payload.size()}}, error))
+    {
+      std::cerr << "[ModelCache] Could not cook " << cachePath << ": " << error << std::endl;
+      return false;
+    }
+
+    std::cout << "[ModelCache] Cooked " << model.meshes.size() << " mesh(es) into " << cachePath << " ("
+              << payload.size() / 1024 << " KiB)" << std::endl;
+    return true;
+  }
+
+} // namespace mecha
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class Model;
+class TextureProvider;
+
+namespace mecha
+{
+
+  // Bump whenever the cooked file header changes; Model::CookedFormatVersion covers the payload.
+  inline constexpr uint32_t kModelCacheVersion = 2;
+
+  // Path of the cooked file for a model name inside cacheDirectory.
+  std::string GetModelCachePath(const std::string &cacheDirectory, const std::string &name);
+
+  // Memory-maps a cooked model and rebuilds it as a deferred Model (UploadToGpu still required).
+  // Returns null when the file is missing, written by another format version or LOD key, or older
+  // than any .gltf/.glb/.bin next to sourcePath, so the caller parses the source instead. Images go
+  // through textures when given, as they would for a freshly parsed model.
+  // lodKey identifies the LOD settings the cooked levels were built with (0 for none).
+  std::unique_ptr<Model> LoadModelCache(const std::string &cachePath, const std::string &sourcePath, bool gamma = false,
+                                        TextureProvider *textures = nullptr, uint64_t lodKey = 0);
+
+  // Writes a deferred model that has not been uploaded yet, creating parent directories as needed.
+  bool SaveModelCache(const std::string &cachePath, const Model &model, uint64_t lodKey = 0);
+
+} // namespace mecha
@@ -1,10 +1,79 @@
 #include "ModelLoader.h"
+#include "MeshSimplifier.h"
+#include "ModelCache.h"
+#include "../core/CacheFile.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <iostream>
 #include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
 
 namespace mecha
 {
 
+  struct ModelLoader::LoadBatch
+  {
+    std::vector<LoadRequest> requests;
+    std::string cookedCacheDirectory;
+    TextureProvider *textures = nullptr;
+    std::vector<std::unique_ptr<Model>> parsed; // Indexed like requests; null when loading failed or threw
+    std::vector<std::thread> workers;
+    std::atomic<size_t> nextJob{0};
+
+    std::mutex mutex;
+    std::condition_variable parsedReady;
+    std::deque<size_t> finished; // Request indices parsed and waiting for upload, in completion order
+
+    std::chrono::steady_clock::time_point startTime;
+
+    // Each worker pulls the next request until the batch is drained, so large and small models balance out.
+    // Nothing may escape the thread: a throwing job (cache IO, LOD generation running out of memory...) is
+    // finished with a null model so FinishLoadModels reports it like any other failed load.
+    void RunWorker()
+    {
+      for (size_t job = nextJob++; job < requests.size(); job = nextJob++)
+      {
+        std::unique_ptr<Model> model;
+        try
+        {
+          model = ParseModel(requests[job], cookedCacheDirectory, textures);
+        }
+        catch (const std::exception &e)
+        {
+          std::cout << "[ModelLoader] Failed to load model '" << requests[job].name << "': " << e.what() << std::endl;
+        }
+        catch (...)
+        {
+          std::cout << "[ModelLoader] Failed to load model '" << requests[job].name << "': unknown error" << std::endl;
+        }
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          parsed[job] = std::move(model);
+          finished.push_back(job);
+        }
+        parsedReady.notify_one();
+      }
+    }
+  };
+
+  ModelLoader::ModelLoader() = default;
+
+  ModelLoader::~ModelLoader()
+  {
+    if (m_pendingBatch)
+    {
+      for (std::thread &worker : m_pendingBatch->workers)
+      {
+        worker.join();
+      }
+    }
+  }
+
   Model *ModelLoader::LoadModel(const std::string &name, const std::string &path)
   {
     // Check if already loaded
@@ -20,28 +89,314 @@ namespace mecha
     {
       std::cout << "[ModelLoader] Loading model '" << name << "' from: " << path << std::endl;
 
-      ModelInfo info;
-      info.model = std::make_unique<Model>(path);
-      CalculateModelInfo(info);
-
-      // Activate default animation if available
-      if (info.model->HasAnimations())
+      std::unique_ptr<Model> model = ParseModel(LoadRequest{name, path}, m_cookedCacheDirectory, m_textures);
+      if (!model)
       {
-        info.model->SetActiveAnimation(0);
-        std::cout << "[ModelLoader] Activated default animation for '" << name << "'" << std::endl;
+        return nullptr;
       }
+      model->UploadToGpu();
+      return RegisterModel(name, std::move(model), CpuRetention::Release);
+    }
+    catch (const std::exception &e)
+    {
+      std::cout << "[ModelLoader] Failed to load model '" << name << "': " << e.what() << std::endl;
+      return nullptr;
+    }
+  }
 
-      Model *ptr = info.model.get();
-      m_models[name] = std::move(info);
+  std::unique_ptr<Model> ModelLoader::ParseModel(const LoadRequest &request, const std::string &cookedCacheDirectory,
+                                                 TextureProvider *textures)
+  {
+    const std::string cookedPath = cookedCacheDirectory.empty() ? std::string() : GetModelCachePath(cookedCacheDirectory, request.name);
+    const uint64_t lodKey = GetLodKey(request);
+    if (!cookedPath.empty())
+    {
+      if (std::unique_ptr<Model> cooked = LoadModelCache(cookedPath, request.path, false, textures, lodKey))
+      {
+        return cooked;
+      }
+    }
 
-      std::cout << "[ModelLoader] Successfully loaded model '" << name << "'" << std::endl;
-      return ptr;
+    std::unique_ptr<Model> model;
+    try
+    {
+      model = std::make_unique<Model>(request.path, Model::DeferUpload{}, false, textures);
     }
     catch (const std::exception &e)
     {
-      std::cout << "[ModelLoader] Failed to load model '" << name << "': " << e.what() << std::endl;
+      std::cout << "[ModelLoader] Failed to parse model '" << request.name << "': " << e.what() << std::endl;
       return nullptr;
     }
+
+    if (request.generateLods)
+    {
+      GenerateLods(*model, request.name, request.lodSettings);
+    }
+
+    // A failed parse leaves no meshes; do not cook it so the next launch retries the source
+    if (!cookedPath.empty() && !model->meshes.empty())
+    {
+      SaveModelCache(cookedPath, *model, lodKey);
+    }
+    return model;
+  }
+
+  void ModelLoader::BeginLoadModels(const std::vector<LoadRequest> &requests, unsigned int workerCount)
+  {
+    if (m_pendingBatch)
+    {
+      std::cout << "[ModelLoader] A model batch is already loading, finishing it first" << std::endl;
+      FinishLoadModels();
+    }
+
+    auto batch = std::make_unique<LoadBatch>();
+    batch->startTime = std::chrono::steady_clock::now();
+    batch->cookedCacheDirectory = m_cookedCacheDirectory;
+    batch->textures = m_textures;
+    for (const LoadRequest &request : requests)
+    {
+      const bool queued = std::any_of(batch->requests.begin(), batch->requests.end(),
+                                      [&](const LoadRequest &other)
+                                      { return other.name == request.name; });
+      if (HasModel(request.name) || queued)
+      {
+        std::cout << "[ModelLoader] Model '" << request.name << "' already loaded, skipping" << std::endl;
+        continue;
+      }
+      batch->requests.push_back(request);
+    }
+    batch->parsed.resize(batch->requests.size());
+
+    if (workerCount == 0)
+    {
+      workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workerCount = static_cast<unsigned int>(std::min<size_t>(workerCount, batch->requests.size()));
+
+    std::cout << "[ModelLoader] Parsing " << batch->requests.size() << " model(s) on " << workerCount << " worker thread(s)"
+              << std::endl;
+
+    for (unsigned int i = 0; i < workerCount; ++i)
+    {
+      batch->workers.emplace_back(&LoadBatch::RunWorker, batch.get());
+    }
+
+    m_pendingBatch = std::move(batch);
+  }
+
+  bool ModelLoader::FinishLoadModels(const ProgressCallback &onProgress)
+  {
+    if (!m_pendingBatch)
+    {
+      return true;
+    }
+
+    LoadBatch &batch = *m_pendingBatch;
+    const size_t total = batch.requests.size();
+    bool allLoaded = true;
+
+    // Upload in completion order so the main thread works while slower models are still parsing
+    for (size_t completed = 0; completed < total; ++completed)
+    {
+      size_t job = 0;
+      std::unique_ptr<Model> model;
+      {
+        std::unique_lock<std::mutex> lock(batch.mutex);
+        batch.parsedReady.wait(lock, [&batch]()
+                               { return !batch.finished.empty(); });
+        job = batch.finished.front();
+        batch.finished.pop_front();
+        model = std::move(batch.parsed[job]);
+      }
+
+      const LoadRequest &request = batch.requests[job];
+      if (model)
+      {
+        model->UploadToGpu();
+        RegisterModel(request.name, std::move(model), request.retention);
+      }
+      else
+      {
+        allLoaded = false;
+      }
+
+      if (onProgress)
+      {
+        onProgress(completed + 1, total, request.name);
+      }
+    }
+
+    for (std::thread &worker : batch.workers)
+    {
+      worker.join();
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - batch.startTime).count();
+    std::cout << std::fixed << std::setprecision(3) << "[ModelLoader] Loaded batch of " << total << " model(s) in " << seconds
+              << "s" << std::endl;
+
+    m_pendingBatch.reset();
+    return allLoaded;
+  }
+
+  bool ModelLoader::LoadModels(const std::vector<LoadRequest> &requests, const ProgressCallback &onProgress)
+  {
+    BeginLoadModels(requests);
+    return FinishLoadModels(onProgress);
+  }
+
+  Model *ModelLoader::RegisterModel(const std::string &name, std::unique_ptr<Model> model, CpuRetention retention)
+  {
+    ModelInfo info;
+    info.model = std::move(model);
+    info.retention = retention;
+    info.lodCount = info.model->GetLodCount();
+    CalculateModelInfo(info);
+
+    // Activate default animation if available
+    if (info.model->HasAnimations())
+    {
+      info.model->SetActiveAnimation(0);
+      std::cout << "[ModelLoader] Activated default animation for '" << name << "'" << std::endl;
+    }
+
+    Model *ptr = info.model.get();
+    m_models[name] = std::move(info);
+
+    std::cout << "[ModelLoader] Successfully loaded model '" << name << "'" << std::endl;
+    return ptr;
+  }
+
+  void ModelLoader::GenerateLods(Model &model, const std::string &name, const LodSettings &settings)
+  {
+    std::vector<size_t> levelTriangles(static_cast<size_t>(std::max(settings.extraLevels, 0)) + 1, 0);
+
+    for (Mesh &mesh : model.meshes)
+    {
+      std::vector<std::vector<unsigned int>> levels;
+      const std::vector<unsigned int> *previous = &mesh.indices;
+      levelTriangles[0] += mesh.indices.size() / 3;
+
+      for (int level = 1; level <= settings.extraLevels; ++level)
+      {
+        const size_t previousTriangles = previous->size() / 3;
+        if (previousTriangles <= settings.minTriangles)
+        {
+          break;
+        }
+
+        size_t targetTriangles = static_cast<size_t>(static_cast<float>(previousTriangles) * settings.reductionPerLevel);
+        targetTriangles = std::max(targetTriangles, settings.minTriangles);
+
+        float error = 0.0f;
+        std::vector<unsigned int> reduced = SimplifyMesh(mesh.vertices, *previous, targetTriangles * 3, &error);
+
+        // Stop once a level no longer saves meaningful work or deforms the silhouette too much
+        if (reduced.size() >= previous->size() * 9 / 10 || error > settings.maxRelativeError)
+        {
+          break;
+        }
+
+        levels.push_back(std::move(reduced));
+        previous = &levels.back();
+      }
+
+      for (size_t level = 0; level < levels.size(); ++level)
+      {
+        levelTriangles[level + 1] += levels[level].size() / 3;
+      }
+      mesh.setLodIndices(levels);
+    }
+
+    // One line per model so messages from concurrent workers do not interleave mid-report
+    std::ostringstream report;
+    const int lodCount = model.GetLodCount();
+    report << "[ModelLoader] Generated " << lodCount << " LOD level(s) for '" << name << "' triangles:";
+    for (int level = 0; level < lodCount; ++level)
+    {
+      report << " " << levelTriangles[level];
+    }
+    std::cout << report.str() << std::endl;
+  }
+
+  uint64_t ModelLoader::GetLodKey(const LoadRequest &request)
+  {
+    if (!request.generateLods)
+    {
+      return 0;
+    }
+
+    // Field by field, so padding bytes never reach the hash and equal settings hash equally
+    const LodSettings &settings = request.lodSettings;
+    uint64_t hash = Fnv1aValue(kFnv1aOffset, settings.extraLevels);
+    hash = Fnv1aValue(hash, settings.reductionPerLevel);
+    hash = Fnv1aValue(hash, static_cast<uint64_t>(settings.minTriangles));
+    hash = Fnv1aValue(hash, settings.maxRelativeError);
+    return hash == 0 ? 1 : hash;
+  }
+
+  bool ModelLoader::SetCpuRetention(const std::string &name, CpuRetention retention)
+  {
+    auto it = m_models.find(name);
+    if (it == m_models.end())
+    {
+      return false;
+    }
+    it->second.retention = retention;
+    return true;
+  }
+
+  size_t ModelLoader::ReleaseCpuData()
+  {
+    size_t freed = 0;
+    for (auto &entry : m_models)
+    {
+      ModelInfo &info = entry.second;
+      if (info.retention != CpuRetention::Release || !info.model || !info.model->HasCpuData())
+      {
+        continue;
+      }
+      const size_t before = info.model->GetCpuMeshBytes();
+      info.model->ReleaseCpuData();
+      freed += before - info.model->GetCpuMeshBytes();
+    }
+
+    std::cout << "[ModelLoader] Released " << freed / 1024 << " KiB of CPU mesh data" << std::endl;
+    return freed;
+  }
+
+  void ModelLoader::PrintMemoryReport() const
+  {
+    // Sorted by name so consecutive reports line up
+    std::vector<const std::pair<const std::string, ModelInfo> *> entries;
+    entries.reserve(m_models.size());
+    for (const auto &entry : m_models)
+    {
+      entries.push_back(&entry);
+    }
+    std::sort(entries.begin(), entries.end(), [](const auto *a, const auto *b)
+              { return a->first < b->first; });
+
+    size_t totalCpu = 0;
+    size_t totalGpu = 0;
+    std::cout << "[ModelLoader] Mesh memory (KiB, CPU / GPU):" << std::endl;
+    for (const auto *entry : entries)
+    {
+      const ModelInfo &info = entry->second;
+      if (!info.model)
+      {
+        continue;
+      }
+      const size_t cpu = info.model->GetCpuMeshBytes();
+      const size_t gpu = info.model->GetGpuMeshBytes();
+      totalCpu += cpu;
+      totalGpu += gpu;
+      std::cout << "  " << std::left << std::setw(20) << entry->first << std::right << std::setw(10) << cpu / 1024
+                << " / " << std::setw(8) << gpu / 1024
+                << (info.retention == CpuRetention::Keep ? "  (kept)" : "") << std::endl;
+    }
+    std::cout << "  " << std::left << std::setw(20) << "total" << std::right << std::setw(10) << totalCpu / 1024 << " / "
+              << std::setw(8) << totalGpu / 1024 << std::endl;
   }
 
   Model *ModelLoader::GetModel(const std::string &name)
@@ -93,6 +448,7 @@ namespace mecha
     info.boundingMax = info.model->GetBoundingMax();
     info.dimensions = info.model->GetDimensions();
     info.center = (info.boundingMin + info.boundingMax) * 0.5f;
+    info.boundingRadius = glm::length(info.dimensions) * 0.5f;
 
     std::cout << std::fixed << std::setprecision(3)
               << "[ModelLoader] Bounding box: min(" << info.boundingMin.x << ", " << info.boundingMin.y << ", " << info.boundingMin.z
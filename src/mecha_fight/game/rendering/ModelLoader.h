@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <learnopengl/model.h>
 
 namespace mecha
@@ -12,11 +15,52 @@ namespace mecha
    * @brief Factory for loading and caching 3D models
    *
    * Handles GLTF/GLB model loading, bounding box calculation, and animation setup.
-   * Provides caching to avoid redundant loads.
+   * Provides caching to avoid redundant loads. Batches can be parsed on worker threads
+   * while the main thread keeps the GL context and only performs the uploads.
    */
   class ModelLoader
   {
   public:
+    /**
+     * @brief What happens to a model's CPU vertex/index copies once they are on the GPU
+     */
+    enum class CpuRetention
+    {
+      Release, ///< Dropped by ReleaseCpuData (default; only drawing needs the model)
+      Keep     ///< Kept until the policy is changed, for models whose geometry is read on the CPU
+    };
+
+    /**
+     * @brief Parameters for LOD chain generation
+     */
+    struct LodSettings
+    {
+      int extraLevels = 3;             ///< Reduced levels generated after the source mesh
+      float reductionPerLevel = 0.5f;  ///< Triangle ratio kept from one level to the next
+      size_t minTriangles = 64;        ///< Meshes below this size are not reduced further
+      float maxRelativeError = 0.05f;  ///< Levels exceeding this error (fraction of mesh extent) are dropped
+    };
+
+    struct LoadRequest
+    {
+      std::string name;
+      std::string path;
+      CpuRetention retention = CpuRetention::Release;
+      bool generateLods = false; ///< Build a LOD chain after parsing; it is cooked with the model
+      LodSettings lodSettings;
+    };
+
+    /**
+     * @brief Called on the main thread after each model of a batch is uploaded
+     */
+    using ProgressCallback = std::function<void(size_t completed, size_t total, const std::string &name)>;
+
+    ModelLoader();
+    ~ModelLoader();
+
+    ModelLoader(const ModelLoader &) = delete;
+    ModelLoader &operator=(const ModelLoader &) = delete;
+
     struct ModelInfo
     {
       std::unique_ptr<Model> model;
@@ -24,8 +68,24 @@ namespace mecha
       glm::vec3 center;
       glm::vec3 boundingMin;
       glm::vec3 boundingMax;
+      float boundingRadius = 0.0f;
+      int lodCount = 1;
+      CpuRetention retention = CpuRetention::Release;
     };
 
+    /**
+     * @brief Directory for cooked binary models; empty (the default) disables the cache
+     *
+     * When set, each load prefers <dir>/<name>.mmodel if it is newer than the source files and
+     * writes one after parsing the glTF otherwise.
+     */
+    void SetCookedCacheDirectory(const std::string &directory) { m_cookedCacheDirectory = directory; }
+
+    /**
+     * @brief Shared texture store for model images; null (the default) gives every model its own textures
+     */
+    void SetTextureProvider(TextureProvider *textures) { m_textures = textures; }
+
     /**
      * @brief Load or retrieve cached model
      * @param name Unique identifier for the model
@@ -34,6 +94,51 @@ namespace mecha
      */
     Model *LoadModel(const std::string &name, const std::string &path);
 
+    /**
+     * @brief Start parsing a batch of models on worker threads and return immediately
+     *
+     * glTF parsing, image decoding and LOD generation run off the main thread; nothing touches
+     * GL until FinishLoadModels. Names that are already cached are skipped. Only one batch may
+     * be in flight at a time.
+     * @param requests Models to load
+     * @param workerCount Worker threads (0 = hardware concurrency, capped by the batch size)
+     */
+    void BeginLoadModels(const std::vector<LoadRequest> &requests, unsigned int workerCount = 0);
+
+    /**
+     * @brief Upload models of the pending batch as workers finish them; blocks until all are done
+     *
+     * Must be called on the thread that owns the GL context.
+     * @param onProgress Invoked after each model is registered
+     * @return true if every model in the batch loaded
+     */
+    bool FinishLoadModels(const ProgressCallback &onProgress = {});
+
+    /**
+     * @brief Convenience wrapper for BeginLoadModels followed by FinishLoadModels
+     */
+    bool LoadModels(const std::vector<LoadRequest> &requests, const ProgressCallback &onProgress = {});
+
+    /**
+     * @brief Change a loaded model's CPU retention policy
+     * @return true if the model exists
+     */
+    bool SetCpuRetention(const std::string &name, CpuRetention retention);
+
+    /**
+     * @brief Free the CPU mesh copies of every model whose policy is Release
+     *
+     * Call once LODs are generated and CPU consumers (heightfield bake, terrain chunking) are done;
+     * released models can still be drawn but not simplified or sampled.
+     * @return Bytes freed
+     */
+    size_t ReleaseCpuData();
+
+    /**
+     * @brief Log resident CPU and GPU mesh bytes per model
+     */
+    void PrintMemoryReport() const;
+
     /**
      * @brief Get previously loaded model
      * @param name Model identifier
@@ -69,9 +174,36 @@ namespace mecha
     size_t GetLoadedCount() const { return m_models.size(); }
 
   private:
+    struct LoadBatch;
+
     std::unordered_map<std::string, ModelInfo> m_models;
+    std::unique_ptr<LoadBatch> m_pendingBatch;
+    std::string m_cookedCacheDirectory;
+    TextureProvider *m_textures = nullptr;
+
+    /**
+     * @brief Produce a deferred (not yet uploaded) model from the cooked cache or the source file
+     *
+     * Thread-safe; touches no GL state. A requested LOD chain comes from the cooked file, or is
+     * generated here on a cache miss and cooked with the model. Returns null if parsing threw.
+     */
+    static std::unique_ptr<Model> ParseModel(const LoadRequest &request, const std::string &cookedCacheDirectory,
+                                             TextureProvider *textures);
+
+    /**
+     * @brief Build simplified index ranges for every mesh of a deferred model
+     *
+     * Levels share the source vertex buffer; only index data is added. Touches no GL state.
+     */
+    static void GenerateLods(Model &model, const std::string &name, const LodSettings &settings);
+
+    /**
+     * @brief Cache key of a request's LOD chain, 0 when it asks for none
+     */
+    static uint64_t GetLodKey(const LoadRequest &request);
 
     void CalculateModelInfo(ModelInfo &info);
+    Model *RegisterModel(const std::string &name, std::unique_ptr<Model> model, CpuRetention retention);
   };
 
 } // namespace mecha
@@ -5,11 +5,37 @@ namespace mecha
   // Reserve a high-numbered texture unit for the shadow depth map to avoid
   // conflicting with material textures bound by Model::Draw (which uses units starting at 0).
   inline constexpr int kShadowMapTextureUnit = 15;
-  inline constexpr int kSSAOTexUnit = 14;
+  inline constexpr int kStaticShadowMapTextureUnit = 13;
 
-  // Default resolution for directional shadow maps. High resolution reduces pixelation at close range.
-  inline constexpr unsigned int kShadowMapResolution = 16384;
+  // Uniform buffer binding points for the std140 blocks shared across shader programs.
+  inline constexpr unsigned int kFrameConstantsBinding = 0;
+  inline constexpr unsigned int kSSAOKernelBinding = 1;
+
+  // Per-cascade resolution for the directional shadow map array. Cascades are fitted to
+  // slices of the camera frustum, so near-field texel density no longer depends on terrain size.
+  inline constexpr unsigned int kShadowMapResolution = 2048;
+  inline constexpr int kMaxShadowCascades = 4;
+  inline constexpr int kShadowCascadeCount = 4;
+  // Cached depth of never-moving casters (terrain, gates) over the whole map, rebuilt only
+  // when the light or the static caster set changes.
+  inline constexpr unsigned int kStaticShadowMapResolution = 4096;
   inline constexpr unsigned int kSSAOKernelSize = 64;
   inline constexpr unsigned int kSSAONoiseDimension = 4;
+  // SSAO is evaluated at screen size / divisor and upsampled with depth-aware weights.
+  // Lower resolution modes also take fewer kernel taps, strided over the full kernel.
+  inline constexpr int kSSAOResolutionModeCount = 3;
+  inline constexpr unsigned int kSSAOResolutionDivisors[kSSAOResolutionModeCount] = {1, 2, 4};
+  inline constexpr unsigned int kSSAOSampleCounts[kSSAOResolutionModeCount] = {64, 32, 16};
+
+  // Projected bounding-sphere coverage (fraction of half the viewport height) below which
+  // each successive mesh LOD is used. Hysteresis widens the band to stop popping at boundaries.
+  inline constexpr int kMaxLodLevels = 4;
+  inline constexpr float kLodScreenCoverage[kMaxLodLevels - 1] = {0.30f, 0.12f, 0.05f};
+  inline constexpr float kLodHysteresis = 0.2f;
+
+  // The terrain model is split at load into kTerrainChunksPerSide^2 world-space chunks, each
+  // culled on its own and drawn at one of up to kTerrainLodLevels levels (LodSelector thresholds).
+  inline constexpr int kTerrainChunksPerSide = 16;
+  inline constexpr int kTerrainLodLevels = 3;
 } // namespace mecha
 
@@ -22,6 +22,10 @@ namespace mecha
     // Create UI quad geometry
     CreateUIQuad();
 
+    // Models share one texture store so images used by several models are uploaded once
+    m_textureManager.Initialize();
+    m_modelLoader.SetTextureProvider(&m_textureManager);
+
     std::cout << "[ResourceManager] Initialization complete" << std::endl;
     return true;
   }
@@ -40,6 +44,7 @@ namespace mecha
 
     m_meshGenerator.Clear();
     m_modelLoader.Clear();
+    m_textureManager.Clear();
     m_shaderFactory.Clear();
 
     std::cout << "[ResourceManager] Shutdown complete" << std::endl;
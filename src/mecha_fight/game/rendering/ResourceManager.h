@@ -3,6 +3,7 @@
 #include "ShaderFactory.h"
 #include "ModelLoader.h"
 #include "MeshGenerator.h"
+#include "TextureManager.h"
 #include <glad/glad.h>
 #include <string>
 #include <memory>
@@ -44,10 +45,12 @@ namespace mecha
     ShaderFactory &Shaders() { return m_shaderFactory; }
     ModelLoader &Models() { return m_modelLoader; }
     MeshGenerator &Meshes() { return m_meshGenerator; }
+    TextureManager &Textures() { return m_textureManager; }
 
     const ShaderFactory &Shaders() const { return m_shaderFactory; }
     const ModelLoader &Models() const { return m_modelLoader; }
     const MeshGenerator &Meshes() const { return m_meshGenerator; }
+    const TextureManager &Textures() const { return m_textureManager; }
 
     // UI quad geometry
     unsigned int GetUIQuadVAO() const { return m_uiQuadVAO; }
@@ -66,6 +69,7 @@ namespace mecha
 
   private:
     ShaderFactory m_shaderFactory;
+    TextureManager m_textureManager; // Before the loader, whose workers use it until they are joined
     ModelLoader m_modelLoader;
     MeshGenerator m_meshGenerator;
 
@@ -1,7 +1,9 @@
 #include "SSAORenderer.h"
+#include "RenderConstants.h"
 
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
 #include <iostream>
 #include <random>
 #include <vector>
@@ -37,10 +39,17 @@ namespace mecha
     {
       return false;
     }
+    // The shader block is sized for kSSAOKernelSize samples
+    m_config.kernelSize = std::min(m_config.kernelSize, kSSAOKernelSize);
+    if (m_config.resolutionDivisor == 0)
+    {
+      m_config.resolutionDivisor = 1;
+    }
 
     GenerateKernel();
+    CreateKernelBuffer();
     CreateNoiseTexture();
-    CreateGBuffer();
+    CreateSceneTarget();
     CreateSSAOBuffers();
     CreateQuad();
 
@@ -56,10 +65,23 @@ namespace mecha
     }
     m_config.width = width;
     m_config.height = height;
-    CreateGBuffer();
+    CreateSceneTarget();
     CreateSSAOBuffers();
   }
 
+  void SSAORenderer::SetResolutionDivisor(unsigned int divisor)
+  {
+    if (divisor == 0 || divisor == m_config.resolutionDivisor)
+    {
+      return;
+    }
+    m_config.resolutionDivisor = divisor;
+    if (m_initialized)
+    {
+      CreateSSAOBuffers();
+    }
+  }
+
   void SSAORenderer::Cleanup()
   {
     DestroyBuffers();
@@ -67,17 +89,16 @@ namespace mecha
     m_initialized = false;
   }
 
-  void SSAORenderer::BeginGeometryPass()
+  void SSAORenderer::BeginScenePass()
   {
     if (!m_initialized)
     {
       return;
     }
-    glBindFramebuffer(GL_FRAMEBUFFER, m_gBufferFBO);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_sceneFBO);
   }
 
-  void SSAORenderer::EndGeometryPass()
+  void SSAORenderer::EndScenePass()
   {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
   }
@@ -100,6 +121,25 @@ namespace mecha
     }
   }
 
+  void SSAORenderer::CreateKernelBuffer()
+  {
+    // std140 pads vec3 array elements to 16 bytes
+    std::vector<glm::vec4> padded(kSSAOKernelSize, glm::vec4(0.0f));
+    for (size_t i = 0; i < m_kernel.size(); ++i)
+    {
+      padded[i] = glm::vec4(m_kernel[i], 0.0f);
+    }
+
+    if (m_kernelUBO == 0)
+    {
+      glGenBuffers(1, &m_kernelUBO);
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, m_kernelUBO);
+    glBufferData(GL_UNIFORM_BUFFER, padded.size() * sizeof(glm::vec4), padded.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, kSSAOKernelBinding, m_kernelUBO);
+  }
+
   void SSAORenderer::CreateNoiseTexture()
   {
     std::vector<glm::vec3> noiseData;
@@ -123,48 +163,39 @@ namespace mecha
     glBindTexture(GL_TEXTURE_2D, 0);
   }
 
-  void SSAORenderer::CreateGBuffer()
+  void SSAORenderer::CreateSceneTarget()
   {
-    if (m_gBufferFBO == 0)
+    if (m_sceneFBO == 0)
     {
-      glGenFramebuffers(1, &m_gBufferFBO);
+      glGenFramebuffers(1, &m_sceneFBO);
     }
-    glBindFramebuffer(GL_FRAMEBUFFER, m_gBufferFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_sceneFBO);
 
-    if (m_gPosition == 0)
+    if (m_sceneColor == 0)
     {
-      glGenTextures(1, &m_gPosition);
+      glGenTextures(1, &m_sceneColor);
     }
-    glBindTexture(GL_TEXTURE_2D, m_gPosition);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, m_config.width, m_config.height, 0, GL_RGB, GL_FLOAT, nullptr);
+    glBindTexture(GL_TEXTURE_2D, m_sceneColor);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_config.width, m_config.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_gPosition, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_sceneColor, 0);
 
-    if (m_gNormal == 0)
+    if (m_sceneDepth == 0)
     {
-      glGenTextures(1, &m_gNormal);
+      glGenTextures(1, &m_sceneDepth);
     }
-    glBindTexture(GL_TEXTURE_2D, m_gNormal);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, m_config.width, m_config.height, 0, GL_RGB, GL_FLOAT, nullptr);
+    glBindTexture(GL_TEXTURE_2D, m_sceneDepth);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, m_config.width, m_config.height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, m_gNormal, 0);
-
-    if (m_depthRBO == 0)
-    {
-      glGenRenderbuffers(1, &m_depthRBO);
-    }
-    glBindRenderbuffer(GL_RENDERBUFFER, m_depthRBO);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, m_config.width, m_config.height);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthRBO);
-
-    unsigned int attachments[2] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
-    glDrawBuffers(2, attachments);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_sceneDepth, 0);
 
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
     {
-      std::cerr << "[SSAORenderer] G-buffer incomplete" << std::endl;
+      std::cerr << "[SSAORenderer] Scene framebuffer incomplete" << std::endl;
     }
 
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -172,6 +203,9 @@ namespace mecha
 
   void SSAORenderer::CreateSSAOBuffers()
   {
+    m_ssaoWidth = std::max(1u, m_config.width / m_config.resolutionDivisor);
+    m_ssaoHeight = std::max(1u, m_config.height / m_config.resolutionDivisor);
+
     if (m_ssaoFBO == 0)
     {
       glGenFramebuffers(1, &m_ssaoFBO);
@@ -182,7 +216,7 @@ namespace mecha
     }
     glBindFramebuffer(GL_FRAMEBUFFER, m_ssaoFBO);
     glBindTexture(GL_TEXTURE_2D, m_ssaoColorBuffer);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, m_config.width, m_config.height, 0, GL_RED, GL_FLOAT, nullptr);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, m_ssaoWidth, m_ssaoHeight, 0, GL_RED, GL_FLOAT, nullptr);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_ssaoColorBuffer, 0);
@@ -201,7 +235,7 @@ namespace mecha
     }
     glBindFramebuffer(GL_FRAMEBUFFER, m_ssaoBlurFBO);
     glBindTexture(GL_TEXTURE_2D, m_ssaoColorBufferBlur);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, m_config.width, m_config.height, 0, GL_RED, GL_FLOAT, nullptr);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, m_ssaoWidth, m_ssaoHeight, 0, GL_RED, GL_FLOAT, nullptr);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_ssaoColorBufferBlur, 0);
@@ -211,6 +245,43 @@ namespace mecha
       std::cerr << "[SSAORenderer] SSAO blur framebuffer incomplete" << std::endl;
     }
 
+    // Full resolution target for the depth-aware upsample, only needed when downsampled
+    if (IsDownsampled())
+    {
+      if (m_ssaoUpsampleFBO == 0)
+      {
+        glGenFramebuffers(1, &m_ssaoUpsampleFBO);
+      }
+      if (m_ssaoColorBufferFull == 0)
+      {
+        glGenTextures(1, &m_ssaoColorBufferFull);
+      }
+      glBindFramebuffer(GL_FRAMEBUFFER, m_ssaoUpsampleFBO);
+      glBindTexture(GL_TEXTURE_2D, m_ssaoColorBufferFull);
+      glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, m_config.width, m_config.height, 0, GL_RED, GL_FLOAT, nullptr);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+      glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_ssaoColorBufferFull, 0);
+
+      if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+      {
+        std::cerr << "[SSAORenderer] SSAO upsample framebuffer incomplete" << std::endl;
+      }
+    }
+    else
+    {
+      if (m_ssaoUpsampleFBO)
+      {
+        glDeleteFramebuffers(1, &m_ssaoUpsampleFBO);
+        m_ssaoUpsampleFBO = 0;
+      }
+      if (m_ssaoColorBufferFull)
+      {
+        glDeleteTextures(1, &m_ssaoColorBufferFull);
+        m_ssaoColorBufferFull = 0;
+      }
+    }
+
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
   }
 
@@ -245,25 +316,20 @@ namespace mecha
 
   void SSAORenderer::DestroyBuffers()
   {
-    if (m_gBufferFBO)
-    {
-      glDeleteFramebuffers(1, &m_gBufferFBO);
-      m_gBufferFBO = 0;
-    }
-    if (m_gPosition)
+    if (m_sceneFBO)
     {
-      glDeleteTextures(1, &m_gPosition);
-      m_gPosition = 0;
+      glDeleteFramebuffers(1, &m_sceneFBO);
+      m_sceneFBO = 0;
     }
-    if (m_gNormal)
+    if (m_sceneColor)
     {
-      glDeleteTextures(1, &m_gNormal);
-      m_gNormal = 0;
+      glDeleteTextures(1, &m_sceneColor);
+      m_sceneColor = 0;
     }
-    if (m_depthRBO)
+    if (m_sceneDepth)
     {
-      glDeleteRenderbuffers(1, &m_depthRBO);
-      m_depthRBO = 0;
+      glDeleteTextures(1, &m_sceneDepth);
+      m_sceneDepth = 0;
     }
     if (m_ssaoFBO)
     {
@@ -285,11 +351,26 @@ namespace mecha
       glDeleteTextures(1, &m_ssaoColorBufferBlur);
       m_ssaoColorBufferBlur = 0;
     }
+    if (m_ssaoUpsampleFBO)
+    {
+      glDeleteFramebuffers(1, &m_ssaoUpsampleFBO);
+      m_ssaoUpsampleFBO = 0;
+    }
+    if (m_ssaoColorBufferFull)
+    {
+      glDeleteTextures(1, &m_ssaoColorBufferFull);
+      m_ssaoColorBufferFull = 0;
+    }
     if (m_noiseTexture)
     {
       glDeleteTextures(1, &m_noiseTexture);
       m_noiseTexture = 0;
     }
+    if (m_kernelUBO)
+    {
+      glDeleteBuffers(1, &m_kernelUBO);
+      m_kernelUBO = 0;
+    }
     if (m_quadVAO)
     {
       glDeleteVertexArrays(1, &m_quadVAO);
@@ -14,6 +14,7 @@ namespace mecha
       unsigned int width = 0;
       unsigned int height = 0;
       unsigned int kernelSize = 64;
+      unsigned int resolutionDivisor = 1; ///< AO buffers are width/divisor x height/divisor
     };
 
     SSAORenderer();
@@ -21,28 +22,40 @@ namespace mecha
 
     bool Init(const Config &config);
     void Resize(unsigned int width, unsigned int height);
+    void SetResolutionDivisor(unsigned int divisor);
     void Cleanup();
 
-    void BeginGeometryPass();
-    void EndGeometryPass();
+    /// Bind the offscreen scene target the main pass renders into (depth is read back by the AO pass)
+    void BeginScenePass();
+    void EndScenePass();
 
-    unsigned int GetPositionTexture() const { return m_gPosition; }
-    unsigned int GetNormalTexture() const { return m_gNormal; }
+    unsigned int GetSceneFBO() const { return m_sceneFBO; }
+    unsigned int GetSceneColorTexture() const { return m_sceneColor; }
+    unsigned int GetSceneDepthTexture() const { return m_sceneDepth; }
     unsigned int GetSSAORawTexture() const { return m_ssaoColorBuffer; }
     unsigned int GetSSAOBlurTexture() const { return m_ssaoColorBufferBlur; }
     unsigned int GetNoiseTexture() const { return m_noiseTexture; }
     unsigned int GetSSAOFBO() const { return m_ssaoFBO; }
     unsigned int GetSSAOBlurFBO() const { return m_ssaoBlurFBO; }
+    unsigned int GetSSAOUpsampleFBO() const { return m_ssaoUpsampleFBO; }
+    /// Full resolution AO texture sampled by lit shaders (the blur target when not downsampled)
+    unsigned int GetSSAOOutputTexture() const { return IsDownsampled() ? m_ssaoColorBufferFull : m_ssaoColorBufferBlur; }
+    bool IsDownsampled() const { return m_config.resolutionDivisor > 1; }
     unsigned int GetQuadVAO() const { return m_quadVAO; }
     const std::vector<glm::vec3> &GetKernel() const { return m_kernel; }
+    unsigned int GetKernelBuffer() const { return m_kernelUBO; }
     bool IsInitialized() const { return m_initialized; }
     unsigned int GetWidth() const { return m_config.width; }
     unsigned int GetHeight() const { return m_config.height; }
+    unsigned int GetSSAOWidth() const { return m_ssaoWidth; }
+    unsigned int GetSSAOHeight() const { return m_ssaoHeight; }
+    unsigned int GetResolutionDivisor() const { return m_config.resolutionDivisor; }
 
   private:
     void GenerateKernel();
+    void CreateKernelBuffer();
     void CreateNoiseTexture();
-    void CreateGBuffer();
+    void CreateSceneTarget();
     void CreateSSAOBuffers();
     void CreateQuad();
     void DestroyBuffers();
@@ -50,10 +63,9 @@ namespace mecha
     Config m_config{};
     bool m_initialized{false};
 
-    unsigned int m_gBufferFBO{0};
-    unsigned int m_gPosition{0};
-    unsigned int m_gNormal{0};
-    unsigned int m_depthRBO{0};
+    unsigned int m_sceneFBO{0};
+    unsigned int m_sceneColor{0};
+    unsigned int m_sceneDepth{0};
 
     unsigned int m_ssaoFBO{0};
     unsigned int m_ssaoColorBuffer{0};
@@ -61,7 +73,13 @@ namespace mecha
     unsigned int m_ssaoBlurFBO{0};
     unsigned int m_ssaoColorBufferBlur{0};
 
+    unsigned int m_ssaoUpsampleFBO{0};
+    unsigned int m_ssaoColorBufferFull{0};
+    unsigned int m_ssaoWidth{0};
+    unsigned int m_ssaoHeight{0};
+
     unsigned int m_noiseTexture{0};
+    unsigned int m_kernelUBO{0}; ///< std140 SSAOKernel block, written once at init
 
     unsigned int m_quadVAO{0};
     unsigned int m_quadVBO{0};
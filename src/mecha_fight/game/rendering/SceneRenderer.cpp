@@ -1,7 +1,9 @@
 #include "SceneRenderer.h"
 #include "RenderConstants.h"
+#include "../core/CacheFile.h"
 #include <glad/glad.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -20,6 +22,7 @@ namespace mecha
   bool SceneRenderer::Initialize(const RenderConfig &config)
   {
     m_config = config;
+    m_config.ssaoResolutionMode = glm::clamp(m_config.ssaoResolutionMode, 0, kSSAOResolutionModeCount - 1);
 
     if (m_config.enableSSAO)
     {
@@ -27,6 +30,7 @@ namespace mecha
       ssaoConfig.width = config.screenWidth;
       ssaoConfig.height = config.screenHeight;
       ssaoConfig.kernelSize = kSSAOKernelSize;
+      ssaoConfig.resolutionDivisor = kSSAOResolutionDivisors[m_config.ssaoResolutionMode];
       m_ssaoInitialized = m_ssaoRenderer.Init(ssaoConfig);
       if (!m_ssaoInitialized)
       {
@@ -34,12 +38,34 @@ namespace mecha
       }
     }
 
+    if (!m_frameUniforms.Init())
+    {
+      std::cerr << "[SceneRenderer] Failed to initialize frame constants buffer" << std::endl;
+      return false;
+    }
+
     CreateSkyboxGeometry();
 
     std::cout << "[SceneRenderer] Initialized with resolution " << config.screenWidth << "x" << config.screenHeight << std::endl;
     return true;
   }
 
+  void SceneRenderer::SetSSAOResolutionMode(int mode)
+  {
+    mode = glm::clamp(mode, 0, kSSAOResolutionModeCount - 1);
+    if (mode == m_config.ssaoResolutionMode)
+    {
+      return;
+    }
+    m_config.ssaoResolutionMode = mode;
+    if (m_ssaoInitialized)
+    {
+      m_ssaoRenderer.SetResolutionDivisor(kSSAOResolutionDivisors[mode]);
+      std::cout << "[SceneRenderer] SSAO resolution " << m_ssaoRenderer.GetSSAOWidth() << "x" << m_ssaoRenderer.GetSSAOHeight()
+                << " (" << kSSAOSampleCounts[mode] << " samples)" << std::endl;
+    }
+  }
+
   void SceneRenderer::SetDependencies(ResourceManager *resourceMgr, ShadowMapper *shadowMapper, GameWorld *world)
   {
     m_resourceMgr = resourceMgr;
@@ -47,28 +73,72 @@ namespace mecha
     m_world = world;
   }
 
-  void SceneRenderer::RenderFrame(const FrameData &frameData)
+  bool SceneRenderer::BuildTerrainChunks(const TerrainConfig &terrainConfig)
   {
-    if (ShouldUseSSAO())
+    if (!terrainConfig.terrainModel)
     {
-      RenderSSAOGeometry(frameData);
-      EvaluateSSAO(frameData);
+      return false;
     }
+    return m_terrainChunks.Build(*terrainConfig.terrainModel, terrainConfig);
+  }
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  void SceneRenderer::RenderFrame(const FrameData &frameData)
+  {
+    // Terrain chunk levels follow the camera and are shared by the shadow and main passes
+    m_terrainChunks.UpdateLods(frameData.projection, frameData.viewPos);
+
+    // 1. Shadow pass
+    RenderShadowPass(frameData);
+
+    // Camera, light and cascade constants for every pass that follows
+    UploadFrameConstants(frameData);
+
+    // With SSAO the scene goes to an offscreen target so the AO pass can read its depth
+    const bool useSSAO = ShouldUseSSAO();
+    if (useSSAO)
+    {
+      m_ssaoRenderer.BeginScenePass();
+    }
+    else
+    {
+      glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
     glViewport(0, 0, m_config.screenWidth, m_config.screenHeight);
     glEnable(GL_DEPTH_TEST);
     glClearColor(m_config.clearColor.r, m_config.clearColor.g, m_config.clearColor.b, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    // 1. Shadow pass
-    RenderShadowPass(frameData);
-
     // 2. Main scene
     RenderMainScene(frameData);
 
     // 3. World entities
     RenderEntities(frameData);
+
+    // 4. AO from the main pass depth, multiplied into the scene on the way to the backbuffer
+    if (useSSAO)
+    {
+      m_ssaoRenderer.EndScenePass();
+      bool aoReady = EvaluateSSAO();
+      CompositeSSAO(aoReady);
+    }
+  }
+
+  void SceneRenderer::UploadFrameConstants(const FrameData &frameData)
+  {
+    m_elapsedTime += frameData.deltaTime;
+
+    FrameUniforms::Data data{};
+    data.projection = frameData.projection;
+    data.view = frameData.view;
+    data.invProjection = glm::inverse(frameData.projection);
+    data.viewPos = frameData.viewPos;
+    data.time = m_elapsedTime;
+    data.lightIntensity = m_config.lightIntensity;
+    if (m_shadowMapper)
+    {
+      m_shadowMapper->WriteFrameConstants(data);
+    }
+    m_frameUniforms.Upload(data);
   }
 
   void SceneRenderer::RenderShadowPass(const FrameData &frameData)
@@ -76,40 +146,118 @@ namespace mecha
     if (!m_shadowMapper || !m_resourceMgr)
       return;
 
-    glm::mat4 lightSpaceMatrix = m_shadowMapper->GetLightSpaceMatrix();
-
     Shader *shadowShader = m_resourceMgr->Shaders().GetShader("shadow");
     if (!shadowShader)
       return;
 
+    m_shadowMapper->UpdateCascades(frameData.view, frameData.projection);
+
     shadowShader->use();
-    shadowShader->setMat4("lightSpaceMatrix", lightSpaceMatrix);
 
-    m_shadowMapper->BeginShadowPass();
+    // Terrain and other static casters live in the cached layer and are only
+    // re-rendered when the light or the static caster set changes.
+    const bool cacheStatic = m_shadowMapper->HasStaticLayer();
+    if (cacheStatic)
+    {
+      const uint64_t signature = ComputeStaticShadowSignature();
+      if (m_shadowMapper->NeedsStaticRefresh(signature))
+      {
+        RenderStaticShadowLayer(frameData, *shadowShader);
+        m_shadowMapper->MarkStaticLayerValid(signature);
+      }
+    }
 
-    // Render terrain to depth map
-    if (frameData.terrainConfig && frameData.terrainConfig->terrainModel)
+    for (int cascade = 0; cascade < m_shadowMapper->GetCascadeCount(); ++cascade)
     {
-      glm::mat4 terrainModel = glm::mat4(1.0f);
-      terrainModel = glm::translate(terrainModel, frameData.terrainConfig->modelTranslation);
-      terrainModel = glm::scale(terrainModel, frameData.terrainConfig->modelScale);
-      shadowShader->setMat4("model", terrainModel);
-      shadowShader->setBool("useSkinning", false);
-      shadowShader->setInt("bonesCount", 0);
-      frameData.terrainConfig->terrainModel->Draw(*shadowShader);
+      const glm::mat4 &lightSpaceMatrix = m_shadowMapper->GetCascadeMatrix(cascade);
+      shadowShader->setMat4("lightSpaceMatrix", lightSpaceMatrix);
+
+      m_shadowMapper->BeginCascade(cascade);
+
+      if (!cacheStatic)
+      {
+        RenderTerrainDepth(frameData, *shadowShader, lightSpaceMatrix, false);
+      }
+
+      if (m_world)
+      {
+        RenderContext shadowCtx{};
+        shadowCtx.deltaTime = frameData.deltaTime;
+        // Camera values so casters pick the same LOD as the main pass
+        shadowCtx.projection = frameData.projection;
+        shadowCtx.viewPos = frameData.viewPos;
+        shadowCtx.lightSpaceMatrix = lightSpaceMatrix;
+        shadowCtx.shadowPass = true;
+        shadowCtx.shadowCascade = cascade;
+        shadowCtx.shadowCasters = cacheStatic ? ShadowCasterSet::DynamicOnly : ShadowCasterSet::All;
+        shadowCtx.overrideShader = shadowShader;
+        m_world->Render(shadowCtx);
+      }
     }
 
+    m_shadowMapper->EndShadowPass();
+  }
+
+  void SceneRenderer::RenderStaticShadowLayer(const FrameData &frameData, Shader &shadowShader)
+  {
+    const glm::mat4 &lightSpaceMatrix = m_shadowMapper->GetStaticLightSpaceMatrix();
+    shadowShader.setMat4("lightSpaceMatrix", lightSpaceMatrix);
+
+    m_shadowMapper->BeginStaticLayer();
+    // The cached layer outlives the camera that would pick chunk levels, so it keeps full detail
+    RenderTerrainDepth(frameData, shadowShader, lightSpaceMatrix, true);
+
     if (m_world)
     {
-      RenderContext shadowCtx{};
-      shadowCtx.deltaTime = frameData.deltaTime;
-      shadowCtx.lightSpaceMatrix = lightSpaceMatrix;
-      shadowCtx.shadowPass = true;
-      shadowCtx.overrideShader = shadowShader;
-      m_world->Render(shadowCtx);
+      RenderContext staticCtx{};
+      staticCtx.deltaTime = frameData.deltaTime;
+      staticCtx.projection = frameData.projection;
+      staticCtx.viewPos = frameData.viewPos;
+      staticCtx.lightSpaceMatrix = lightSpaceMatrix;
+      staticCtx.shadowPass = true;
+      staticCtx.shadowCasters = ShadowCasterSet::StaticOnly;
+      staticCtx.overrideShader = &shadowShader;
+      m_world->Render(staticCtx);
     }
+  }
 
-    m_shadowMapper->EndShadowPass();
+  void SceneRenderer::RenderTerrainDepth(const FrameData &frameData, Shader &depthShader, const glm::mat4 &lightSpaceMatrix, bool fullDetail)
+  {
+    if (!frameData.terrainConfig || !frameData.terrainConfig->terrainModel)
+      return;
+
+    if (m_terrainChunks.IsReady())
+    {
+      depthShader.setBool("useSkinning", false);
+      depthShader.setInt("bonesCount", 0);
+      m_terrainChunks.DrawDepth(depthShader, lightSpaceMatrix, fullDetail);
+      return;
+    }
+
+    glm::mat4 terrainModel = glm::mat4(1.0f);
+    terrainModel = glm::translate(terrainModel, frameData.terrainConfig->modelTranslation);
+    terrainModel = glm::scale(terrainModel, frameData.terrainConfig->modelScale);
+    depthShader.setMat4("model", terrainModel);
+    depthShader.setBool("useSkinning", false);
+    depthShader.setInt("bonesCount", 0);
+    frameData.terrainConfig->terrainModel->Draw(depthShader);
+  }
+
+  uint64_t SceneRenderer::ComputeStaticShadowSignature() const
+  {
+    // FNV-1a over the positions of the current static casters
+    uint64_t hash = kFnv1aOffset;
+    if (!m_world)
+      return hash;
+
+    for (const auto &entity : m_world->Entities())
+    {
+      if (!entity || !entity->IsStaticShadowCaster())
+        continue;
+
+      hash = Fnv1aValue(hash, entity->GetTransform().position);
+    }
+    return hash;
   }
 
   void SceneRenderer::RenderMainScene(const FrameData &frameData)
@@ -120,13 +268,11 @@ namespace mecha
     glViewport(0, 0, m_config.screenWidth, m_config.screenHeight);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    glm::mat4 lightSpaceMatrix = m_shadowMapper->GetLightSpaceMatrix();
-
-    RenderSkybox(frameData);
-    RenderTerrain(frameData, lightSpaceMatrix);
+    RenderSkybox();
+    RenderTerrain(frameData);
   }
 
-  void SceneRenderer::RenderTerrain(const FrameData &frameData, const glm::mat4 &lightSpaceMatrix)
+  void SceneRenderer::RenderTerrain(const FrameData &frameData)
   {
     if (!frameData.terrainConfig)
       return;
@@ -140,12 +286,14 @@ namespace mecha
       return;
 
     terrainShader->use();
-    terrainShader->setMat4("projection", frameData.projection);
-    terrainShader->setMat4("view", frameData.view);
-    terrainShader->setMat4("lightSpaceMatrix", lightSpaceMatrix);
-    terrainShader->setVec3("viewPos", frameData.viewPos);
-    terrainShader->setVec3("lightPos", m_shadowMapper->GetLightPosition());
-    terrainShader->setVec3("lightIntensity", m_config.lightIntensity);
+    terrainShader->setVec3("fallbackColor", glm::vec3(0.35f, 0.45f, 0.35f));
+    m_shadowMapper->BindShadowMaps(*terrainShader, kShadowMapTextureUnit);
+
+    if (m_terrainChunks.IsReady())
+    {
+      m_terrainChunks.DrawVisible(*terrainShader, frameData.projection * frameData.view);
+      return;
+    }
 
     bool hasAlbedoTexture = false;
     for (const auto &mesh : terrainConfig->terrainModel->meshes)
@@ -157,22 +305,6 @@ namespace mecha
       }
     }
     terrainShader->setBool("useAlbedoTexture", hasAlbedoTexture);
-    terrainShader->setVec3("fallbackColor", glm::vec3(0.35f, 0.45f, 0.35f));
-
-    glActiveTexture(GL_TEXTURE0 + kShadowMapTextureUnit);
-    glBindTexture(GL_TEXTURE_2D, m_shadowMapper->GetDepthMapTexture());
-    terrainShader->setInt("shadowMap", kShadowMapTextureUnit);
-
-    terrainShader->setVec2("screenSize", glm::vec2(static_cast<float>(m_config.screenWidth), static_cast<float>(m_config.screenHeight)));
-    bool useSSAO = ShouldUseSSAO();
-    terrainShader->setBool("useSSAO", useSSAO);
-    terrainShader->setFloat("aoStrength", m_config.ssaoStrength);
-    if (useSSAO)
-    {
-      glActiveTexture(GL_TEXTURE0 + kSSAOTexUnit);
-      glBindTexture(GL_TEXTURE_2D, m_ssaoRenderer.GetSSAOBlurTexture());
-      terrainShader->setInt("ssaoMap", kSSAOTexUnit);
-    }
 
     glm::mat4 terrainModel = glm::mat4(1.0f);
     terrainModel = glm::translate(terrainModel, terrainConfig->modelTranslation);
@@ -181,7 +313,7 @@ namespace mecha
     terrainConfig->terrainModel->Draw(*terrainShader);
   }
 
-  void SceneRenderer::RenderSkybox(const FrameData &frameData)
+  void SceneRenderer::RenderSkybox()
   {
     if (!m_config.enableSkybox || !m_resourceMgr || m_skyboxVAO == 0)
     {
@@ -203,11 +335,7 @@ namespace mecha
     glDepthMask(GL_FALSE);
     glDepthFunc(GL_LEQUAL);
 
-    glm::mat4 viewNoTranslation = glm::mat4(glm::mat3(frameData.view));
-
     skyboxShader->use();
-    skyboxShader->setMat4("projection", frameData.projection);
-    skyboxShader->setMat4("view", viewNoTranslation);
     skyboxShader->setVec3("tint", m_config.skyboxTint);
     skyboxShader->setFloat("intensity", m_config.skyboxIntensity);
     skyboxShader->setInt("skybox", 0);
@@ -233,19 +361,13 @@ namespace mecha
     renderCtx.view = frameData.view;
     renderCtx.viewPos = frameData.viewPos;
     renderCtx.lightSpaceMatrix = m_shadowMapper->GetLightSpaceMatrix();
-    renderCtx.lightPos = m_shadowMapper->GetLightPosition();
-    renderCtx.lightIntensity = m_config.lightIntensity;
-    renderCtx.shadowMapTexture = m_shadowMapper->GetDepthMapTexture();
-    renderCtx.screenSize = glm::vec2(static_cast<float>(m_config.screenWidth), static_cast<float>(m_config.screenHeight));
-    renderCtx.ssaoEnabled = ShouldUseSSAO();
-    renderCtx.ssaoStrength = m_config.ssaoStrength;
-    renderCtx.ssaoTexture = renderCtx.ssaoEnabled ? m_ssaoRenderer.GetSSAOBlurTexture() : 0;
+    renderCtx.shadowMapper = m_shadowMapper;
     m_world->Render(renderCtx);
 
-    RenderLightDebug(frameData);
+    RenderLightDebug();
   }
 
-  void SceneRenderer::RenderLightDebug(const FrameData &frameData)
+  void SceneRenderer::RenderLightDebug()
   {
     if (!m_config.showLightDebug || !m_resourceMgr || !m_shadowMapper)
     {
@@ -262,8 +384,6 @@ namespace mecha
     glm::vec3 lightPos = m_shadowMapper->GetLightPosition();
 
     colorShader->use();
-    colorShader->setMat4("projection", frameData.projection);
-    colorShader->setMat4("view", frameData.view);
     glm::mat4 model = glm::mat4(1.0f);
     model = glm::translate(model, lightPos);
     model = glm::scale(model, glm::vec3(m_config.lightMarkerScale));
@@ -275,94 +395,49 @@ namespace mecha
     glBindVertexArray(0);
   }
 
-  void SceneRenderer::RenderSSAOGeometry(const FrameData &frameData)
-  {
-    if (!ShouldUseSSAO() || !m_resourceMgr)
-    {
-      return;
-    }
-
-    Shader *ssaoInputShader = m_resourceMgr->Shaders().GetShader("ssao_input");
-    if (!ssaoInputShader)
-    {
-      return;
-    }
-
-    glViewport(0, 0, m_config.screenWidth, m_config.screenHeight);
-    glEnable(GL_DEPTH_TEST);
-    m_ssaoRenderer.BeginGeometryPass();
-
-    ssaoInputShader->use();
-    ssaoInputShader->setMat4("projection", frameData.projection);
-    ssaoInputShader->setMat4("view", frameData.view);
-
-    if (frameData.terrainConfig && frameData.terrainConfig->terrainModel)
-    {
-      glm::mat4 terrainModel = glm::mat4(1.0f);
-      terrainModel = glm::translate(terrainModel, frameData.terrainConfig->modelTranslation);
-      terrainModel = glm::scale(terrainModel, frameData.terrainConfig->modelScale);
-      ssaoInputShader->setMat4("model", terrainModel);
-      ssaoInputShader->setBool("useSkinning", false);
-      ssaoInputShader->setInt("bonesCount", 0);
-      frameData.terrainConfig->terrainModel->Draw(*ssaoInputShader);
-    }
-
-    if (m_world)
-    {
-      RenderContext ctx{};
-      ctx.deltaTime = frameData.deltaTime;
-      ctx.projection = frameData.projection;
-      ctx.view = frameData.view;
-      ctx.shadowPass = true;
-      ctx.overrideShader = ssaoInputShader;
-      m_world->Render(ctx);
-    }
-
-    m_ssaoRenderer.EndGeometryPass();
-  }
-
-  void SceneRenderer::EvaluateSSAO(const FrameData &frameData)
+  bool SceneRenderer::EvaluateSSAO()
   {
     if (!ShouldUseSSAO() || !m_resourceMgr)
     {
-      return;
+      return false;
     }
 
     Shader *ssaoShader = m_resourceMgr->Shaders().GetShader("ssao");
     Shader *ssaoBlurShader = m_resourceMgr->Shaders().GetShader("ssao_blur");
-    if (!ssaoShader || !ssaoBlurShader)
+    Shader *ssaoUpsampleShader = m_resourceMgr->Shaders().GetShader("ssao_upsample");
+    bool downsampled = m_ssaoRenderer.IsDownsampled();
+    if (!ssaoShader || !ssaoBlurShader || (downsampled && !ssaoUpsampleShader))
     {
-      return;
+      return false;
     }
 
+    const unsigned int aoWidth = m_ssaoRenderer.GetSSAOWidth();
+    const unsigned int aoHeight = m_ssaoRenderer.GetSSAOHeight();
+
     glDisable(GL_DEPTH_TEST);
-    glViewport(0, 0, m_config.screenWidth, m_config.screenHeight);
+    glViewport(0, 0, aoWidth, aoHeight);
 
     glBindFramebuffer(GL_FRAMEBUFFER, m_ssaoRenderer.GetSSAOFBO());
     glClear(GL_COLOR_BUFFER_BIT);
 
+    // Kernel lives in the SSAOKernel block written at init, matrices in FrameConstants
     ssaoShader->use();
-    ssaoShader->setInt("gPosition", 0);
-    ssaoShader->setInt("gNormal", 1);
-    ssaoShader->setInt("texNoise", 2);
-    ssaoShader->setMat4("projection", frameData.projection);
+    ssaoShader->setInt("sceneDepth", 0);
+    ssaoShader->setInt("texNoise", 1);
     ssaoShader->setFloat("radius", m_config.ssaoRadius);
     ssaoShader->setFloat("bias", m_config.ssaoBias);
     ssaoShader->setFloat("power", m_config.ssaoPower);
     const auto &kernel = m_ssaoRenderer.GetKernel();
-    for (size_t i = 0; i < kernel.size(); ++i)
-    {
-      ssaoShader->setVec3("samples[" + std::to_string(i) + "]", kernel[i]);
-    }
-    float noiseScaleX = static_cast<float>(m_config.screenWidth) / static_cast<float>(kSSAONoiseDimension);
-    float noiseScaleY = static_cast<float>(m_config.screenHeight) / static_cast<float>(kSSAONoiseDimension);
+    int sampleCount = static_cast<int>(std::min<size_t>(kSSAOSampleCounts[m_config.ssaoResolutionMode], kernel.size()));
+    ssaoShader->setInt("sampleCount", sampleCount);
+    ssaoShader->setInt("sampleStride", std::max(1, static_cast<int>(kernel.size()) / std::max(sampleCount, 1)));
+    float noiseScaleX = static_cast<float>(aoWidth) / static_cast<float>(kSSAONoiseDimension);
+    float noiseScaleY = static_cast<float>(aoHeight) / static_cast<float>(kSSAONoiseDimension);
     ssaoShader->setVec2("noiseScale", glm::vec2(noiseScaleX, noiseScaleY));
 
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_ssaoRenderer.GetPositionTexture());
+    glBindTexture(GL_TEXTURE_2D, m_ssaoRenderer.GetSceneDepthTexture());
     glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, m_ssaoRenderer.GetNormalTexture());
-    glActiveTexture(GL_TEXTURE2);
     glBindTexture(GL_TEXTURE_2D, m_ssaoRenderer.GetNoiseTexture());
 
     RenderFullscreenQuad();
@@ -375,7 +450,58 @@ namespace mecha
     glBindTexture(GL_TEXTURE_2D, m_ssaoRenderer.GetSSAORawTexture());
     RenderFullscreenQuad();
 
+    // Bring the reduced AO back to screen size without bleeding across depth edges
+    if (downsampled)
+    {
+      glViewport(0, 0, m_config.screenWidth, m_config.screenHeight);
+      glBindFramebuffer(GL_FRAMEBUFFER, m_ssaoRenderer.GetSSAOUpsampleFBO());
+      glClear(GL_COLOR_BUFFER_BIT);
+      ssaoUpsampleShader->use();
+      ssaoUpsampleShader->setInt("ssaoInput", 0);
+      ssaoUpsampleShader->setInt("sceneDepth", 1);
+      ssaoUpsampleShader->setFloat("depthTolerance", m_config.ssaoUpsampleDepthTolerance);
+      glActiveTexture(GL_TEXTURE0);
+      glBindTexture(GL_TEXTURE_2D, m_ssaoRenderer.GetSSAOBlurTexture());
+      glActiveTexture(GL_TEXTURE1);
+      glBindTexture(GL_TEXTURE_2D, m_ssaoRenderer.GetSceneDepthTexture());
+      RenderFullscreenQuad();
+    }
+
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, m_config.screenWidth, m_config.screenHeight);
+    glEnable(GL_DEPTH_TEST);
+    return true;
+  }
+
+  void SceneRenderer::CompositeSSAO(bool applyAO)
+  {
+    Shader *compositeShader = m_resourceMgr ? m_resourceMgr->Shaders().GetShader("ssao_composite") : nullptr;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, m_config.screenWidth, m_config.screenHeight);
+
+    if (!compositeShader)
+    {
+      // Still present the frame, just without occlusion
+      glBindFramebuffer(GL_READ_FRAMEBUFFER, m_ssaoRenderer.GetSceneFBO());
+      glBlitFramebuffer(0, 0, m_config.screenWidth, m_config.screenHeight,
+                        0, 0, m_config.screenWidth, m_config.screenHeight,
+                        GL_COLOR_BUFFER_BIT, GL_NEAREST);
+      glBindFramebuffer(GL_FRAMEBUFFER, 0);
+      return;
+    }
+
+    glDisable(GL_DEPTH_TEST);
+    compositeShader->use();
+    compositeShader->setInt("sceneColor", 0);
+    compositeShader->setInt("ssaoMap", 1);
+    compositeShader->setFloat("aoStrength", applyAO ? m_config.ssaoStrength : 0.0f);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_ssaoRenderer.GetSceneColorTexture());
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, m_ssaoRenderer.GetSSAOOutputTexture());
+    RenderFullscreenQuad();
+    glActiveTexture(GL_TEXTURE0);
     glEnable(GL_DEPTH_TEST);
   }
 
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <learnopengl/shader_m.h>
 #include <learnopengl/model.h>
 #include "ShadowMapper.h"
 #include "SSAORenderer.h"
+#include "FrameUniforms.h"
+#include "TerrainChunks.h"
 #include "ResourceManager.h"
 #include "../entities/MechaPlayer.h"
 #include "../entities/EnemyDrone.h"
@@ -19,9 +22,10 @@ namespace mecha
    * @brief Handles all scene rendering including shadow passes and main rendering
    *
    * Encapsulates the rendering pipeline:
-   * 1. Shadow depth map generation
+   * 1. Shadow depth map generation (one layer per cascade)
    * 2. Main scene rendering with shadows
    * 3. Entity rendering via GameWorld
+   * 4. SSAO from the main pass depth, composited into the backbuffer
    */
   class SceneRenderer
   {
@@ -41,6 +45,8 @@ namespace mecha
       float ssaoBias{0.05f};
       float ssaoPower{1.2f};
       float ssaoStrength{0.85f};
+      int ssaoResolutionMode{0}; ///< Index into kSSAOResolutionDivisors (0 full, 1 half, 2 quarter)
+      float ssaoUpsampleDepthTolerance{0.1f};
       bool enableSkybox{true};
       float skyboxIntensity{1.0f};
       glm::vec3 skyboxTint{1.0f, 1.0f, 1.0f};
@@ -81,29 +87,49 @@ namespace mecha
      */
     void SetDependencies(ResourceManager *resourceMgr, ShadowMapper *shadowMapper, GameWorld *world);
 
+    /**
+     * @brief Split the terrain model into culled, LOD'd chunks (call once after resources load)
+     *
+     * Without chunks the terrain is drawn as one model every pass.
+     */
+    bool BuildTerrainChunks(const TerrainConfig &terrainConfig);
+
     /**
      * @brief Render complete frame (shadow pass + main scene)
      */
     void RenderFrame(const FrameData &frameData);
 
+    /**
+     * @brief Switch SSAO between full, half and quarter resolution (reallocates AO buffers)
+     */
+    void SetSSAOResolutionMode(int mode);
+    int GetSSAOResolutionMode() const { return m_config.ssaoResolutionMode; }
+
   private:
     RenderConfig m_config;
     ResourceManager *m_resourceMgr = nullptr;
     ShadowMapper *m_shadowMapper = nullptr;
     GameWorld *m_world = nullptr;
     SSAORenderer m_ssaoRenderer;
+    FrameUniforms m_frameUniforms;
+    TerrainChunks m_terrainChunks;
+    float m_elapsedTime{0.0f};
     bool m_ssaoInitialized{false};
     unsigned int m_skyboxVAO{0};
     unsigned int m_skyboxVBO{0};
 
+    void UploadFrameConstants(const FrameData &frameData);
     void RenderShadowPass(const FrameData &frameData);
-    void RenderSSAOGeometry(const FrameData &frameData);
-    void EvaluateSSAO(const FrameData &frameData);
+    void RenderStaticShadowLayer(const FrameData &frameData, Shader &shadowShader);
+    void RenderTerrainDepth(const FrameData &frameData, Shader &depthShader, const glm::mat4 &lightSpaceMatrix, bool fullDetail);
+    uint64_t ComputeStaticShadowSignature() const;
+    bool EvaluateSSAO();
+    void CompositeSSAO(bool applyAO);
     void RenderMainScene(const FrameData &frameData);
-    void RenderSkybox(const FrameData &frameData);
-    void RenderTerrain(const FrameData &frameData, const glm::mat4 &lightSpaceMatrix);
+    void RenderSkybox();
+    void RenderTerrain(const FrameData &frameData);
     void RenderEntities(const FrameData &frameData);
-    void RenderLightDebug(const FrameData &frameData);
+    void RenderLightDebug();
     void RenderFullscreenQuad();
     bool ShouldUseSSAO() const;
     void CreateSkyboxGeometry();
@@ -1,9 +1,29 @@
 #include "ShaderFactory.h"
+#include "RenderConstants.h"
 #include <iostream>
 
 namespace mecha
 {
 
+  namespace
+  {
+    void BindUniformBlock(unsigned int program, const char *blockName, unsigned int binding)
+    {
+      unsigned int index = glGetUniformBlockIndex(program, blockName);
+      if (index != GL_INVALID_INDEX)
+      {
+        glUniformBlockBinding(program, index, binding);
+      }
+    }
+
+    // Shared blocks are attached once at link time; the buffers stay bound to their points
+    void BindSharedUniformBlocks(const Shader &shader)
+    {
+      BindUniformBlock(shader.ID, "FrameConstants", kFrameConstantsBinding);
+      BindUniformBlock(shader.ID, "SSAOKernel", kSSAOKernelBinding);
+    }
+  } // namespace
+
   Shader *ShaderFactory::LoadShader(const std::string &name, const std::string &vertexPath, const std::string &fragmentPath)
   {
     // Check if already loaded
@@ -18,6 +38,7 @@ namespace mecha
     try
     {
       auto shader = std::make_unique<Shader>(vertexPath.c_str(), fragmentPath.c_str());
+      BindSharedUniformBlocks(*shader);
       m_shaderPaths[name] = {vertexPath, fragmentPath};
 
       Shader *ptr = shader.get();
@@ -63,6 +84,7 @@ namespace mecha
     {
       const auto &[vertexPath, fragmentPath] = pathIt->second;
       auto shader = std::make_unique<Shader>(vertexPath.c_str(), fragmentPath.c_str());
+      BindSharedUniformBlocks(*shader);
       m_shaders[name] = std::move(shader);
 
       std::cout << "[ShaderFactory] Reloaded shader '" << name << "'" << std::endl;
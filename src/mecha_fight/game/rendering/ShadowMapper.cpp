@@ -1,7 +1,11 @@
 #include "ShadowMapper.h"
+#include "LodSelector.h"
 
 #include <glad/glad.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <iostream>
 
 namespace mecha
@@ -10,9 +14,16 @@ namespace mecha
   ShadowMapper::ShadowMapper()
       : m_depthMapFBO(0),
         m_depthMap(0),
-        m_lightSpaceMatrix(1.0f),
+        m_cascadeCount(1),
+        m_staticFBO(0),
+        m_staticDepthMap(0),
+        m_staticMatrix(1.0f),
+        m_staticSignature(0),
+        m_staticValid(false),
         m_initialized(false)
   {
+    std::fill(std::begin(m_cascadeMatrices), std::end(m_cascadeMatrices), glm::mat4(1.0f));
+    std::fill(std::begin(m_cascadeSplits), std::end(m_cascadeSplits), FLT_MAX);
   }
 
   ShadowMapper::~ShadowMapper()
@@ -28,28 +39,30 @@ namespace mecha
     }
 
     m_config = config;
+    m_cascadeCount = std::clamp(m_config.cascadeCount, 1, kMaxShadowCascades);
 
     // Create framebuffer for depth map
     glGenFramebuffers(1, &m_depthMapFBO);
 
-    // Create depth texture
+    // Create depth texture array, one layer per cascade
     glGenTextures(1, &m_depthMap);
-    glBindTexture(GL_TEXTURE_2D, m_depthMap);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT,
-                 m_config.width, m_config.height,
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_depthMap);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT32F,
+                 m_config.width, m_config.height, m_cascadeCount,
                  0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
 
     float borderColor[] = {1.0f, 1.0f, 1.0f, 1.0f};
-    glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
+    glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, borderColor);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 
-    // Attach depth texture to framebuffer
+    // Attach first layer to check framebuffer completeness
     glBindFramebuffer(GL_FRAMEBUFFER, m_depthMapFBO);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_depthMap, 0);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_depthMap, 0, 0);
     glDrawBuffer(GL_NONE);
     glReadBuffer(GL_NONE);
 
@@ -62,35 +75,220 @@ namespace mecha
       return false;
     }
 
+    if (m_config.staticResolution > 0)
+    {
+      glGenFramebuffers(1, &m_staticFBO);
+      glGenTextures(1, &m_staticDepthMap);
+      glBindTexture(GL_TEXTURE_2D, m_staticDepthMap);
+      glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32F,
+                   m_config.staticResolution, m_config.staticResolution,
+                   0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+      glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
+      glBindTexture(GL_TEXTURE_2D, 0);
+
+      glBindFramebuffer(GL_FRAMEBUFFER, m_staticFBO);
+      glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_staticDepthMap, 0);
+      glDrawBuffer(GL_NONE);
+      glReadBuffer(GL_NONE);
+
+      if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+      {
+        std::cout << "[ShadowMapper] ERROR: Static shadow framebuffer is not complete!" << std::endl;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        Cleanup();
+        return false;
+      }
+    }
+
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
+    m_staticValid = false;
     UpdateLightSpaceMatrix();
 
     m_initialized = true;
-    std::cout << "[ShadowMapper] Initialized with " << m_config.width << "x" << m_config.height << " depth map" << std::endl;
+    std::cout << "[ShadowMapper] Initialized with " << m_cascadeCount << " x " << m_config.width << "x"
+              << m_config.height << " depth map" << (m_cascadeCount > 1 ? " cascades" : "");
+    if (m_staticDepthMap != 0)
+    {
+      std::cout << " + " << m_config.staticResolution << "x" << m_config.staticResolution << " static layer";
+    }
+    std::cout << std::endl;
     return true;
   }
 
+  void ShadowMapper::UpdateCascades(const glm::mat4 &view, const glm::mat4 &projection)
+  {
+    if (m_cascadeCount <= 1)
+    {
+      return;
+    }
+
+    // Recover the perspective parameters from the projection matrix
+    const float cameraNear = projection[3][2] / (projection[2][2] - 1.0f);
+    const float cameraFar = projection[3][2] / (projection[2][2] + 1.0f);
+    const float tanHalfFovY = 1.0f / projection[1][1];
+    const float tanHalfFovX = 1.0f / projection[0][0];
+    if (!(cameraNear > 0.0f) || !(cameraFar > cameraNear))
+    {
+      return;
+    }
+
+    const float shadowFar = std::min(cameraFar, m_config.cascadeMaxDistance);
+    const glm::mat4 inverseView = glm::inverse(view);
+    const glm::vec3 lightDir = glm::normalize(m_config.target - m_config.lightPosition);
+    const glm::vec3 lightUp = std::abs(lightDir.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+
+    float splitNear = cameraNear;
+    for (int cascade = 0; cascade < m_cascadeCount; ++cascade)
+    {
+      // Practical split scheme: blend logarithmic and uniform distributions
+      const float fraction = static_cast<float>(cascade + 1) / static_cast<float>(m_cascadeCount);
+      const float logSplit = cameraNear * std::pow(shadowFar / cameraNear, fraction);
+      const float uniformSplit = cameraNear + (shadowFar - cameraNear) * fraction;
+      const float splitFar = m_config.cascadeSplitLambda * logSplit + (1.0f - m_config.cascadeSplitLambda) * uniformSplit;
+
+      glm::vec3 corners[8];
+      glm::vec3 center(0.0f);
+      int cornerIndex = 0;
+      for (float depth : {splitNear, splitFar})
+      {
+        for (float sx : {-1.0f, 1.0f})
+        {
+          for (float sy : {-1.0f, 1.0f})
+          {
+            glm::vec4 viewCorner(sx * depth * tanHalfFovX, sy * depth * tanHalfFovY, -depth, 1.0f);
+            corners[cornerIndex] = glm::vec3(inverseView * viewCorner);
+            center += corners[cornerIndex];
+            ++cornerIndex;
+          }
+        }
+      }
+      center /= 8.0f;
+
+      // Bounding sphere keeps the cascade size constant while the camera rotates
+      float radius = 0.0f;
+      for (const glm::vec3 &corner : corners)
+      {
+        radius = std::max(radius, glm::length(corner - center));
+      }
+      radius = std::ceil(radius * 16.0f) / 16.0f;
+
+      const glm::mat4 lightView = glm::lookAt(center - lightDir * (radius + m_config.casterMargin), center, lightUp);
+      glm::mat4 lightProjection = glm::ortho(-radius, radius, -radius, radius,
+                                             0.0f, 2.0f * radius + m_config.casterMargin);
+
+      // Snap the origin to whole texels so the cascade does not shimmer as the camera moves
+      const glm::vec4 shadowOrigin = (lightProjection * lightView * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)) *
+                                     (static_cast<float>(m_config.width) * 0.5f);
+      const glm::vec2 roundedOrigin(std::round(shadowOrigin.x), std::round(shadowOrigin.y));
+      const glm::vec2 offset = (roundedOrigin - glm::vec2(shadowOrigin)) * (2.0f / static_cast<float>(m_config.width));
+      lightProjection[3][0] += offset.x;
+      lightProjection[3][1] += offset.y;
+
+      m_cascadeMatrices[cascade] = lightProjection * lightView;
+      m_cascadeSplits[cascade] = splitFar;
+      splitNear = splitFar;
+    }
+  }
+
   void ShadowMapper::BeginShadowPass()
   {
-    if (!m_initialized)
+    BeginCascade(0);
+  }
+
+  void ShadowMapper::BeginCascade(int cascade)
+  {
+    if (!m_initialized || cascade < 0 || cascade >= m_cascadeCount)
     {
       return;
     }
 
     glViewport(0, 0, m_config.width, m_config.height);
     glBindFramebuffer(GL_FRAMEBUFFER, m_depthMapFBO);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_depthMap, 0, cascade);
     glClear(GL_DEPTH_BUFFER_BIT);
   }
 
+  void ShadowMapper::BeginStaticLayer()
+  {
+    if (!m_initialized || m_staticFBO == 0)
+    {
+      return;
+    }
+
+    glViewport(0, 0, m_config.staticResolution, m_config.staticResolution);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_staticFBO);
+    glClear(GL_DEPTH_BUFFER_BIT);
+  }
+
+  void ShadowMapper::MarkStaticLayerValid(uint64_t signature)
+  {
+    m_staticSignature = signature;
+    m_staticValid = true;
+  }
+
   void ShadowMapper::EndShadowPass()
   {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
   }
 
+  void ShadowMapper::BindShadowMaps(Shader &shader, int textureUnit, int staticTextureUnit) const
+  {
+    glActiveTexture(GL_TEXTURE0 + textureUnit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_depthMap);
+    shader.setInt("shadowMap", textureUnit);
+
+    if (m_staticDepthMap != 0 && m_staticValid)
+    {
+      glActiveTexture(GL_TEXTURE0 + staticTextureUnit);
+      glBindTexture(GL_TEXTURE_2D, m_staticDepthMap);
+      shader.setInt("staticShadowMap", staticTextureUnit);
+    }
+  }
+
+  void ShadowMapper::WriteFrameConstants(FrameUniforms::Data &data) const
+  {
+    data.lightPos = m_config.lightPosition;
+    data.cascadeCount = m_cascadeCount;
+    for (int i = 0; i < kMaxShadowCascades; ++i)
+    {
+      data.cascadeMatrices[i] = m_cascadeMatrices[i];
+      data.cascadeSplits[i] = i < m_cascadeCount ? m_cascadeSplits[i] : 0.0f;
+    }
+    data.useStaticShadow = (m_staticDepthMap != 0 && m_staticValid) ? 1 : 0;
+    data.staticLightSpaceMatrix = m_staticMatrix;
+  }
+
+  bool ShadowMapper::SphereInLightVolume(const glm::mat4 &lightSpaceMatrix, const glm::vec3 &center, float radius)
+  {
+    // Orthographic light projection: NDC scale per axis is the length of each matrix row
+    const glm::vec3 ndcCenter = glm::vec3(lightSpaceMatrix * glm::vec4(center, 1.0f));
+    const glm::vec3 ndcRadius(radius * glm::length(glm::vec3(lightSpaceMatrix[0][0], lightSpaceMatrix[1][0], lightSpaceMatrix[2][0])),
+                              radius * glm::length(glm::vec3(lightSpaceMatrix[0][1], lightSpaceMatrix[1][1], lightSpaceMatrix[2][1])),
+                              radius * glm::length(glm::vec3(lightSpaceMatrix[0][2], lightSpaceMatrix[1][2], lightSpaceMatrix[2][2])));
+
+    return ndcCenter.x + ndcRadius.x >= -1.0f && ndcCenter.x - ndcRadius.x <= 1.0f &&
+           ndcCenter.y + ndcRadius.y >= -1.0f && ndcCenter.y - ndcRadius.y <= 1.0f &&
+           ndcCenter.z - ndcRadius.z <= 1.0f;
+  }
+
+  bool ShadowMapper::BoundsInLightVolume(const glm::mat4 &lightSpaceMatrix, const glm::mat4 &modelMatrix,
+                                         const glm::vec3 &boundsMin, const glm::vec3 &boundsMax)
+  {
+    glm::vec3 center;
+    float radius = 0.0f;
+    LodSelector::WorldBoundingSphere(modelMatrix, boundsMin, boundsMax, center, radius);
+    return SphereInLightVolume(lightSpaceMatrix, center, radius);
+  }
+
   void ShadowMapper::SetLightPosition(const glm::vec3 &position)
   {
     m_config.lightPosition = position;
+    m_staticValid = false;
     UpdateLightSpaceMatrix();
   }
 
@@ -106,7 +304,14 @@ namespace mecha
         m_config.target,
         glm::vec3(0.0f, 1.0f, 0.0f));
 
-    m_lightSpaceMatrix = lightProjection * lightView;
+    m_staticMatrix = lightProjection * lightView;
+
+    // Cascaded mode refits every frame in UpdateCascades
+    if (m_cascadeCount <= 1)
+    {
+      m_cascadeMatrices[0] = m_staticMatrix;
+      m_cascadeSplits[0] = FLT_MAX;
+    }
   }
 
   void ShadowMapper::Cleanup()
@@ -123,6 +328,19 @@ namespace mecha
       m_depthMap = 0;
     }
 
+    if (m_staticFBO != 0)
+    {
+      glDeleteFramebuffers(1, &m_staticFBO);
+      m_staticFBO = 0;
+    }
+
+    if (m_staticDepthMap != 0)
+    {
+      glDeleteTextures(1, &m_staticDepthMap);
+      m_staticDepthMap = 0;
+    }
+
+    m_staticValid = false;
     m_initialized = false;
   }
 
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <learnopengl/shader_m.h>
+#include "RenderConstants.h"
+#include "FrameUniforms.h"
 
 namespace mecha
 {
@@ -9,8 +12,9 @@ namespace mecha
   /**
    * @brief Handles shadow mapping setup and rendering
    *
-   * Encapsulates shadow map FBO, depth texture, and light space transformations.
-   * Provides methods for shadow pass rendering and accessing the depth map.
+   * Encapsulates shadow map FBO, depth texture array, and light space transformations.
+   * With a single cascade the map covers the fixed orthographic volume from the config;
+   * with several cascades each layer is fitted to a slice of the camera frustum.
    */
   class ShadowMapper
   {
@@ -27,6 +31,11 @@ namespace mecha
       float orthoTop = 25.0f;
       float nearPlane = 1.0f;
       float farPlane = 50.0f;
+      int cascadeCount = 1;              ///< 1 = fixed ortho volume, 2..kMaxShadowCascades = camera-fitted cascades
+      float cascadeSplitLambda = 0.75f;  ///< Blend between uniform (0) and logarithmic (1) split distribution
+      float cascadeMaxDistance = 600.0f; ///< View distance covered by the last cascade
+      float casterMargin = 250.0f;       ///< Extra depth toward the light so off-screen casters still land in the map
+      unsigned int staticResolution = 0; ///< Cached static caster layer over the ortho volume, 0 disables it
     };
 
     ShadowMapper();
@@ -44,13 +53,58 @@ namespace mecha
     bool Init(const Config &config);
 
     /**
-     * @brief Begin shadow pass rendering
+     * @brief Refit cascades to the current camera
+     *
+     * No-op in single cascade mode.
+     * @param view Camera view matrix
+     * @param projection Camera perspective projection matrix
+     */
+    void UpdateCascades(const glm::mat4 &view, const glm::mat4 &projection);
+
+    /**
+     * @brief Begin shadow pass rendering into the first cascade
      *
      * Binds shadow FBO and sets up viewport. Call this before rendering
      * scene geometry from light's perspective.
      */
     void BeginShadowPass();
 
+    /**
+     * @brief Bind and clear a single cascade layer as the depth target
+     */
+    void BeginCascade(int cascade);
+
+    /**
+     * @brief Whether static casters go to the cached layer instead of the cascades
+     */
+    bool HasStaticLayer() const { return m_staticDepthMap != 0; }
+
+    /**
+     * @brief Check whether the cached static layer must be re-rendered
+     * @param signature Hash of the current static caster set
+     */
+    bool NeedsStaticRefresh(uint64_t signature) const { return HasStaticLayer() && (!m_staticValid || signature != m_staticSignature); }
+
+    /**
+     * @brief Bind and clear the static layer as the depth target
+     */
+    void BeginStaticLayer();
+
+    /**
+     * @brief Mark the static layer as up to date for the given caster set
+     */
+    void MarkStaticLayerValid(uint64_t signature);
+
+    /**
+     * @brief Force the static layer to be re-rendered next frame
+     */
+    void InvalidateStaticLayer() { m_staticValid = false; }
+
+    /**
+     * @brief Get the light space matrix used by the static layer
+     */
+    const glm::mat4 &GetStaticLightSpaceMatrix() const { return m_staticMatrix; }
+
     /**
      * @brief End shadow pass rendering
      *
@@ -59,17 +113,58 @@ namespace mecha
     void EndShadowPass();
 
     /**
-     * @brief Get the light space transformation matrix
+     * @brief Get the light space transformation matrix of the first cascade
      * @return Combined projection * view matrix from light's perspective
      */
-    glm::mat4 GetLightSpaceMatrix() const { return m_lightSpaceMatrix; }
+    glm::mat4 GetLightSpaceMatrix() const { return m_cascadeMatrices[0]; }
+
+    /**
+     * @brief Get the light space matrix of a cascade
+     */
+    const glm::mat4 &GetCascadeMatrix(int cascade) const { return m_cascadeMatrices[cascade]; }
+
+    /**
+     * @brief Get the far view-space distance covered by a cascade
+     */
+    float GetCascadeSplit(int cascade) const { return m_cascadeSplits[cascade]; }
+
+    int GetCascadeCount() const { return m_cascadeCount; }
 
     /**
      * @brief Get the shadow map depth texture ID
-     * @return OpenGL texture ID for the depth map
+     * @return OpenGL texture ID for the depth map array (one layer per cascade)
      */
     unsigned int GetDepthMapTexture() const { return m_depthMap; }
 
+    /**
+     * @brief Bind the cascade array and static layer to a lit shader's samplers
+     *
+     * Matrices and splits travel in the FrameConstants block, see WriteFrameConstants().
+     * @param shader Lit shader (shader must be in use)
+     * @param textureUnit Texture unit for the cascade depth array
+     * @param staticTextureUnit Texture unit for the static layer
+     */
+    void BindShadowMaps(Shader &shader, int textureUnit, int staticTextureUnit = kStaticShadowMapTextureUnit) const;
+
+    /**
+     * @brief Fill the light and shadow fields of the per-frame constants
+     */
+    void WriteFrameConstants(FrameUniforms::Data &data) const;
+
+    /**
+     * @brief Test a world-space sphere against a cascade's light volume
+     *
+     * Only the far side of the depth range culls, casters between the light and
+     * the volume still throw shadows into it.
+     */
+    static bool SphereInLightVolume(const glm::mat4 &lightSpaceMatrix, const glm::vec3 &center, float radius);
+
+    /**
+     * @brief Test model-space bounds placed by a model matrix against a cascade's light volume
+     */
+    static bool BoundsInLightVolume(const glm::mat4 &lightSpaceMatrix, const glm::mat4 &modelMatrix,
+                                    const glm::vec3 &boundsMin, const glm::vec3 &boundsMax);
+
     /**
      * @brief Get shadow map dimensions
      */
@@ -93,7 +188,14 @@ namespace mecha
     Config m_config;
     unsigned int m_depthMapFBO;
     unsigned int m_depthMap;
-    glm::mat4 m_lightSpaceMatrix;
+    int m_cascadeCount;
+    glm::mat4 m_cascadeMatrices[kMaxShadowCascades];
+    float m_cascadeSplits[kMaxShadowCascades];
+    unsigned int m_staticFBO;
+    unsigned int m_staticDepthMap;
+    glm::mat4 m_staticMatrix;
+    uint64_t m_staticSignature;
+    bool m_staticValid;
     bool m_initialized;
   };
 
@@ -0,0 +1,341 @@
+#include "TerrainChunks.h"
+#include "MeshSimplifier.h"
+#include "ShadowMapper.h"
+#include "../placeholder/TerrainPlaceholder.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <unordered_map>
+
+namespace mecha
+{
+
+  namespace
+  {
+    struct ChunkBuilder
+    {
+      int cell{0};
+      unsigned int diffuseTexture{0};
+      std::vector<Vertex> vertices;
+      std::vector<unsigned int> indices;
+      std::unordered_map<uint64_t, unsigned int> remap; // (mesh, source vertex) -> chunk vertex
+    };
+
+    unsigned int FindDiffuseTexture(const Mesh &mesh)
+    {
+      for (const Texture &texture : mesh.textures)
+      {
+        if (texture.type == "texture_diffuse")
+        {
+          return texture.id;
+        }
+      }
+      return 0;
+    }
+
+    // Gribb-Hartmann frustum planes (xyz normal pointing inward, w distance)
+    void ExtractFrustumPlanes(const glm::mat4 &m, glm::vec4 planes[6])
+    {
+      const glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+      const glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+      const glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+      const glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+      planes[0] = row3 + row0;
+      planes[1] = row3 - row0;
+      planes[2] = row3 + row1;
+      planes[3] = row3 - row1;
+      planes[4] = row3 + row2;
+      planes[5] = row3 - row2;
+    }
+
+    bool BoxInFrustum(const glm::vec4 planes[6], const glm::vec3 &boundsMin, const glm::vec3 &boundsMax)
+    {
+      for (int i = 0; i < 6; ++i)
+      {
+        const glm::vec3 normal(planes[i]);
+        // Corner furthest along the plane normal
+        const glm::vec3 positive(normal.x >= 0.0f ? boundsMax.x : boundsMin.x,
+                                 normal.y >= 0.0f ? boundsMax.y : boundsMin.y,
+                                 normal.z >= 0.0f ? boundsMax.z : boundsMin.z);
+        if (glm::dot(normal, positive) + planes[i].w < 0.0f)
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+  } // namespace
+
+  TerrainChunks::TerrainChunks()
+      : m_vao(0),
+        m_vbo(0),
+        m_ebo(0),
+        m_drawnChunks(0),
+        m_drawnTriangles(0)
+  {
+  }
+
+  TerrainChunks::~TerrainChunks()
+  {
+    Release();
+  }
+
+  bool TerrainChunks::Build(const Model &model, const TerrainConfig &terrain, const Config &config)
+  {
+    Release();
+
+    const int chunksPerSide = std::max(config.chunksPerSide, 1);
+    const glm::vec2 gridMin(terrain.boundsMin.x, terrain.boundsMin.z);
+    glm::vec2 cellSize = (glm::vec2(terrain.boundsMax.x, terrain.boundsMax.z) - gridMin) / static_cast<float>(chunksPerSide);
+    cellSize = glm::max(cellSize, glm::vec2(1e-3f));
+    const glm::vec3 normalScale = 1.0f / terrain.modelScale;
+
+    // Bucket source triangles into (cell, texture) chunks, baking the model transform
+    std::vector<ChunkBuilder> builders;
+    std::unordered_map<uint64_t, size_t> builderLookup;
+    for (size_t meshIndex = 0; meshIndex < model.meshes.size(); ++meshIndex)
+    {
+      const Mesh &mesh = model.meshes[meshIndex];
+      const unsigned int diffuseTexture = FindDiffuseTexture(mesh);
+
+      for (size_t tri = 0; tri + 2 < mesh.indices.size(); tri += 3)
+      {
+        glm::vec3 centroid(0.0f);
+        for (int k = 0; k < 3; ++k)
+        {
+          centroid += mesh.vertices[mesh.indices[tri + k]].Position * terrain.modelScale + terrain.modelTranslation;
+        }
+        centroid /= 3.0f;
+
+        const int cx = glm::clamp(static_cast<int>(std::floor((centroid.x - gridMin.x) / cellSize.x)), 0, chunksPerSide - 1);
+        const int cz = glm::clamp(static_cast<int>(std::floor((centroid.z - gridMin.y) / cellSize.y)), 0, chunksPerSide - 1);
+        const int cell = cz * chunksPerSide + cx;
+
+        const uint64_t builderKey = (static_cast<uint64_t>(cell) << 32) | diffuseTexture;
+        auto found = builderLookup.find(builderKey);
+        if (found == builderLookup.end())
+        {
+          found = builderLookup.emplace(builderKey, builders.size()).first;
+          builders.emplace_back();
+          builders.back().cell = cell;
+          builders.back().diffuseTexture = diffuseTexture;
+        }
+        ChunkBuilder &builder = builders[found->second];
+
+        for (int k = 0; k < 3; ++k)
+        {
+          const unsigned int sourceIndex = mesh.indices[tri + k];
+          const uint64_t vertexKey = (static_cast<uint64_t>(meshIndex) << 32) | sourceIndex;
+          auto mapped = builder.remap.find(vertexKey);
+          if (mapped == builder.remap.end())
+          {
+            Vertex vertex = mesh.vertices[sourceIndex];
+            vertex.Position = vertex.Position * terrain.modelScale + terrain.modelTranslation;
+            const glm::vec3 normal = vertex.Normal * normalScale;
+            vertex.Normal = glm::dot(normal, normal) > 0.0f ? glm::normalize(normal) : glm::vec3(0.0f, 1.0f, 0.0f);
+            mapped = builder.remap.emplace(vertexKey, static_cast<unsigned int>(builder.vertices.size())).first;
+            builder.vertices.push_back(vertex);
+          }
+          builder.indices.push_back(mapped->second);
+        }
+      }
+    }
+
+    if (builders.empty())
+    {
+      std::cerr << "[TerrainChunks] Terrain model has no triangles" << std::endl;
+      return false;
+    }
+
+    // Group chunks sharing a texture so DrawVisible binds each texture once per frame
+    std::sort(builders.begin(), builders.end(), [](const ChunkBuilder &a, const ChunkBuilder &b)
+              { return a.diffuseTexture != b.diffuseTexture ? a.diffuseTexture < b.diffuseTexture : a.cell < b.cell; });
+
+    // Chunks only need position, normal and UV; the full Vertex carries tangents and skinning data
+    const bool halfTexCoords = std::all_of(builders.begin(), builders.end(), [](const ChunkBuilder &builder)
+                                           { return VertexLayout::fitsHalfTexCoords(builder.vertices); });
+    const VertexLayout layout = VertexLayout::positionNormalUv(halfTexCoords);
+
+    std::vector<unsigned char> vertexData;
+    unsigned int vertexCount = 0;
+    std::vector<unsigned int> indices;
+    std::vector<size_t> levelTriangles(static_cast<size_t>(std::max(config.lodLevels, 1)), 0);
+    m_chunks.reserve(builders.size());
+
+    for (ChunkBuilder &builder : builders)
+    {
+      builder.remap.clear();
+
+      std::vector<std::vector<unsigned int>> chain;
+      chain.push_back(std::move(builder.indices));
+      for (int level = 1; level < config.lodLevels; ++level)
+      {
+        const std::vector<unsigned int> &previous = chain.back();
+        const size_t previousTriangles = previous.size() / 3;
+        if (previousTriangles <= config.minTriangles)
+        {
+          break;
+        }
+
+        size_t targetTriangles = static_cast<size_t>(static_cast<float>(previousTriangles) * config.reductionPerLevel);
+        targetTriangles = std::max(targetTriangles, config.minTriangles);
+        std::vector<unsigned int> reduced = SimplifyMesh(builder.vertices, previous, targetTriangles * 3);
+        if (reduced.empty() || reduced.size() >= previous.size() * 9 / 10)
+        {
+          break;
+        }
+        chain.push_back(std::move(reduced));
+      }
+
+      Chunk chunk;
+      chunk.diffuseTexture = builder.diffuseTexture;
+      chunk.boundsMin = builder.vertices.front().Position;
+      chunk.boundsMax = builder.vertices.front().Position;
+      const unsigned int baseVertex = vertexCount;
+      for (const Vertex &vertex : builder.vertices)
+      {
+        chunk.boundsMin = glm::min(chunk.boundsMin, vertex.Position);
+        chunk.boundsMax = glm::max(chunk.boundsMax, vertex.Position);
+      }
+      const std::vector<unsigned char> packed = layout.pack(builder.vertices);
+      vertexData.insert(vertexData.end(), packed.begin(), packed.end());
+      vertexCount += static_cast<unsigned int>(builder.vertices.size());
+      chunk.center = (chunk.boundsMin + chunk.boundsMax) * 0.5f;
+      chunk.radius = glm::length(chunk.boundsMax - chunk.boundsMin) * 0.5f;
+
+      for (size_t level = 0; level < chain.size(); ++level)
+      {
+        chunk.lods.push_back(MeshLod{static_cast<unsigned int>(indices.size()), static_cast<unsigned int>(chain[level].size())});
+        for (unsigned int index : chain[level])
+        {
+          indices.push_back(baseVertex + index);
+        }
+        levelTriangles[level] += chain[level].size() / 3;
+      }
+
+      m_chunks.push_back(std::move(chunk));
+    }
+
+    glGenVertexArrays(1, &m_vao);
+    glGenBuffers(1, &m_vbo);
+    glGenBuffers(1, &m_ebo);
+
+    glBindVertexArray(m_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertexData.size(), vertexData.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    layout.apply();
+    glBindVertexArray(0);
+
+    std::cout << "[TerrainChunks] Built " << m_chunks.size() << " chunk(s) on a " << chunksPerSide << "x" << chunksPerSide
+              << " grid, " << vertexCount << " vertices at " << layout.stride << " bytes, triangles per level:";
+    for (size_t triangles : levelTriangles)
+    {
+      std::cout << " " << triangles;
+    }
+    std::cout << std::endl;
+    return true;
+  }
+
+  void TerrainChunks::Release()
+  {
+    if (m_ebo != 0)
+    {
+      glDeleteBuffers(1, &m_ebo);
+      m_ebo = 0;
+    }
+    if (m_vbo != 0)
+    {
+      glDeleteBuffers(1, &m_vbo);
+      m_vbo = 0;
+    }
+    if (m_vao != 0)
+    {
+      glDeleteVertexArrays(1, &m_vao);
+      m_vao = 0;
+    }
+    m_chunks.clear();
+  }
+
+  void TerrainChunks::UpdateLods(const glm::mat4 &projection, const glm::vec3 &viewPos)
+  {
+    for (Chunk &chunk : m_chunks)
+    {
+      chunk.lod.Update(projection, viewPos, chunk.center, chunk.radius, static_cast<int>(chunk.lods.size()));
+    }
+  }
+
+  void TerrainChunks::DrawVisible(Shader &shader, const glm::mat4 &viewProjection)
+  {
+    m_drawnChunks = 0;
+    m_drawnTriangles = 0;
+    if (!IsReady())
+    {
+      return;
+    }
+
+    glm::vec4 planes[6];
+    ExtractFrustumPlanes(viewProjection, planes);
+
+    shader.setMat4("model", glm::mat4(1.0f));
+    shader.setInt("texture_diffuse1", 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindVertexArray(m_vao);
+
+    bool textureBound = false;
+    unsigned int boundTexture = 0;
+    for (const Chunk &chunk : m_chunks)
+    {
+      if (!BoxInFrustum(planes, chunk.boundsMin, chunk.boundsMax))
+      {
+        continue;
+      }
+
+      if (!textureBound || chunk.diffuseTexture != boundTexture)
+      {
+        shader.setBool("useAlbedoTexture", chunk.diffuseTexture != 0);
+        glBindTexture(GL_TEXTURE_2D, chunk.diffuseTexture);
+        boundTexture = chunk.diffuseTexture;
+        textureBound = true;
+      }
+
+      const int level = chunk.lod.Level();
+      DrawChunk(chunk, level);
+      ++m_drawnChunks;
+      m_drawnTriangles += chunk.lods[level].indexCount / 3;
+    }
+
+    glBindVertexArray(0);
+  }
+
+  void TerrainChunks::DrawDepth(Shader &shader, const glm::mat4 &lightSpaceMatrix, bool fullDetail)
+  {
+    if (!IsReady())
+    {
+      return;
+    }
+
+    shader.setMat4("model", glm::mat4(1.0f));
+    glBindVertexArray(m_vao);
+    for (const Chunk &chunk : m_chunks)
+    {
+      if (!ShadowMapper::SphereInLightVolume(lightSpaceMatrix, chunk.center, chunk.radius))
+      {
+        continue;
+      }
+      DrawChunk(chunk, fullDetail ? 0 : chunk.lod.Level());
+    }
+    glBindVertexArray(0);
+  }
+
+  void TerrainChunks::DrawChunk(const Chunk &chunk, int level) const
+  {
+    const MeshLod &range = chunk.lods[std::min(level, static_cast<int>(chunk.lods.size()) - 1)];
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(range.indexCount), GL_UNSIGNED_INT,
+                   (void *)(static_cast<size_t>(range.indexOffset) * sizeof(unsigned int)));
+  }
+
+} // namespace mecha
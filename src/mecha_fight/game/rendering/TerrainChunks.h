@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include <learnopengl/shader_m.h>
+#include <learnopengl/model.h>
+#include "LodSelector.h"
+#include "RenderConstants.h"
+
+namespace mecha
+{
+
+  struct TerrainConfig;
+
+  /**
+   * @brief Terrain model split into a grid of world-space chunks with their own LOD chains
+   *
+   * Built once at load. Triangles are bucketed by centroid into a chunksPerSide^2 grid (and by
+   * diffuse texture), baked with the terrain model transform and simplified per chunk. The
+   * simplifier locks open edges, so chunk borders are identical at every level and neighbours
+   * never crack whichever levels they pick. All chunks share one compact vertex/index buffer;
+   * texture state is resolved at build time and chunks are ordered to minimise rebinding.
+   */
+  class TerrainChunks
+  {
+  public:
+    struct Config
+    {
+      int chunksPerSide = kTerrainChunksPerSide;
+      int lodLevels = kTerrainLodLevels; ///< Including full detail
+      float reductionPerLevel = 0.25f;   ///< Triangle ratio kept from one level to the next
+      size_t minTriangles = 32;          ///< Chunks below this size are not reduced further
+    };
+
+    TerrainChunks();
+    ~TerrainChunks();
+
+    // Non-copyable
+    TerrainChunks(const TerrainChunks &) = delete;
+    TerrainChunks &operator=(const TerrainChunks &) = delete;
+
+    /**
+     * @brief Split, simplify and upload the terrain model
+     * @param model Terrain model (CPU vertex data must still be present)
+     * @param terrain Placement and bounds of the model in the world
+     * @return true if at least one chunk was built
+     */
+    bool Build(const Model &model, const TerrainConfig &terrain, const Config &config);
+    bool Build(const Model &model, const TerrainConfig &terrain) { return Build(model, terrain, Config{}); }
+
+    void Release();
+
+    bool IsReady() const { return m_vao != 0; }
+
+    /**
+     * @brief Pick every chunk's level for the current camera; call once per frame before any pass
+     */
+    void UpdateLods(const glm::mat4 &projection, const glm::vec3 &viewPos);
+
+    /**
+     * @brief Draw the chunks inside the camera frustum with a lit shader (shader must be in use)
+     *
+     * Sets "model", "texture_diffuse1" and "useAlbedoTexture" and leaves texture unit 0 active.
+     */
+    void DrawVisible(Shader &shader, const glm::mat4 &viewProjection);
+
+    /**
+     * @brief Draw the chunks inside a light volume into the bound depth target
+     * @param fullDetail Ignore the camera LOD, for layers that outlive the current camera
+     */
+    void DrawDepth(Shader &shader, const glm::mat4 &lightSpaceMatrix, bool fullDetail);
+
+    int GetChunkCount() const { return static_cast<int>(m_chunks.size()); }
+
+    /**
+     * @brief Chunks and triangles submitted by the last DrawVisible call
+     */
+    int GetDrawnChunkCount() const { return m_drawnChunks; }
+    size_t GetDrawnTriangleCount() const { return m_drawnTriangles; }
+
+  private:
+    struct Chunk
+    {
+      glm::vec3 boundsMin{0.0f};
+      glm::vec3 boundsMax{0.0f};
+      glm::vec3 center{0.0f};
+      float radius{0.0f};
+      unsigned int diffuseTexture{0};
+      std::vector<MeshLod> lods;
+      LodSelector lod;
+    };
+
+    void DrawChunk(const Chunk &chunk, int level) const;
+
+    std::vector<Chunk> m_chunks;
+    unsigned int m_vao;
+    unsigned int m_vbo;
+    unsigned int m_ebo;
+    int m_drawnChunks;
+    size_t m_drawnTriangles;
+  };
+
+} // namespace mecha
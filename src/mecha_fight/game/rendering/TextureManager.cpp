@@ -0,0 +1,585 @@
+#include "TextureManager.h"
+#include "../core/CacheFile.h"
+#include "../core/MappedFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+// S3TC is an extension rather than core GL 3.3, so glad does not define its enums
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
+namespace mecha
+{
+
+  namespace
+  {
+    constexpr char kCacheMagic[4] = {'M', 'T', 'E', 'X'};
+    // Bump whenever the header, the mip filter or the block encoder changes
+    constexpr uint32_t kTextureCacheVersion = 1;
+    constexpr size_t kDefaultVramBudget = size_t(512) * 1024 * 1024;
+
+    struct CacheHeader
+    {
+      char magic[4];
+      uint32_t version;
+      uint32_t format; // BlockFormat
+      int32_t width;
+      int32_t height;
+      int32_t components;
+      uint32_t levelCount;
+    };
+
+    const char *FormatName(bool compressed, BlockFormat format)
+    {
+      if (!compressed)
+      {
+        return "uncompressed";
+      }
+      switch (format)
+      {
+      case BlockFormat::BC1:
+        return "BC1";
+      case BlockFormat::BC3:
+        return "BC3";
+      case BlockFormat::BC4:
+        return "BC4";
+      case BlockFormat::BC5:
+        return "BC5";
+      }
+      return "?";
+    }
+
+    // 2x2 box filter; odd edges reuse the last row/column
+    std::vector<unsigned char> Downsample(const std::vector<unsigned char> &src, int width, int height, int components)
+    {
+      const int outWidth = std::max(1, width / 2);
+      const int outHeight = std::max(1, height / 2);
+      std::vector<unsigned char> out(static_cast<size_t>(outWidth) * outHeight * components);
+      for (int y = 0; y < outHeight; ++y)
+      {
+        const size_t row0 = static_cast<size_t>(std::min(y * 2, height - 1)) * width;
+        const size_t row1 = static_cast<size_t>(std::min(y * 2 + 1, height - 1)) * width;
+        for (int x = 0; x < outWidth; ++x)
+        {
+          const size_t col0 = static_cast<size_t>(std::min(x * 2, width - 1));
+          const size_t col1 = static_cast<size_t>(std::min(x * 2 + 1, width - 1));
+          unsigned char *dst = out.data() + (static_cast<size_t>(y) * outWidth + x) * components;
+          for (int c = 0; c < components; ++c)
+          {
+            const int sum = src[(row0 + col0) * components + c] + src[(row0 + col1) * components + c] +
+                            src[(row1 + col0) * components + c] + src[(row1 + col1) * components + c];
+            dst[c] = static_cast<unsigned char>((sum + 2) / 4);
+          }
+        }
+      }
+      return out;
+    }
+
+    bool HasExtension(const char *name)
+    {
+      GLint count = 0;
+      glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+      for (GLint i = 0; i < count; ++i)
+      {
+        const char *extension = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+        if (extension && std::strcmp(extension, name) == 0)
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+  } // namespace
+
+  TextureManager::TextureManager()
+      : m_vramBudget(kDefaultVramBudget), m_supportsS3tc(false), m_supportsSrgbS3tc(false)
+  {
+  }
+
+  TextureManager::~TextureManager()
+  {
+    Clear();
+  }
+
+  bool TextureManager::Initialize()
+  {
+    m_supportsS3tc = HasExtension("GL_EXT_texture_compression_s3tc");
+    m_supportsSrgbS3tc = m_supportsS3tc && HasExtension("GL_EXT_texture_sRGB");
+    std::cout << "[TextureManager] S3TC " << (m_supportsS3tc ? "available" : "unavailable, colour textures stay uncompressed")
+              << std::endl;
+    return true;
+  }
+
+  unsigned int TextureManager::RequestFile(const std::string &path, bool gamma)
+  {
+    MappedFile file(path);
+    if (!file.Data())
+    {
+      std::cerr << "[TextureManager] Texture failed to load at path: " << path << std::endl;
+      return 0;
+    }
+
+    const uint64_t hash = Fnv1a(kFnv1aOffset, file.Data(), file.Size());
+
+    bool owner = false;
+    const unsigned int handle = Acquire(hash, path, gamma, owner);
+    if (!owner)
+    {
+      return handle;
+    }
+
+    // Other requests of this content wait in Resolve until the owner publishes, so every way out publishes
+    try
+    {
+      if (LoadCached(handle, hash))
+      {
+        return handle;
+      }
+
+      int width = 0, height = 0, components = 0;
+      std::unique_ptr<unsigned char, void (*)(void *)> pixels(
+          stbi_load_from_memory(file.Data(), static_cast<int>(file.Size()), &width, &height, &components, 0),
+          stbi_image_free);
+      if (!pixels)
+      {
+        std::cerr << "[TextureManager] Could not decode " << path << ": " << stbi_failure_reason() << std::endl;
+        Publish(handle, false, BlockFormat::BC1, 0, 0, 0, {}, false);
+        return handle;
+      }
+
+      Prepare(handle, hash, pixels.get(), width, height, components);
+    }
+    catch (const std::exception &e)
+    {
+      std::cerr << "[TextureManager] Failed to prepare " << path << ": " << e.what() << std::endl;
+      Publish(handle, false, BlockFormat::BC1, 0, 0, 0, {}, false);
+    }
+    return handle;
+  }
+
+  unsigned int TextureManager::RequestPixels(const std::string &name, const unsigned char *pixels, int width, int height,
+                                             int components, bool gamma)
+  {
+    if (!pixels || width <= 0 || height <= 0 || components < 1 || components > 4)
+    {
+      return 0;
+    }
+
+    const int32_t shape[3] = {width, height, components};
+    uint64_t hash = Fnv1a(kFnv1aOffset, shape, sizeof(shape));
+    hash = Fnv1a(hash, pixels, static_cast<size_t>(width) * height * components);
+
+    bool owner = false;
+    const unsigned int handle = Acquire(hash, name, gamma, owner);
+    if (!owner)
+    {
+      return handle;
+    }
+
+    try
+    {
+      if (!LoadCached(handle, hash))
+      {
+        Prepare(handle, hash, pixels, width, height, components);
+      }
+    }
+    catch (const std::exception &e)
+    {
+      std::cerr << "[TextureManager] Failed to prepare " << name << ": " << e.what() << std::endl;
+      Publish(handle, false, BlockFormat::BC1, 0, 0, 0, {}, false);
+    }
+    return handle;
+  }
+
+  unsigned int TextureManager::Resolve(unsigned int handle)
+  {
+    Entry *entry = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if (handle == 0 || handle > m_entries.size())
+      {
+        return 0;
+      }
+      entry = m_entries[handle - 1].get();
+      // Another model's worker may still be preparing shared content
+      m_entryReady.wait(lock, [entry]
+                        { return entry->ready; });
+    }
+
+    // Workers are done with a ready entry; only the GL thread changes it from here on
+    if (entry->textureId == 0 && !entry->levels.empty())
+    {
+      const unsigned int textureId = Upload(*entry);
+      size_t gpuBytes = 0;
+      for (const std::vector<unsigned char> &level : entry->levels)
+      {
+        gpuBytes += level.size();
+      }
+
+      std::lock_guard<std::mutex> lock(m_mutex);
+      entry->textureId = textureId;
+      entry->gpuBytes = gpuBytes;
+      entry->levels.clear();
+      entry->levels.shrink_to_fit();
+    }
+    return entry->textureId;
+  }
+
+  unsigned int TextureManager::Acquire(uint64_t hash, const std::string &name, bool gamma, bool &owner)
+  {
+    // sRGB and linear uses of the same content need separate GL textures
+    const uint64_t key = gamma ? (hash ^ 0x9E3779B97F4A7C15ull) : hash;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_handles.find(key);
+    if (it != m_handles.end())
+    {
+      owner = false;
+      m_entries[it->second - 1]->requests++;
+      return it->second;
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->hash = hash;
+    entry->name = name;
+    entry->gamma = gamma;
+    entry->requests = 1;
+    m_entries.push_back(std::move(entry));
+    const unsigned int handle = static_cast<unsigned int>(m_entries.size());
+    m_handles.emplace(key, handle);
+    owner = true;
+    return handle;
+  }
+
+  void TextureManager::Publish(unsigned int handle, bool compressed, BlockFormat format, int width, int height,
+                               int components, std::vector<std::vector<unsigned char>> levels, bool fromDisk)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      Entry &entry = *m_entries[handle - 1];
+      entry.compressed = compressed;
+      entry.format = format;
+      entry.width = width;
+      entry.height = height;
+      entry.components = components;
+      entry.levels = std::move(levels);
+      entry.fromDisk = fromDisk;
+      entry.ready = true;
+    }
+    m_entryReady.notify_all();
+  }
+
+  void TextureManager::Prepare(unsigned int handle, uint64_t hash, const unsigned char *pixels, int width, int height,
+                               int components)
+  {
+    bool gamma = false;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      gamma = m_entries[handle - 1]->gamma;
+    }
+
+    std::vector<std::vector<unsigned char>> levels;
+    levels.emplace_back(pixels, pixels + static_cast<size_t>(width) * height * components);
+    for (int w = width, h = height; w > 1 || h > 1; w = std::max(1, w / 2), h = std::max(1, h / 2))
+    {
+      levels.push_back(Downsample(levels.back(), w, h, components));
+    }
+
+    BlockFormat format = BlockFormat::BC1;
+    const bool compressed = ChooseFormat(pixels, static_cast<size_t>(width) * height, components, gamma, format);
+    if (compressed)
+    {
+      int w = width;
+      int h = height;
+      for (std::vector<unsigned char> &level : levels)
+      {
+        level = CompressBlocks(format, level.data(), w, h, components);
+        w = std::max(1, w / 2);
+        h = std::max(1, h / 2);
+      }
+      SaveCached(hash, format, width, height, components, levels);
+    }
+
+    Publish(handle, compressed, format, width, height, components, std::move(levels), false);
+  }
+
+  bool TextureManager::ChooseFormat(const unsigned char *pixels, size_t texelCount, int components, bool gamma,
+                                    BlockFormat &format) const
+  {
+    switch (components)
+    {
+    case 1:
+      format = BlockFormat::BC4;
+      return !gamma; // RGTC has no sRGB variant
+    case 2:
+      format = BlockFormat::BC5;
+      return !gamma;
+    case 3:
+      format = BlockFormat::BC1;
+      break;
+    default:
+    {
+      // Opaque RGBA images lose nothing by dropping to BC1 at half the size of BC3
+      bool opaque = true;
+      for (size_t i = 0; i < texelCount && opaque; ++i)
+      {
+        opaque = pixels[i * 4 + 3] == 255;
+      }
+      format = opaque ? BlockFormat::BC1 : BlockFormat::BC3;
+      break;
+    }
+    }
+    return gamma ? m_supportsSrgbS3tc : m_supportsS3tc;
+  }
+
+  std::string TextureManager::GetCachePath(uint64_t hash) const
+  {
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << hash << ".mtex";
+    return (std::filesystem::path(m_cacheDirectory) / name.str()).string();
+  }
+
+  bool TextureManager::LoadCached(unsigned int handle, uint64_t hash)
+  {
+    if (m_cacheDirectory.empty())
+    {
+      return false;
+    }
+
+    const std::string cachePath = GetCachePath(hash);
+    MappedFile file(cachePath);
+    if (!file.Data() || file.Size() < sizeof(CacheHeader))
+    {
+      return false;
+    }
+
+    CacheHeader header{};
+    std::memcpy(&header, file.Data(), sizeof(CacheHeader));
+    const BlockFormat format = static_cast<BlockFormat>(header.format);
+    if (std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) != 0 || header.version != kTextureCacheVersion ||
+        header.format > static_cast<uint32_t>(BlockFormat::BC5) || header.width <= 0 || header.height <= 0)
+    {
+      std::cout << "[TextureManager] Stale cache " << cachePath << ", re-encoding" << std::endl;
+      return false;
+    }
+
+    bool gamma = false;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      gamma = m_entries[handle - 1]->gamma;
+    }
+    const bool colour = format == BlockFormat::BC1 || format == BlockFormat::BC3;
+    if ((colour && !(gamma ? m_supportsSrgbS3tc : m_supportsS3tc)) || (!colour && gamma))
+    {
+      return false;
+    }
+
+    // Levels are stored back to back; every size is implied by the header
+    std::vector<std::vector<unsigned char>> levels(header.levelCount);
+    size_t offset = sizeof(CacheHeader);
+    int w = header.width;
+    int h = header.height;
+    for (std::vector<unsigned char> &level : levels)
+    {
+      const size_t size = GetCompressedSize(format, w, h);
+      if (offset + size > file.Size())
+      {
+        std::cerr << "[TextureManager] Truncated cache " << cachePath << ", re-encoding" << std::endl;
+        return false;
+      }
+      level.assign(file.Data() + offset, file.Data() + offset + size);
+      offset += size;
+      w = std::max(1, w / 2);
+      h = std::max(1, h / 2);
+    }
+
+    Publish(handle, true, format, header.width, header.height, header.components, std::move(levels), true);
+    return true;
+  }
+
+  void TextureManager::SaveCached(uint64_t hash, BlockFormat format, int width, int height, int components,
+                                  const std::vector<std::vector<unsigned char>> &levels) const
+  {
+    if (m_cacheDirectory.empty())
+    {
+      return;
+    }
+
+    CacheHeader header{};
+    std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+    header.version = kTextureCacheVersion;
+    header.format = static_cast<uint32_t>(format);
+    header.width = width;
+    header.height = height;
+    header.components = components;
+    header.levelCount = static_cast<uint32_t>(levels.size());
+
+    // The sRGB and linear entries of one image share the file; the writer's per-thread temporaries keep them apart
+    std::vector<FileChunk> chunks{{&header, sizeof(header)}};
+    for (const std::vector<unsigned char> &level : levels)
+    {
+      chunks.push_back({level.data(), level.size()});
+    }
+
+    const std::string cachePath = GetCachePath(hash);
+    std::string error;
+    if (!WriteFileAtomically(cachePath, chunks, error))
+    {
+      std::cerr << "[TextureManager] Could not save " << cachePath << ": " << error << std::endl;
+    }
+  }
+
+  unsigned int TextureManager::Upload(const Entry &entry) const
+  {
+    unsigned int id = 0;
+    glGenTextures(1, &id);
+    glBindTexture(GL_TEXTURE_2D, id);
+    GLint previousUnpackAlignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &previousUnpackAlignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    GLenum internalFormat = GL_RGBA;
+    GLenum format = GL_RGBA;
+    if (entry.compressed)
+    {
+      switch (entry.format)
+      {
+      case BlockFormat::BC1:
+        internalFormat = entry.gamma ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        break;
+      case BlockFormat::BC3:
+        internalFormat = entry.gamma ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        break;
+      case BlockFormat::BC4:
+        internalFormat = GL_COMPRESSED_RED_RGTC1;
+        break;
+      case BlockFormat::BC5:
+        internalFormat = GL_COMPRESSED_RG_RGTC2;
+        break;
+      }
+    }
+    else
+    {
+      static const GLenum kFormats[4] = {GL_RED, GL_RG, GL_RGB, GL_RGBA};
+      format = kFormats[entry.components - 1];
+      internalFormat = format;
+      if (entry.components == 3)
+      {
+        internalFormat = entry.gamma ? GL_SRGB : GL_RGB;
+      }
+      else if (entry.components == 4)
+      {
+        internalFormat = entry.gamma ? GL_SRGB_ALPHA : GL_RGBA;
+      }
+    }
+
+    int w = entry.width;
+    int h = entry.height;
+    for (size_t level = 0; level < entry.levels.size(); ++level)
+    {
+      const std::vector<unsigned char> &data = entry.levels[level];
+      if (entry.compressed)
+      {
+        glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), internalFormat, w, h, 0,
+                               static_cast<GLsizei>(data.size()), data.data());
+      }
+      else
+      {
+        glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), internalFormat, w, h, 0, format, GL_UNSIGNED_BYTE, data.data());
+      }
+      w = std::max(1, w / 2);
+      h = std::max(1, h / 2);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(entry.levels.size()) - 1);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, previousUnpackAlignment);
+    return id;
+  }
+
+  size_t TextureManager::GetVramBytes() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t total = 0;
+    for (const auto &entry : m_entries)
+    {
+      total += entry->gpuBytes;
+    }
+    return total;
+  }
+
+  void TextureManager::PrintVramReport() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t total = 0;
+    size_t uncompressedEquivalent = 0;
+    int uploaded = 0;
+    int fromDisk = 0;
+    int sharedRequests = 0;
+    std::unordered_map<std::string, int> formatCounts;
+    for (const auto &entry : m_entries)
+    {
+      sharedRequests += entry->requests - 1;
+      if (entry->textureId == 0)
+      {
+        continue;
+      }
+      ++uploaded;
+      fromDisk += entry->fromDisk ? 1 : 0;
+      total += entry->gpuBytes;
+      // RGBA8 with a full mip chain is roughly 4/3 of the base level
+      uncompressedEquivalent += static_cast<size_t>(entry->width) * entry->height * 4 * 4 / 3;
+      formatCounts[FormatName(entry->compressed, entry->format)]++;
+    }
+
+    std::cout << "[TextureManager] " << uploaded << " texture(s), " << sharedRequests << " duplicate request(s) shared, "
+              << fromDisk << " from disk cache" << std::endl;
+    for (const auto &formatCount : formatCounts)
+    {
+      std::cout << "  " << std::left << std::setw(14) << formatCount.first << std::right << std::setw(6) << formatCount.second
+                << std::endl;
+    }
+    std::cout << "  VRAM " << total / 1024 << " KiB (RGBA8 would be " << uncompressedEquivalent / 1024 << " KiB), budget "
+              << m_vramBudget / 1024 << " KiB" << std::endl;
+    if (total > m_vramBudget)
+    {
+      std::cerr << "[TextureManager] Texture memory exceeds the budget by " << (total - m_vramBudget) / 1024 << " KiB"
+                << std::endl;
+    }
+  }
+
+  void TextureManager::Clear()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto &entry : m_entries)
+    {
+      if (entry->textureId != 0)
+      {
+        glDeleteTextures(1, &entry->textureId);
+      }
+    }
+    m_entries.clear();
+    m_handles.clear();
+  }
+
+} // namespace mecha
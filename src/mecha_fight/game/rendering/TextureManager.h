@@ -0,0 +1,124 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <learnopengl/model.h>
+#include "BlockCompression.h"
+
+namespace mecha
+{
+
+  /**
+   * @brief Process-wide texture store shared by every deferred model, keyed by content hash
+   *
+   * Model loader workers hand it image files or embedded pixels; the source bytes are hashed,
+   * so the same image referenced by several models (or under different names) is decoded and
+   * uploaded once. Decoding, CPU mipmap generation and block compression all happen on the
+   * requesting worker. Compressed mip chains are written to <cacheDir>/<hash>.mtex and loaded
+   * directly on later launches, skipping the decode entirely. Resolve() uploads on the GL thread.
+   */
+  class TextureManager : public TextureProvider
+  {
+  public:
+    TextureManager();
+    ~TextureManager() override;
+
+    // Non-copyable
+    TextureManager(const TextureManager &) = delete;
+    TextureManager &operator=(const TextureManager &) = delete;
+
+    /**
+     * @brief Query compressed format support; call on the GL thread before any model load
+     * @return true (colour textures stay uncompressed when S3TC is missing)
+     */
+    bool Initialize();
+
+    /**
+     * @brief Directory for compressed mip chains; empty (the default) disables the disk cache
+     */
+    void SetCacheDirectory(const std::string &directory) { m_cacheDirectory = directory; }
+
+    /**
+     * @brief Texture memory PrintVramReport warns about exceeding
+     */
+    void SetVramBudget(size_t bytes) { m_vramBudget = bytes; }
+
+    // TextureProvider; Request* are thread-safe, Resolve must run on the GL thread
+    unsigned int RequestFile(const std::string &path, bool gamma) override;
+    unsigned int RequestPixels(const std::string &name, const unsigned char *pixels, int width, int height, int components,
+                               bool gamma) override;
+    unsigned int Resolve(unsigned int handle) override;
+
+    /**
+     * @brief Bytes of texture memory held by uploaded textures, mip chains included
+     */
+    size_t GetVramBytes() const;
+
+    /**
+     * @brief Log texture count, format mix, dedupe hits and VRAM use against the budget
+     */
+    void PrintVramReport() const;
+
+    /**
+     * @brief Delete every GL texture; handles from before are invalid afterwards
+     */
+    void Clear();
+
+  private:
+    struct Entry
+    {
+      uint64_t hash = 0;
+      std::string name;
+      bool gamma = false;
+      bool compressed = false; ///< Otherwise levels hold raw texels with the source channel count
+      BlockFormat format = BlockFormat::BC1;
+      int width = 0;
+      int height = 0;
+      int components = 0;
+      std::vector<std::vector<unsigned char>> levels; ///< CPU mip chain until uploaded
+      bool ready = false;                             ///< Levels filled (or failed) by the owning worker
+      bool fromDisk = false;
+      unsigned int textureId = 0;
+      size_t gpuBytes = 0;
+      int requests = 0; ///< Times the content was asked for, across all models
+    };
+
+    /**
+     * @brief Find or create the entry for a hash; owner is set when the caller must prepare it and publish
+     * it, failures included, since Resolve waits for that
+     */
+    unsigned int Acquire(uint64_t hash, const std::string &name, bool gamma, bool &owner);
+    void Publish(unsigned int handle, bool compressed, BlockFormat format, int width, int height, int components,
+                 std::vector<std::vector<unsigned char>> levels, bool fromDisk);
+
+    /**
+     * @brief Build the mip chain of decoded pixels and compress it if the GL supports the format
+     */
+    void Prepare(unsigned int handle, uint64_t hash, const unsigned char *pixels, int width, int height, int components);
+    bool ChooseFormat(const unsigned char *pixels, size_t texelCount, int components, bool gamma, BlockFormat &format) const;
+
+    bool LoadCached(unsigned int handle, uint64_t hash);
+    void SaveCached(uint64_t hash, BlockFormat format, int width, int height, int components,
+                    const std::vector<std::vector<unsigned char>> &levels) const;
+    std::string GetCachePath(uint64_t hash) const;
+
+    unsigned int Upload(const Entry &entry) const;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_entryReady;
+    std::vector<std::unique_ptr<Entry>> m_entries; ///< Handle = index + 1
+    std::unordered_map<uint64_t, unsigned int> m_handles;
+
+    std::string m_cacheDirectory;
+    size_t m_vramBudget;
+    bool m_supportsS3tc;
+    bool m_supportsSrgbS3tc;
+  };
+
+} // namespace mecha
@@ -11,6 +11,8 @@
 #include "../entities/MechaPlayer.h"
 #include "../entities/Enemy.h"
 #include "../rendering/RenderConstants.h"
+#include "../rendering/ShadowMapper.h"
+#include "../rendering/LodSelector.h"
 #include "../audio/SoundManager.h"
 #include <learnopengl/model.h>
 #include <learnopengl/shader_m.h>
@@ -22,6 +24,7 @@ namespace mecha
     constexpr float kMissileSpeed = 25.0f;
     constexpr float kMissileHomingStrength = 15.0f; // How strongly missile turns toward target (increased from 8)
     constexpr float kMissileMaxTurnRate = 280.0f;  // Degrees per second max turn rate (increased from 180)
+    constexpr float kMissileTerrainClearance = 0.35f; // Detonate this far above the ground
     constexpr float kMissileExplosionRadius = 8.0f;
     constexpr float kMissileExplosionDamage = 80.0f;
     constexpr float kMissileDirectDamage = 45.0f;
@@ -115,7 +118,7 @@ namespace mecha
     {
       if (missile.active && !missile.soundHandle_ && params->soundManager)
       {
-        missile.soundHandle_ = params->soundManager->PlaySound3D("MISSILE_LAUNCH", missile.pos);
+        missile.soundHandle_ = params->soundManager->PlaySound3D(params->sounds.missileLaunch, missile.pos);
       }
     }
 
@@ -259,14 +262,19 @@ namespace mecha
       }
     }
 
-    // Update position
-    missile.pos += missile.vel * deltaTime;
+    // Update position, sweeping the step against the terrain so fast missiles cannot tunnel
+    glm::vec3 step = missile.vel * deltaTime;
+    glm::vec3 previousPos = missile.pos;
+    missile.pos += step;
 
-    if (params && params->terrainSampler.callback)
+    if (params && missile.vel.y < -1.0f)
     {
-      float terrainHeight = params->terrainSampler(missile.pos.x, missile.pos.z);
-      if (missile.pos.y <= terrainHeight + 0.35f && missile.vel.y < -1.0f)
+      float stepLength = glm::length(step);
+      float hitDistance = 0.0f;
+      glm::vec3 sweepOrigin = previousPos - glm::vec3(0.0f, kMissileTerrainClearance, 0.0f);
+      if (stepLength > 0.0f && params->terrain.Raycast(sweepOrigin, step, stepLength, hitDistance))
       {
+        missile.pos = previousPos + step * (hitDistance / stepLength);
         ExplodeMissile(missile, params);
         return;
       }
@@ -382,7 +390,7 @@ namespace mecha
           params->soundManager->StopSound(missile.soundHandle_);
           missile.soundHandle_ = nullptr;
         }
-        params->soundManager->PlaySound3D("MISSILE_EXPLOSION", missile.pos);
+        params->soundManager->PlaySound3D(params->sounds.missileExplosion, missile.pos);
       }
     }
     missile.active = false;
@@ -416,24 +424,11 @@ namespace mecha
     if (missileModel_ && missileShader_)
     {
       missileShader_->use();
-      missileShader_->setMat4("projection", ctx.projection);
-      missileShader_->setMat4("view", ctx.view);
-      missileShader_->setMat4("lightSpaceMatrix", ctx.lightSpaceMatrix);
-      missileShader_->setVec3("viewPos", ctx.viewPos);
-      missileShader_->setVec3("lightPos", ctx.lightPos);
-      missileShader_->setVec3("lightIntensity", ctx.lightIntensity);
       missileShader_->setBool("useBaseColor", false);
-      missileShader_->setBool("useSSAO", ctx.ssaoEnabled && ctx.ssaoTexture != 0);
 
-      glActiveTexture(GL_TEXTURE0 + kShadowMapTextureUnit);
-      glBindTexture(GL_TEXTURE_2D, ctx.shadowMapTexture);
-      missileShader_->setInt("shadowMap", kShadowMapTextureUnit);
-
-      if (ctx.ssaoEnabled && ctx.ssaoTexture != 0)
+      if (ctx.shadowMapper)
       {
-        glActiveTexture(GL_TEXTURE0 + kSSAOTexUnit);
-        glBindTexture(GL_TEXTURE_2D, ctx.ssaoTexture);
-        missileShader_->setInt("ssaoMap", kSSAOTexUnit);
+        ctx.shadowMapper->BindShadowMaps(*missileShader_, kShadowMapTextureUnit);
       }
 
       for (const auto &missile : missiles_)
@@ -454,8 +449,6 @@ namespace mecha
     }
 
     shader_->use();
-    shader_->setMat4("projection", ctx.projection);
-    shader_->setMat4("view", ctx.view);
 
     glBindVertexArray(sphereVAO_);
 
@@ -520,8 +513,11 @@ namespace mecha
     model = glm::scale(model, glm::vec3(missileScale_ * missile.scale));
     model = glm::translate(model, -missilePivot_);
 
+    // Missiles are short-lived, so skip hysteresis and pick the level directly
+    const int lod = LodSelector::SelectLevel(ctx.projection, ctx.viewPos, model, missileModel_->GetBoundingMin(),
+                                             missileModel_->GetBoundingMax(), missileModel_->GetLodCount());
     missileShader_->setMat4("model", model);
-    missileModel_->Draw(*missileShader_);
+    missileModel_->Draw(*missileShader_, lod);
   }
 
   void MissileSystem::RenderMissileMeshShadow(const RenderContext &ctx, const Missile &missile)
@@ -552,8 +548,16 @@ namespace mecha
     model = glm::scale(model, glm::vec3(missileScale_ * missile.scale));
     model = glm::translate(model, -missilePivot_);
 
+    if (ctx.shadowCascade >= 0 &&
+        !ShadowMapper::BoundsInLightVolume(ctx.lightSpaceMatrix, model, missileModel_->GetBoundingMin(), missileModel_->GetBoundingMax()))
+    {
+      return;
+    }
+
+    const int lod = LodSelector::SelectLevel(ctx.projection, ctx.viewPos, model, missileModel_->GetBoundingMin(),
+                                             missileModel_->GetBoundingMax(), missileModel_->GetLodCount());
     ctx.overrideShader->setMat4("model", model);
-    missileModel_->Draw(*ctx.overrideShader);
+    missileModel_->Draw(*ctx.overrideShader, lod);
   }
 
   void MissileSystem::SetRenderResources(Shader *shader, unsigned int sphereVAO, unsigned int sphereIndexCount)
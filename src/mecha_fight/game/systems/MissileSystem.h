@@ -4,6 +4,7 @@
 
 #include "../../core/Entity.h"
 #include "../GameplayTypes.h"
+#include "../audio/GameSounds.h"
 
 class Model;
 
@@ -23,8 +24,9 @@ namespace mecha
       std::vector<Enemy *> enemies;
       std::vector<ThrusterParticle> *thrusterParticles{nullptr};
       std::vector<ShockwaveParticle> *shockwaveParticles{nullptr};
-      TerrainHeightSampler terrainSampler{};
+      HeightField terrain{};
       class SoundManager *soundManager{nullptr};
+      GameSounds sounds{};
     };
 
     void Update(const UpdateContext &ctx) override;
@@ -86,7 +86,7 @@ namespace mecha
           // Play impact sound
           if (params->soundManager)
           {
-            params->soundManager->PlaySound3D("PROJECTILE_IMPACT", b.pos);
+            params->soundManager->PlaySound3D(params->sounds.projectileImpact, b.pos);
           }
 
           return true;
@@ -127,7 +127,7 @@ namespace mecha
           // Play impact sound
           if (params->soundManager)
           {
-            params->soundManager->PlaySound3D("PROJECTILE_IMPACT", b.pos);
+            params->soundManager->PlaySound3D(params->sounds.projectileImpact, b.pos);
           }
 
           return true;
@@ -154,8 +154,6 @@ namespace mecha
     }
 
     shader_->use();
-    shader_->setMat4("projection", ctx.projection);
-    shader_->setMat4("view", ctx.view);
 
     glBindVertexArray(sphereVAO_);
 
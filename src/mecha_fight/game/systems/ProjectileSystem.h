@@ -4,6 +4,7 @@
 
 #include "../../core/Entity.h"
 #include "../GameplayTypes.h"
+#include "../audio/GameSounds.h"
 
 class Shader;
 
@@ -22,6 +23,7 @@ namespace mecha
       std::vector<Enemy *> enemies;
       DeveloperOverlayState *overlay{nullptr};
       class SoundManager *soundManager{nullptr};
+      GameSounds sounds{};
     };
 
     void Update(const UpdateContext &ctx) override;
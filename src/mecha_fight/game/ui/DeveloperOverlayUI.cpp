@@ -8,6 +8,7 @@
 #include "../GameplayTypes.h"
 #include "../entities/MechaPlayer.h"
 #include "DebugTextRenderer.h"
+#include "FontService.h"
 
 #include <glm/common.hpp>
 #include <glm/gtc/constants.hpp>
@@ -41,6 +42,7 @@ namespace mecha
     state_.noclip = false;
     state_.showMeleeHitbox = false;
     state_.godzillaSpawnRequested = false;
+    state_.ssaoResolutionMode = kDevOverlayDefaultSSAOMode;
     model.ClearAnimationPlaybackWindow();
   }
 
@@ -147,6 +149,9 @@ namespace mecha
     case DEV_MASTER_VOLUME:
       state_.masterVolume = glm::clamp(state_.masterVolume + direction * 0.1f, 0.0f, kDevOverlayMaxMasterVolume);
       break;
+    case DEV_SSAO_RESOLUTION:
+      state_.ssaoResolutionMode = (state_.ssaoResolutionMode + direction + kDevOverlaySSAOModeCount) % kDevOverlaySSAOModeCount;
+      break;
     case DEV_ANIMATION_PAUSE:
     case DEV_PLAYBACK_ENABLE:
     case DEV_INFINITE_FUEL:
@@ -192,6 +197,9 @@ namespace mecha
     case DEV_SPAWN_GODZILLA:
       state_.godzillaSpawnRequested = true;
       break;
+    case DEV_SSAO_RESOLUTION:
+      state_.ssaoResolutionMode = (state_.ssaoResolutionMode + 1) % kDevOverlaySSAOModeCount;
+      break;
     case DEV_RESET_DEFAULTS:
       Reset(model);
       break;
@@ -276,7 +284,6 @@ namespace mecha
     auto drawText = [&](const std::string &text, float x, float y, float scale, const glm::vec3 &color)
     {
       textRenderer_.RenderText(text, x, y, scale, color);
-      glBindVertexArray(params.quadVao);
     };
 
     const float panelWidth = 400.0f;
@@ -284,7 +291,7 @@ namespace mecha
     const float rowHeight = 26.0f;
     const glm::vec2 panelPos(params.screenSize.x - panelWidth - 24.0f, 70.0f);
     const float headerHeight = 60.0f;
-    const float panelHeight = headerHeight + DEV_CONTROL_COUNT * rowHeight + 90.0f;
+    const float panelHeight = headerHeight + DEV_CONTROL_COUNT * rowHeight + 106.0f;
 
     uiShader.setVec2("rectPos", panelPos);
     uiShader.setVec2("rectSize", glm::vec2(panelWidth, panelHeight));
@@ -371,6 +378,10 @@ namespace mecha
       oss << std::fixed << std::setprecision(0) << (state_.masterVolume * 100.0f) << "%";
       rows.push_back({"Master Volume", oss.str(), false});
     }
+    {
+      static const char *kSSAOModeLabels[kDevOverlaySSAOModeCount] = {"Full", "Half", "Quarter"};
+      rows.push_back({"SSAO Resolution", kSSAOModeLabels[state_.ssaoResolutionMode], false});
+    }
     rows.push_back({"Reset (Enter)", "Defaults", false});
 
     const float textScale = 0.52f;
@@ -414,7 +425,7 @@ namespace mecha
       drawText(rows[i].value, valueX, rowY, textScale, activeValueColor);
     }
 
-    float statsY = panelPos.y + panelHeight - 52.0f;
+    float statsY = panelPos.y + panelHeight - 68.0f;
     drawText("Stats", textX, statsY, headerTextScale, titleColor);
     statsY += 18.0f;
 
@@ -439,6 +450,16 @@ namespace mecha
     std::ostringstream hpStream;
     hpStream << std::fixed << std::setprecision(0) << combatState.hitPoints;
     drawText("HP: " + hpStream.str(), textX, statsY, 0.48f, valueColor);
+    statsY += 16.0f;
+
+    if (const FontService *fonts = textRenderer_.GetFontService())
+    {
+      const FontService::Stats &textStats = fonts->GetFrameStats();
+      drawText("Text: " + std::to_string(textStats.drawCalls) + " draws, " + std::to_string(textStats.glyphs) + " glyphs",
+               textX, statsY, 0.48f, valueColor);
+    }
+
+    textRenderer_.Flush();
   }
 
 } // namespace mecha
@@ -23,6 +23,8 @@ namespace mecha
 
   inline constexpr float kDevOverlayMaxMasterVolume = 2.0f;
   inline constexpr float kDevOverlayDefaultMasterVolume = 1.3f;
+  inline constexpr int kDevOverlaySSAOModeCount = 3;        // Full, half, quarter (matches kSSAOResolutionDivisors)
+  inline constexpr int kDevOverlayDefaultSSAOMode = 1;
 
   struct DeveloperOverlayState
   {
@@ -43,6 +45,7 @@ namespace mecha
     bool showMeleeHitbox = false;
     bool godzillaSpawnRequested = false;
     float masterVolume = kDevOverlayDefaultMasterVolume; // Master sound volume (0.0 to kDevOverlayMaxMasterVolume)
+    int ssaoResolutionMode = kDevOverlayDefaultSSAOMode; // 0 = full, 1 = half, 2 = quarter resolution SSAO
   };
 
   class DeveloperOverlayUI
@@ -85,6 +88,7 @@ namespace mecha
       DEV_MELEE_HITBOX,
     DEV_SPAWN_GODZILLA,
     DEV_MASTER_VOLUME,
+      DEV_SSAO_RESOLUTION,
       DEV_RESET_DEFAULTS,
       DEV_CONTROL_COUNT
     };
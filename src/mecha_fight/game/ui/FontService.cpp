@@ -0,0 +1,314 @@
+#include "FontService.h"
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <learnopengl/filesystem.h>
+#include <learnopengl/shader_m.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+
+namespace mecha
+{
+
+  namespace
+  {
+    constexpr int kAtlasWidth = 512;
+    constexpr int kGlyphPadding = 1; // Keeps linear filtering from bleeding neighbours in
+  } // namespace
+
+  FontAtlas::~FontAtlas()
+  {
+    if (texture_ != 0)
+    {
+      glDeleteTextures(1, &texture_);
+    }
+  }
+
+  bool FontAtlas::Load(const std::string &fontPath, unsigned int pixelSize)
+  {
+    FT_Library ft;
+    if (FT_Init_FreeType(&ft))
+    {
+      std::cout << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
+      return false;
+    }
+
+    FT_Face face;
+    if (FT_New_Face(ft, fontPath.c_str(), 0, &face))
+    {
+      std::cout << "ERROR::FREETYPE: Failed to load font " << fontPath << std::endl;
+      FT_Done_FreeType(ft);
+      return false;
+    }
+
+    FT_Set_Pixel_Sizes(face, 0, pixelSize);
+
+    // Rasterize every glyph first and shelf-pack them, so the texture is sized once
+    std::vector<std::vector<unsigned char>> bitmaps(glyphs_.size());
+    std::array<glm::ivec2, 128> offsets{};
+    int penX = kGlyphPadding;
+    int penY = kGlyphPadding;
+    int shelfHeight = 0;
+    for (unsigned char c = 0; c < glyphs_.size(); ++c)
+    {
+      if (FT_Load_Char(face, c, FT_LOAD_RENDER))
+      {
+        std::cout << "ERROR::FREETYPE: Failed to load Glyph for character " << static_cast<int>(c) << std::endl;
+        continue;
+      }
+
+      const FT_Bitmap &bitmap = face->glyph->bitmap;
+      Glyph &glyph = glyphs_[c];
+      glyph.size = glm::ivec2(bitmap.width, bitmap.rows);
+      glyph.bearing = glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top);
+      glyph.advance = static_cast<unsigned int>(face->glyph->advance.x);
+      glyph.loaded = true;
+
+      if (penX + glyph.size.x + kGlyphPadding > kAtlasWidth)
+      {
+        penX = kGlyphPadding;
+        penY += shelfHeight + kGlyphPadding;
+        shelfHeight = 0;
+      }
+      offsets[c] = glm::ivec2(penX, penY);
+      penX += glyph.size.x + kGlyphPadding;
+      shelfHeight = std::max(shelfHeight, glyph.size.y);
+
+      bitmaps[c].resize(static_cast<size_t>(glyph.size.x) * glyph.size.y);
+      for (int row = 0; row < glyph.size.y; ++row)
+      {
+        std::copy_n(bitmap.buffer + row * bitmap.pitch, glyph.size.x, bitmaps[c].begin() + row * glyph.size.x);
+      }
+    }
+
+    FT_Done_Face(face);
+    FT_Done_FreeType(ft);
+
+    int atlasHeight = 1;
+    while (atlasHeight < penY + shelfHeight + kGlyphPadding)
+    {
+      atlasHeight <<= 1;
+    }
+
+    std::vector<unsigned char> pixels(static_cast<size_t>(kAtlasWidth) * atlasHeight, 0);
+    const glm::vec2 texelSize(1.0f / kAtlasWidth, 1.0f / atlasHeight);
+    for (size_t c = 0; c < glyphs_.size(); ++c)
+    {
+      Glyph &glyph = glyphs_[c];
+      if (!glyph.loaded)
+      {
+        continue;
+      }
+      for (int row = 0; row < glyph.size.y; ++row)
+      {
+        std::copy_n(bitmaps[c].begin() + row * glyph.size.x, glyph.size.x,
+                    pixels.begin() + (offsets[c].y + row) * kAtlasWidth + offsets[c].x);
+      }
+      glyph.uvMin = glm::vec2(offsets[c]) * texelSize;
+      glyph.uvMax = glm::vec2(offsets[c] + glyph.size) * texelSize;
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glGenTextures(1, &texture_);
+    glBindTexture(GL_TEXTURE_2D, texture_);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, kAtlasWidth, atlasHeight, 0, GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    path_ = fontPath;
+    pixelSize_ = pixelSize;
+    std::cout << "[FontService] Packed " << fontPath << " at " << pixelSize << "px into a " << kAtlasWidth << "x"
+              << atlasHeight << " atlas" << std::endl;
+    return true;
+  }
+
+  float FontAtlas::MeasureText(std::string_view text, float scale) const
+  {
+    float width = 0.0f;
+    for (char c : text)
+    {
+      if (const Glyph *glyph = GetGlyph(c))
+      {
+        width += (glyph->advance >> 6) * scale;
+      }
+    }
+    return width;
+  }
+
+  FontService::FontService() = default;
+
+  FontService::~FontService()
+  {
+    Shutdown();
+  }
+
+  bool FontService::Init(unsigned int width, unsigned int height)
+  {
+    const std::string vertexPath = FileSystem::getPath("src/mecha_fight/shaders/dev_text.vs");
+    const std::string fragmentPath = FileSystem::getPath("src/mecha_fight/shaders/dev_text.fs");
+    shader_ = std::make_unique<Shader>(vertexPath.c_str(), fragmentPath.c_str());
+    shader_->use();
+    shader_->setInt("text", 0);
+    Resize(width, height);
+
+    glGenVertexArrays(1, &vao_);
+    glGenBuffers(1, &vbo_);
+    glBindVertexArray(vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void *)offsetof(TextVertex, position));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void *)offsetof(TextVertex, color));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    return true;
+  }
+
+  void FontService::Resize(unsigned int width, unsigned int height)
+  {
+    if (!shader_)
+    {
+      return;
+    }
+    shader_->use();
+    shader_->setMat4("projection", glm::ortho(0.0f, static_cast<float>(width), static_cast<float>(height), 0.0f));
+  }
+
+  void FontService::Shutdown()
+  {
+    fonts_.clear();
+    batches_.clear();
+    if (vao_ != 0)
+    {
+      glDeleteVertexArrays(1, &vao_);
+      vao_ = 0;
+    }
+    if (vbo_ != 0)
+    {
+      glDeleteBuffers(1, &vbo_);
+      vbo_ = 0;
+    }
+    vboCapacity_ = 0;
+    shader_.reset();
+  }
+
+  const FontAtlas *FontService::LoadFont(const std::string &fontPath, unsigned int pixelSize)
+  {
+    for (const auto &font : fonts_)
+    {
+      if (font->GetPixelSize() == pixelSize && font->GetPath() == fontPath)
+      {
+        return font.get();
+      }
+    }
+
+    auto font = std::make_unique<FontAtlas>();
+    if (!font->Load(fontPath, pixelSize))
+    {
+      return nullptr;
+    }
+    fonts_.push_back(std::move(font));
+    return fonts_.back().get();
+  }
+
+  void FontService::AddText(const FontAtlas &font, std::string_view text, float x, float y, float scale,
+                            const glm::vec3 &color)
+  {
+    auto batch = std::find_if(batches_.begin(), batches_.end(), [&](const Batch &b) { return b.font == &font; });
+    if (batch == batches_.end())
+    {
+      batches_.push_back(Batch{&font, {}});
+      batch = batches_.end() - 1;
+    }
+
+    std::vector<TextVertex> &vertices = batch->vertices;
+    for (char c : text)
+    {
+      const FontAtlas::Glyph *glyph = font.GetGlyph(c);
+      if (!glyph)
+      {
+        continue;
+      }
+
+      const float xpos = x + glyph->bearing.x * scale;
+      const float ypos = y - (glyph->size.y - glyph->bearing.y) * scale;
+      const float w = glyph->size.x * scale;
+      const float h = glyph->size.y * scale;
+      const glm::vec2 &uv0 = glyph->uvMin;
+      const glm::vec2 &uv1 = glyph->uvMax;
+
+      vertices.push_back({{xpos, ypos + h}, {uv0.x, uv1.y}, color});
+      vertices.push_back({{xpos + w, ypos}, {uv1.x, uv0.y}, color});
+      vertices.push_back({{xpos, ypos}, {uv0.x, uv0.y}, color});
+
+      vertices.push_back({{xpos, ypos + h}, {uv0.x, uv1.y}, color});
+      vertices.push_back({{xpos + w, ypos + h}, {uv1.x, uv1.y}, color});
+      vertices.push_back({{xpos + w, ypos}, {uv1.x, uv0.y}, color});
+
+      x += (glyph->advance >> 6) * scale;
+    }
+  }
+
+  void FontService::Flush()
+  {
+    size_t vertexCount = 0;
+    for (const Batch &batch : batches_)
+    {
+      vertexCount += batch.vertices.size();
+    }
+    if (vertexCount == 0 || !shader_)
+    {
+      return;
+    }
+
+    glBindVertexArray(vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    // Orphan the old storage so the driver never waits for last flush's draws
+    vboCapacity_ = std::max(vboCapacity_, vertexCount);
+    glBufferData(GL_ARRAY_BUFFER, vboCapacity_ * sizeof(TextVertex), nullptr, GL_STREAM_DRAW);
+    size_t offset = 0;
+    for (const Batch &batch : batches_)
+    {
+      glBufferSubData(GL_ARRAY_BUFFER, offset * sizeof(TextVertex), batch.vertices.size() * sizeof(TextVertex),
+                      batch.vertices.data());
+      offset += batch.vertices.size();
+    }
+
+    shader_->use();
+    glActiveTexture(GL_TEXTURE0);
+    offset = 0;
+    for (Batch &batch : batches_)
+    {
+      if (batch.vertices.empty())
+      {
+        continue;
+      }
+      glBindTexture(GL_TEXTURE_2D, batch.font->GetTexture());
+      glDrawArrays(GL_TRIANGLES, static_cast<GLint>(offset), static_cast<GLsizei>(batch.vertices.size()));
+      frameStats_.drawCalls++;
+      frameStats_.glyphs += static_cast<unsigned int>(batch.vertices.size() / 6);
+      offset += batch.vertices.size();
+      batch.vertices.clear();
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+  }
+
+  void FontService::EndFrame()
+  {
+    lastFrameStats_ = frameStats_;
+    frameStats_ = Stats();
+  }
+
+} // namespace mecha
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Shader;
+
+namespace mecha
+{
+
+  /**
+   * @brief One font at one pixel size, with its ASCII glyphs packed into a single texture
+   */
+  class FontAtlas
+  {
+  public:
+    struct Glyph
+    {
+      glm::vec2 uvMin = glm::vec2(0.0f);
+      glm::vec2 uvMax = glm::vec2(0.0f);
+      glm::ivec2 size = glm::ivec2(0);
+      glm::ivec2 bearing = glm::ivec2(0);
+      unsigned int advance = 0; // 1/64 pixels, as FreeType reports it
+      bool loaded = false;
+    };
+
+    ~FontAtlas();
+
+    bool Load(const std::string &fontPath, unsigned int pixelSize);
+
+    /**
+     * @brief Glyph of an ASCII character, or nullptr for characters the font has none for
+     */
+    const Glyph *GetGlyph(char c) const
+    {
+      const unsigned char index = static_cast<unsigned char>(c);
+      return index < glyphs_.size() && glyphs_[index].loaded ? &glyphs_[index] : nullptr;
+    }
+
+    float MeasureText(std::string_view text, float scale) const;
+
+    unsigned int GetTexture() const { return texture_; }
+    const std::string &GetPath() const { return path_; }
+    unsigned int GetPixelSize() const { return pixelSize_; }
+
+  private:
+    std::array<Glyph, 128> glyphs_{};
+    unsigned int texture_ = 0;
+    std::string path_;
+    unsigned int pixelSize_ = 0;
+  };
+
+  /**
+   * @brief Screen-space text for every UI screen: shared font atlases and one batched draw per atlas
+   *
+   * Fonts are loaded once per path and size, so screens asking for the same font share its atlas.
+   * AddText only appends quads on the CPU; Flush uploads everything queued into one vertex buffer
+   * and draws each atlas's quads with a single call. Screens flush once their quads are drawn, so
+   * text stays on top of its own panels.
+   */
+  class FontService
+  {
+  public:
+    struct Stats
+    {
+      unsigned int drawCalls = 0;
+      unsigned int glyphs = 0;
+    };
+
+    FontService();
+    ~FontService();
+
+    FontService(const FontService &) = delete;
+    FontService &operator=(const FontService &) = delete;
+
+    bool Init(unsigned int width, unsigned int height);
+    void Resize(unsigned int width, unsigned int height);
+    void Shutdown();
+    bool IsReady() const { return shader_ != nullptr; }
+
+    /**
+     * @brief Load a font or return the atlas already loaded for the same path and size
+     * @return nullptr if the font could not be loaded
+     */
+    const FontAtlas *LoadFont(const std::string &fontPath, unsigned int pixelSize);
+
+    /**
+     * @brief Queue a line with its baseline at (x, y) in pixels, y pointing down
+     */
+    void AddText(const FontAtlas &font, std::string_view text, float x, float y, float scale, const glm::vec3 &color);
+
+    /**
+     * @brief Draw all queued text, one draw call per atlas
+     */
+    void Flush();
+
+    /**
+     * @brief Draw calls and glyphs of the previous frame; EndFrame rolls the counters over
+     */
+    const Stats &GetFrameStats() const { return lastFrameStats_; }
+    void EndFrame();
+
+  private:
+    struct TextVertex
+    {
+      glm::vec2 position;
+      glm::vec2 uv;
+      glm::vec3 color;
+    };
+
+    struct Batch
+    {
+      const FontAtlas *font = nullptr;
+      std::vector<TextVertex> vertices;
+    };
+
+    std::vector<std::unique_ptr<FontAtlas>> fonts_;
+    std::vector<Batch> batches_; // One per atlas, kept between flushes to reuse their storage
+    std::unique_ptr<Shader> shader_;
+    unsigned int vao_ = 0;
+    unsigned int vbo_ = 0;
+    size_t vboCapacity_ = 0; // In vertices
+    Stats frameStats_;
+    Stats lastFrameStats_;
+  };
+
+} // namespace mecha
@@ -273,6 +273,7 @@ namespace mecha
 
       textRenderer.RenderText(item.text, textX, textY, textScale, textColor * m_fadeAlpha);
     }
+    textRenderer.Flush();
 
     glDisable(GL_BLEND);
     glEnable(GL_DEPTH_TEST);
@@ -2,28 +2,18 @@
 #include "DebugTextRenderer.h"
 
 #include <cmath>
+#include <iostream>
 
 #include <glad/glad.h>
 #include <glm/gtc/constants.hpp>
 
-#include <learnopengl/shader_m.h>
-
 namespace mecha
 {
   namespace
   {
     const glm::vec4 kHudBackgroundColor(0.0f, 0.0f, 0.0f, 0.35f);
 
-    void DrawRect(Shader &shader, const glm::vec2 &pos, const glm::vec2 &size, const glm::vec4 &color, float fill)
-    {
-      shader.setVec2("rectPos", pos);
-      shader.setVec2("rectSize", size);
-      shader.setVec4("color", color);
-      shader.setFloat("fill", fill);
-      glDrawArrays(GL_TRIANGLES, 0, 6);
-    }
-
-    void DrawFocusCircle(const HudRenderer::HudRenderData &data, Shader &shader)
+    void DrawFocusCircle(const HudRenderer::HudRenderData &data, UiBatch &batch)
     {
       const int segments = 32;
       const glm::vec2 center = data.crosshairPos;
@@ -34,11 +24,11 @@ namespace mecha
         float angle = (static_cast<float>(i) / static_cast<float>(segments)) * glm::two_pi<float>();
         glm::vec2 point(center.x + std::cos(angle) * data.focusCircleRadius,
                         center.y + std::sin(angle) * data.focusCircleRadius);
-        DrawRect(shader, point - glm::vec2(2.0f), glm::vec2(4.0f), color, 1.0f);
+        batch.AddRect(point - glm::vec2(2.0f), glm::vec2(4.0f), color, 1.0f);
       }
     }
 
-    void DrawBeam(const HudRenderer::HudRenderData &data, Shader &shader)
+    void DrawBeam(const HudRenderer::HudRenderData &data, UiBatch &batch)
     {
       glm::vec2 center = data.crosshairPos;
       glm::vec2 direction = center - glm::vec2(data.screenSize * 0.5f);
@@ -54,10 +44,10 @@ namespace mecha
 
       (void)direction; // Beam currently rendered as muzzle flash at crosshair
 
-      DrawRect(shader, center - glm::vec2(4.0f), glm::vec2(8.0f), data.beamColor, 1.0f);
+      batch.AddRect(center - glm::vec2(4.0f), glm::vec2(8.0f), data.beamColor, 1.0f);
     }
 
-    void DrawBoostAndCooldownBars(const HudRenderer::HudRenderData &data, Shader &shader)
+    void DrawBoostAndCooldownBars(const HudRenderer::HudRenderData &data, UiBatch &batch)
     {
       const float margin = 20.0f;
       const glm::vec2 boostSize(300.0f, 16.0f);
@@ -66,68 +56,87 @@ namespace mecha
       glm::vec2 boostPosTL(margin, data.screenSize.y - (margin + boostSize.y));
       glm::vec2 cdPosTL(margin, boostPosTL.y - 6.0f - cdSize.y);
 
-      DrawRect(shader, boostPosTL, boostSize, kHudBackgroundColor, 1.0f);
+      batch.AddRect(boostPosTL, boostSize, kHudBackgroundColor, 1.0f);
 
       const glm::vec4 boostColor = data.boostActive ? data.boostActiveColor : data.boostReadyColor;
-      DrawRect(shader, boostPosTL, boostSize, boostColor, glm::clamp(data.boostFill, 0.0f, 1.0f));
+      batch.AddRect(boostPosTL, boostSize, boostColor, glm::clamp(data.boostFill, 0.0f, 1.0f));
 
-      DrawRect(shader, cdPosTL, cdSize, kHudBackgroundColor, 1.0f);
-      DrawRect(shader, cdPosTL, cdSize, data.cooldownColor, glm::clamp(data.cooldownFill, 0.0f, 1.0f));
+      batch.AddRect(cdPosTL, cdSize, kHudBackgroundColor, 1.0f);
+      batch.AddRect(cdPosTL, cdSize, data.cooldownColor, glm::clamp(data.cooldownFill, 0.0f, 1.0f));
 
       const glm::vec2 fuelSize(300.0f, 12.0f);
       glm::vec2 fuelPosTL(margin, cdPosTL.y - 4.0f - fuelSize.y);
 
-      DrawRect(shader, fuelPosTL, fuelSize, kHudBackgroundColor, 1.0f);
+      batch.AddRect(fuelPosTL, fuelSize, kHudBackgroundColor, 1.0f);
       const glm::vec4 fuelColor = data.fuelActive ? data.fuelActiveColor : data.fuelIdleColor;
-      DrawRect(shader, fuelPosTL, fuelSize, fuelColor, glm::clamp(data.fuelFill, 0.0f, 1.0f));
+      batch.AddRect(fuelPosTL, fuelSize, fuelColor, glm::clamp(data.fuelFill, 0.0f, 1.0f));
     }
 
-    void DrawHealthBar(const HudRenderer::HudRenderData &data, Shader &shader)
+    void DrawHealthBar(const HudRenderer::HudRenderData &data, UiBatch &batch)
     {
       const glm::vec2 hpSize(300.0f, 12.0f);
       const glm::vec2 hpPosTL(20.0f, 20.0f);
 
-      DrawRect(shader, hpPosTL, hpSize, kHudBackgroundColor, 1.0f);
-      DrawRect(shader, hpPosTL, hpSize, data.healthColor, glm::clamp(data.healthFill, 0.0f, 1.0f));
+      batch.AddRect(hpPosTL, hpSize, kHudBackgroundColor, 1.0f);
+      batch.AddRect(hpPosTL, hpSize, data.healthColor, glm::clamp(data.healthFill, 0.0f, 1.0f));
     }
 
-    void DrawCrosshair(const HudRenderer::HudRenderData &data, Shader &shader)
+    void DrawCrosshair(const HudRenderer::HudRenderData &data, UiBatch &batch)
     {
       const glm::vec2 horizontalSize(22.0f, 2.0f);
       const glm::vec2 verticalSize(2.0f, 22.0f);
       const glm::vec2 posH = data.crosshairPos - glm::vec2(horizontalSize.x * 0.5f, horizontalSize.y * 0.5f);
       const glm::vec2 posV = data.crosshairPos - glm::vec2(verticalSize.x * 0.5f, verticalSize.y * 0.5f);
 
-      DrawRect(shader, posH, horizontalSize, data.crosshairColor, 1.0f);
-      DrawRect(shader, posV, verticalSize, data.crosshairColor, 1.0f);
+      batch.AddRect(posH, horizontalSize, data.crosshairColor, 1.0f);
+      batch.AddRect(posV, verticalSize, data.crosshairColor, 1.0f);
     }
 
-    void DrawMinimap(const HudRenderer::HudRenderData &data, Shader &shader)
-    {
-      const float margin = 20.0f;
-      const float minimapSize = 150.0f;
-      const float minimapRadius = minimapSize * 0.5f;
-
-      // Position in top-right corner
-      glm::vec2 minimapCenter(data.screenSize.x - margin - minimapRadius, margin + minimapRadius);
+    constexpr float kMinimapMargin = 20.0f;
+    constexpr float kMinimapSize = 150.0f;
+    constexpr float kMinimapPadding = 4.0f; // Room for the border ring, which straddles the radius
+    constexpr int kMinimapLayerSize = static_cast<int>(kMinimapSize + kMinimapPadding * 2.0f);
 
+    // Parts of the minimap that never change: background, border and the player marker
+    void DrawMinimapFrame(UiBatch &batch, const glm::vec2 &minimapCenter, float minimapRadius)
+    {
       // Draw minimap background (square with rounded appearance)
       const glm::vec4 minimapBgColor(0.0f, 0.0f, 0.0f, 0.6f);
       const glm::vec4 minimapBorderColor(0.3f, 0.3f, 0.3f, 0.9f);
 
       // Draw square background
       glm::vec2 minimapPos = minimapCenter - glm::vec2(minimapRadius);
-      DrawRect(shader, minimapPos, glm::vec2(minimapSize), minimapBgColor, 1.0f);
+      batch.AddRect(minimapPos, glm::vec2(minimapRadius * 2.0f), minimapBgColor, 1.0f);
 
       // Draw circular border
-      const int circleSegments = 64;
-      for (int i = 0; i < circleSegments; ++i)
-      {
-        float angle = (static_cast<float>(i) / static_cast<float>(circleSegments)) * glm::two_pi<float>();
-        glm::vec2 point = minimapCenter + glm::vec2(std::cos(angle), std::sin(angle)) * minimapRadius;
-        DrawRect(shader, point - glm::vec2(2.0f), glm::vec2(4.0f), minimapBorderColor, 1.0f);
-      }
+      batch.AddCircle(minimapCenter, minimapRadius, 4.0f, minimapBorderColor, 64);
+
+      // Draw center point (player position) - always at center
+      const glm::vec4 playerColor(0.2f, 0.8f, 1.0f, 1.0f);
+      const glm::vec2 playerDotSize(6.0f);
+      batch.AddRect(minimapCenter - playerDotSize * 0.5f, playerDotSize, playerColor, 1.0f);
 
+      // Draw player forward indicator (arrow ALWAYS pointing up - completely fixed, no rotation)
+      // This is drawn BEFORE any rotation calculations, so it's never affected by player yaw
+      const glm::vec4 forwardColor(0.2f, 0.8f, 1.0f, 0.8f);
+      const float forwardArrowLength = 15.0f;
+      // Fixed direction: always point up (positive Y in screen coords = up on screen)
+      glm::vec2 forwardTip = minimapCenter + glm::vec2(0.0f, forwardArrowLength);
+      glm::vec2 forwardBase = minimapCenter + glm::vec2(0.0f, forwardArrowLength * 0.5f);
+
+      // Draw arrow shaft (vertical line pointing up)
+      glm::vec2 forwardShaftSize(2.0f, forwardArrowLength * 0.5f);
+      batch.AddRect(forwardBase - glm::vec2(forwardShaftSize.x * 0.5f, forwardShaftSize.y), forwardShaftSize, forwardColor, 1.0f);
+
+      // Draw arrow head (triangle pointing up - drawn as a small rectangle)
+      glm::vec2 forwardHeadSize(6.0f, 4.0f);
+      batch.AddRect(forwardTip - glm::vec2(forwardHeadSize.x * 0.5f, forwardHeadSize.y), forwardHeadSize, forwardColor, 1.0f);
+    }
+
+    // Everything placed relative to the player's position and yaw: gates, enemies, boss and compass
+    void DrawMinimapBlips(const HudRenderer::HudRenderData &data, UiBatch &batch, const glm::vec2 &minimapCenter,
+                          float minimapRadius)
+    {
       // Rotate minimap based on player yaw (so the world rotates around the fixed forward indicator).
       // Player's forward direction should always point up on minimap
       float yawRad = glm::radians(data.playerYawDegrees);
@@ -151,27 +160,6 @@ namespace mecha
         return glm::vec2(rotatedX, -rotatedZ);
       };
 
-      // Draw center point (player position) - always at center
-      const glm::vec4 playerColor(0.2f, 0.8f, 1.0f, 1.0f);
-      const glm::vec2 playerDotSize(6.0f);
-      DrawRect(shader, minimapCenter - playerDotSize * 0.5f, playerDotSize, playerColor, 1.0f);
-
-      // Draw player forward indicator (arrow ALWAYS pointing up - completely fixed, no rotation)
-      // This is drawn BEFORE any rotation calculations, so it's never affected by player yaw
-      const glm::vec4 forwardColor(0.2f, 0.8f, 1.0f, 0.8f);
-      const float forwardArrowLength = 15.0f;
-      // Fixed direction: always point up (positive Y in screen coords = up on screen)
-      glm::vec2 forwardTip = minimapCenter + glm::vec2(0.0f, forwardArrowLength);
-      glm::vec2 forwardBase = minimapCenter + glm::vec2(0.0f, forwardArrowLength * 0.5f);
-
-      // Draw arrow shaft (vertical line pointing up)
-      glm::vec2 forwardShaftSize(2.0f, forwardArrowLength * 0.5f);
-      DrawRect(shader, forwardBase - glm::vec2(forwardShaftSize.x * 0.5f, forwardShaftSize.y), forwardShaftSize, forwardColor, 1.0f);
-
-      // Draw arrow head (triangle pointing up - drawn as a small rectangle)
-      glm::vec2 forwardHeadSize(6.0f, 4.0f);
-      DrawRect(shader, forwardTip - glm::vec2(forwardHeadSize.x * 0.5f, forwardHeadSize.y), forwardHeadSize, forwardColor, 1.0f);
-
       // Draw all enemy positions
       const glm::vec4 enemyColor(1.0f, 0.2f, 0.2f, 1.0f);
       const float scale = minimapRadius / data.minimapWorldRange;
@@ -195,7 +183,7 @@ namespace mecha
         {
           // Enemy is within range - draw enemy dot
           glm::vec2 enemyScreenPos = minimapCenter + screenOffset * scale;
-          DrawRect(shader, enemyScreenPos - enemyDotSize * 0.5f, enemyDotSize, enemyColor, 1.0f);
+          batch.AddRect(enemyScreenPos - enemyDotSize * 0.5f, enemyDotSize, enemyColor, 1.0f);
         }
         else
         {
@@ -205,18 +193,11 @@ namespace mecha
           glm::vec2 arrowTip = minimapCenter + direction * (minimapRadius - 2.0f);
 
           // Draw arrow line
-          glm::vec2 arrowDir = arrowTip - arrowBase;
-          float arrowLen = glm::length(arrowDir);
-          if (arrowLen > 0.0f)
-          {
-            glm::vec2 perp = glm::vec2(-arrowDir.y, arrowDir.x) / arrowLen;
-            glm::vec2 arrowSize(arrowLen, 2.0f);
-            DrawRect(shader, arrowBase - perp * 1.0f, arrowSize, enemyColor, 1.0f);
-
-            // Draw arrow head
-            glm::vec2 headSize(6.0f);
-            DrawRect(shader, arrowTip - headSize * 0.5f, headSize, enemyColor, 1.0f);
-          }
+          batch.AddLine(arrowBase, arrowTip, 2.0f, enemyColor);
+
+          // Draw arrow head
+          glm::vec2 headSize(6.0f);
+          batch.AddRect(arrowTip - headSize * 0.5f, headSize, enemyColor, 1.0f);
         }
       }
 
@@ -242,7 +223,7 @@ namespace mecha
         {
           // Portal is within range - draw portal dot
           glm::vec2 portalScreenPos = minimapCenter + screenOffset * scale;
-          DrawRect(shader, portalScreenPos - portalDotSize * 0.5f, portalDotSize, portalColor, 1.0f);
+          batch.AddRect(portalScreenPos - portalDotSize * 0.5f, portalDotSize, portalColor, 1.0f);
         }
         else
         {
@@ -252,18 +233,11 @@ namespace mecha
           glm::vec2 arrowTip = minimapCenter + direction * (minimapRadius - 2.0f);
 
           // Draw arrow line
-          glm::vec2 arrowDir = arrowTip - arrowBase;
-          float arrowLen = glm::length(arrowDir);
-          if (arrowLen > 0.0f)
-          {
-            glm::vec2 perp = glm::vec2(-arrowDir.y, arrowDir.x) / arrowLen;
-            glm::vec2 arrowSize(arrowLen, 2.0f);
-            DrawRect(shader, arrowBase - perp * 1.0f, arrowSize, portalColor, 1.0f);
-
-            // Draw arrow head
-            glm::vec2 headSize(6.0f);
-            DrawRect(shader, arrowTip - headSize * 0.5f, headSize, portalColor, 1.0f);
-          }
+          batch.AddLine(arrowBase, arrowTip, 2.0f, portalColor);
+
+          // Draw arrow head
+          glm::vec2 headSize(6.0f);
+          batch.AddRect(arrowTip - headSize * 0.5f, headSize, portalColor, 1.0f);
         }
       }
 
@@ -281,7 +255,7 @@ namespace mecha
         if (distance <= data.minimapWorldRange)
         {
           glm::vec2 bossScreenPos = minimapCenter + screenOffset * scale;
-          DrawRect(shader, bossScreenPos - bossDotSize * 0.5f, bossDotSize, bossColor, 1.0f);
+          batch.AddRect(bossScreenPos - bossDotSize * 0.5f, bossDotSize, bossColor, 1.0f);
         }
         else
         {
@@ -289,17 +263,10 @@ namespace mecha
           glm::vec2 arrowBase = minimapCenter + direction * (minimapRadius - 18.0f);
           glm::vec2 arrowTip = minimapCenter + direction * (minimapRadius - 4.0f);
 
-          glm::vec2 arrowDir = arrowTip - arrowBase;
-          float arrowLen = glm::length(arrowDir);
-          if (arrowLen > 0.0f)
-          {
-            glm::vec2 perp = glm::vec2(-arrowDir.y, arrowDir.x) / arrowLen;
-            glm::vec2 arrowSize(arrowLen, 4.0f);
-            DrawRect(shader, arrowBase - perp * 2.0f, arrowSize, bossColor, 1.0f);
-
-            glm::vec2 headSize(8.0f);
-            DrawRect(shader, arrowTip - headSize * 0.5f, headSize, bossColor, 1.0f);
-          }
+          batch.AddLine(arrowBase, arrowTip, 4.0f, bossColor);
+
+          glm::vec2 headSize(8.0f);
+          batch.AddRect(arrowTip - headSize * 0.5f, headSize, bossColor, 1.0f);
         }
       }
 
@@ -312,32 +279,139 @@ namespace mecha
       }
       glm::vec2 northPos = minimapCenter + northDir * (minimapRadius - 5.0f);
       glm::vec2 compassSize(4.0f, 8.0f);
-      DrawRect(shader, northPos - glm::vec2(compassSize.x * 0.5f, 0.0f), compassSize, compassColor, 1.0f);
+      batch.AddRect(northPos - glm::vec2(compassSize.x * 0.5f, 0.0f), compassSize, compassColor, 1.0f);
     }
   } // namespace
 
-  void HudRenderer::Render(const HudRenderData &data, Shader &shader, unsigned int quadVao) const
+  bool HudRenderer::Initialize(Shader &shader)
+  {
+    if (!batch_.Init() || !minimapBatch_.Init() || !CreateMinimapLayer(minimapStatic_) ||
+        !CreateMinimapLayer(minimapComposite_))
+    {
+      return false;
+    }
+
+    DrawMinimapFrame(minimapBatch_, glm::vec2(kMinimapLayerSize * 0.5f), kMinimapSize * 0.5f);
+    DrawMinimapLayer(minimapStatic_, shader, false);
+    minimapTimeSinceRefresh_ = minimapRefreshInterval_; // Draw blips on the first frame
+    return true;
+  }
+
+  void HudRenderer::Shutdown()
   {
-    shader.use();
-    shader.setVec2("screenSize", data.screenSize);
-    glBindVertexArray(quadVao);
+    batch_.Shutdown();
+    minimapBatch_.Shutdown();
+    DestroyMinimapLayer(minimapStatic_);
+    DestroyMinimapLayer(minimapComposite_);
+  }
 
-    DrawFocusCircle(data, shader);
+  bool HudRenderer::CreateMinimapLayer(MinimapLayer &layer)
+  {
+    glGenFramebuffers(1, &layer.fbo);
+    glGenTextures(1, &layer.texture);
+    glBindTexture(GL_TEXTURE_2D, layer.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, kMinimapLayerSize, kMinimapLayerSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, layer.fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, layer.texture, 0);
+    const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (!complete)
+    {
+      std::cerr << "[HudRenderer] Minimap framebuffer incomplete" << std::endl;
+      DestroyMinimapLayer(layer);
+    }
+    return complete;
+  }
 
-    if (data.beamActive)
+  void HudRenderer::DestroyMinimapLayer(MinimapLayer &layer)
+  {
+    if (layer.fbo != 0)
     {
-      DrawBeam(data, shader);
+      glDeleteFramebuffers(1, &layer.fbo);
+      layer.fbo = 0;
     }
+    if (layer.texture != 0)
+    {
+      glDeleteTextures(1, &layer.texture);
+      layer.texture = 0;
+    }
+  }
 
-    DrawBoostAndCooldownBars(data, shader);
-    DrawHealthBar(data, shader);
-    DrawCrosshair(data, shader);
-    DrawMinimap(data, shader);
+  void HudRenderer::DrawMinimapLayer(const MinimapLayer &layer, Shader &shader, bool copyStaticLayer)
+  {
+    GLint previousFbo = 0;
+    GLint previousViewport[4];
+    GLint previousBlend[4];
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFbo);
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+    glGetIntegerv(GL_BLEND_SRC_RGB, &previousBlend[0]);
+    glGetIntegerv(GL_BLEND_DST_RGB, &previousBlend[1]);
+    glGetIntegerv(GL_BLEND_SRC_ALPHA, &previousBlend[2]);
+    glGetIntegerv(GL_BLEND_DST_ALPHA, &previousBlend[3]);
+    const GLboolean blendEnabled = glIsEnabled(GL_BLEND);
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, layer.fbo);
+    if (copyStaticLayer)
+    {
+      glBindFramebuffer(GL_READ_FRAMEBUFFER, minimapStatic_.fbo);
+      glBlitFramebuffer(0, 0, kMinimapLayerSize, kMinimapLayerSize, 0, 0, kMinimapLayerSize, kMinimapLayerSize,
+                        GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    }
+    else
+    {
+      glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+      glClear(GL_COLOR_BUFFER_BIT);
+    }
+
+    // Straight-alpha shapes over a transparent target leave premultiplied colour and correct coverage
+    glViewport(0, 0, kMinimapLayerSize, kMinimapLayerSize);
+    glEnable(GL_BLEND);
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    minimapBatch_.Flush(shader, glm::vec2(static_cast<float>(kMinimapLayerSize)));
 
-    glBindVertexArray(0);
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFbo));
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+    glBlendFuncSeparate(previousBlend[0], previousBlend[1], previousBlend[2], previousBlend[3]);
+    if (!blendEnabled)
+    {
+      glDisable(GL_BLEND);
+    }
+  }
+
+  void HudRenderer::QueueMinimap(const HudRenderData &data)
+  {
+    const float minimapRadius = kMinimapSize * 0.5f;
+    minimapTimeSinceRefresh_ += data.frameTime;
+    if (minimapTimeSinceRefresh_ >= minimapRefreshInterval_)
+    {
+      DrawMinimapBlips(data, minimapBatch_, glm::vec2(kMinimapLayerSize * 0.5f), minimapRadius);
+      minimapRefreshPending_ = true;
+      minimapTimeSinceRefresh_ = 0.0f;
+    }
   }
 
-  void HudRenderer::RenderObjective(const HudRenderData &data, Shader &shader, unsigned int quadVao, DebugTextRenderer &textRenderer) const
+  void HudRenderer::Render(const HudRenderData &data)
+  {
+    DrawFocusCircle(data, batch_);
+
+    if (data.beamActive)
+    {
+      DrawBeam(data, batch_);
+    }
+
+    DrawBoostAndCooldownBars(data, batch_);
+    DrawHealthBar(data, batch_);
+    DrawCrosshair(data, batch_);
+    QueueMinimap(data);
+  }
+
+  void HudRenderer::RenderObjective(const HudRenderData &data, DebugTextRenderer &textRenderer)
   {
     if (data.objectiveText.empty() || !textRenderer.IsReady())
     {
@@ -345,8 +419,8 @@ namespace mecha
     }
 
     // Position objective below the minimap
-    const float margin = 20.0f;
-    const float minimapSize = 150.0f;
+    const float margin = kMinimapMargin;
+    const float minimapSize = kMinimapSize;
     const float objectiveBoxWidth = 200.0f;
     const float objectiveBoxHeight = 65.0f;
 
@@ -359,40 +433,17 @@ namespace mecha
     float boxY = minimapBottom + 10.0f;
 
     // Draw background box
-    shader.use();
-    shader.setVec2("screenSize", data.screenSize);
-    glBindVertexArray(quadVao);
-
     const glm::vec4 bgColor(0.0f, 0.0f, 0.0f, 0.6f);
     const glm::vec4 borderColor(0.8f, 0.6f, 0.2f, 0.9f);
 
     // Background
-    shader.setVec2("rectPos", glm::vec2(boxX, boxY));
-    shader.setVec2("rectSize", glm::vec2(objectiveBoxWidth, objectiveBoxHeight));
-    shader.setVec4("color", bgColor);
-    shader.setFloat("fill", 1.0f);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-
-    // Border - top
-    shader.setVec2("rectPos", glm::vec2(boxX, boxY));
-    shader.setVec2("rectSize", glm::vec2(objectiveBoxWidth, 2.0f));
-    shader.setVec4("color", borderColor);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-
-    // Border - bottom
-    shader.setVec2("rectPos", glm::vec2(boxX, boxY + objectiveBoxHeight - 2.0f));
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-
-    // Border - left
-    shader.setVec2("rectPos", glm::vec2(boxX, boxY));
-    shader.setVec2("rectSize", glm::vec2(2.0f, objectiveBoxHeight));
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-
-    // Border - right
-    shader.setVec2("rectPos", glm::vec2(boxX + objectiveBoxWidth - 2.0f, boxY));
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    batch_.AddRect(glm::vec2(boxX, boxY), glm::vec2(objectiveBoxWidth, objectiveBoxHeight), bgColor);
 
-    glBindVertexArray(0);
+    // Border - top, bottom, left, right
+    batch_.AddRect(glm::vec2(boxX, boxY), glm::vec2(objectiveBoxWidth, 2.0f), borderColor);
+    batch_.AddRect(glm::vec2(boxX, boxY + objectiveBoxHeight - 2.0f), glm::vec2(objectiveBoxWidth, 2.0f), borderColor);
+    batch_.AddRect(glm::vec2(boxX, boxY), glm::vec2(2.0f, objectiveBoxHeight), borderColor);
+    batch_.AddRect(glm::vec2(boxX + objectiveBoxWidth - 2.0f, boxY), glm::vec2(2.0f, objectiveBoxHeight), borderColor);
 
     // Draw "OBJECTIVE" label
     const glm::vec3 labelColor(0.8f, 0.6f, 0.2f);
@@ -407,7 +458,7 @@ namespace mecha
     textRenderer.RenderText(data.objectiveText, labelX, textY, 0.45f, textColor);
   }
 
-  void HudRenderer::RenderBossHealthBar(const HudRenderData &data, Shader &shader, unsigned int quadVao, DebugTextRenderer &textRenderer) const
+  void HudRenderer::RenderBossHealthBar(const HudRenderData &data, DebugTextRenderer &textRenderer)
   {
     if (!data.bossVisible || !data.bossAlive)
     {
@@ -423,55 +474,26 @@ namespace mecha
     float barX = (data.screenSize.x - barWidth) * 0.5f;
     float barY = data.screenSize.y - margin - barHeight;
 
-    shader.use();
-    shader.setVec2("screenSize", data.screenSize);
-    glBindVertexArray(quadVao);
-
     // Background (dark)
     const glm::vec4 bgColor(0.1f, 0.1f, 0.1f, 0.8f);
-    shader.setVec2("rectPos", glm::vec2(barX, barY));
-    shader.setVec2("rectSize", glm::vec2(barWidth, barHeight));
-    shader.setVec4("color", bgColor);
-    shader.setFloat("fill", 1.0f);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    batch_.AddRect(glm::vec2(barX, barY), glm::vec2(barWidth, barHeight), bgColor);
 
     // Health fill (gradient from red to orange-red)
     const glm::vec4 healthColor(0.9f, 0.2f, 0.1f, 1.0f);
-    float fillWidth = barWidth * glm::clamp(data.bossHealthFill, 0.0f, 1.0f);
-    if (fillWidth > 0.0f)
-    {
-      shader.setVec2("rectPos", glm::vec2(barX, barY));
-      shader.setVec2("rectSize", glm::vec2(fillWidth, barHeight));
-      shader.setVec4("color", healthColor);
-      glDrawArrays(GL_TRIANGLES, 0, 6);
-    }
+    batch_.AddRect(glm::vec2(barX, barY), glm::vec2(barWidth, barHeight), healthColor,
+                   glm::clamp(data.bossHealthFill, 0.0f, 1.0f));
 
     // Border (golden/orange)
     const glm::vec4 borderColor(0.9f, 0.6f, 0.1f, 1.0f);
     const float borderThickness = 2.0f;
+    const glm::vec2 horizontalBorder(barWidth + borderThickness * 2.0f, borderThickness);
+    const glm::vec2 verticalBorder(borderThickness, barHeight + borderThickness * 2.0f);
 
-    // Top border
-    shader.setVec2("rectPos", glm::vec2(barX - borderThickness, barY - borderThickness));
-    shader.setVec2("rectSize", glm::vec2(barWidth + borderThickness * 2.0f, borderThickness));
-    shader.setVec4("color", borderColor);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-
-    // Bottom border
-    shader.setVec2("rectPos", glm::vec2(barX - borderThickness, barY + barHeight));
-    shader.setVec2("rectSize", glm::vec2(barWidth + borderThickness * 2.0f, borderThickness));
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-
-    // Left border
-    shader.setVec2("rectPos", glm::vec2(barX - borderThickness, barY - borderThickness));
-    shader.setVec2("rectSize", glm::vec2(borderThickness, barHeight + borderThickness * 2.0f));
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-
-    // Right border
-    shader.setVec2("rectPos", glm::vec2(barX + barWidth, barY - borderThickness));
-    shader.setVec2("rectSize", glm::vec2(borderThickness, barHeight + borderThickness * 2.0f));
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-
-    glBindVertexArray(0);
+    // Top, bottom, left, right
+    batch_.AddRect(glm::vec2(barX - borderThickness, barY - borderThickness), horizontalBorder, borderColor);
+    batch_.AddRect(glm::vec2(barX - borderThickness, barY + barHeight), horizontalBorder, borderColor);
+    batch_.AddRect(glm::vec2(barX - borderThickness, barY - borderThickness), verticalBorder, borderColor);
+    batch_.AddRect(glm::vec2(barX + barWidth, barY - borderThickness), verticalBorder, borderColor);
 
     // Draw boss name label above the health bar
     if (textRenderer.IsReady())
@@ -488,4 +510,21 @@ namespace mecha
     }
   }
 
+  void HudRenderer::Flush(Shader &shader, const glm::vec2 &screenSize)
+  {
+    if (minimapRefreshPending_)
+    {
+      DrawMinimapLayer(minimapComposite_, shader, true);
+      minimapRefreshPending_ = false;
+    }
+
+    // Composite layer in the top-right corner, queued last so the HUD's shapes stay in one draw.
+    // Render-target rows run bottom-up, so V is flipped.
+    const glm::vec2 minimapPos(screenSize.x - kMinimapMargin - kMinimapSize - kMinimapPadding,
+                               kMinimapMargin - kMinimapPadding);
+    batch_.AddTexturedQuad(minimapPos, glm::vec2(static_cast<float>(kMinimapLayerSize)), minimapComposite_.texture,
+                           glm::vec4(1.0f), glm::vec2(0.0f, 1.0f), glm::vec2(1.0f, 0.0f), UiBatch::Blend::Premultiplied);
+    batch_.Flush(shader, screenSize);
+  }
+
 } // namespace mecha
@@ -4,6 +4,8 @@
 #include <vector>
 #include <string>
 
+#include "UiBatch.h"
+
 class Shader;
 
 namespace mecha
@@ -48,6 +50,7 @@ namespace mecha
       glm::vec3 godzillaPosition{0.0f};
       float minimapWorldRange{100.0f}; // World units visible in minimap
       float playerYawDegrees{0.0f};    // Player rotation for minimap orientation
+      float frameTime{0.0f};           // Unscaled seconds since the last frame; paces minimap refreshes
 
       // Objective display
       std::string objectiveText;
@@ -59,9 +62,51 @@ namespace mecha
       std::string bossName{"BOSS"};
     };
 
-    void Render(const HudRenderData &data, Shader &shader, unsigned int quadVao) const;
-    void RenderObjective(const HudRenderData &data, Shader &shader, unsigned int quadVao, DebugTextRenderer &textRenderer) const;
-    void RenderBossHealthBar(const HudRenderData &data, Shader &shader, unsigned int quadVao, DebugTextRenderer &textRenderer) const;
+    /**
+     * @param shader The "ui_batch" shader, used to draw the minimap's static layer up front
+     */
+    bool Initialize(Shader &shader);
+    void Shutdown();
+
+    // Render* only queue shapes (and text); Flush draws the queued shapes in one batch
+    void Render(const HudRenderData &data);
+    void RenderObjective(const HudRenderData &data, DebugTextRenderer &textRenderer);
+    void RenderBossHealthBar(const HudRenderData &data, DebugTextRenderer &textRenderer);
+    void Flush(Shader &shader, const glm::vec2 &screenSize);
+
+    /**
+     * @brief How often the minimap's blips are redrawn; between refreshes the cached texture is reused
+     * @param hz Refreshes per second, or 0 to redraw every frame
+     */
+    void SetMinimapRefreshRate(float hz) { minimapRefreshInterval_ = hz > 0.0f ? 1.0f / hz : 0.0f; }
+
+  private:
+    /**
+     * @brief Offscreen minimap layers
+     *
+     * The frame (background, border, player marker) is drawn once, at Initialize, into the static
+     * layer. At the refresh rate the static layer is copied into the composite layer and the blips
+     * are drawn over it; the HUD shows the composite layer as one textured quad. Layers hold
+     * premultiplied colour so they composite like the shapes drawn straight to the screen.
+     */
+    struct MinimapLayer
+    {
+      unsigned int fbo = 0;
+      unsigned int texture = 0;
+    };
+
+    bool CreateMinimapLayer(MinimapLayer &layer);
+    void DestroyMinimapLayer(MinimapLayer &layer);
+    void DrawMinimapLayer(const MinimapLayer &layer, Shader &shader, bool copyStaticLayer);
+    void QueueMinimap(const HudRenderData &data);
+
+    UiBatch batch_;
+    UiBatch minimapBatch_; // Blips for the next composite layer refresh
+    MinimapLayer minimapStatic_;
+    MinimapLayer minimapComposite_;
+    bool minimapRefreshPending_ = false; // minimapBatch_ holds blips to draw before the next flush
+    float minimapRefreshInterval_ = 1.0f / 15.0f;
+    float minimapTimeSinceRefresh_ = 0.0f;
   };
 
 } // namespace mecha
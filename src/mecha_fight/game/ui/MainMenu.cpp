@@ -1,15 +1,14 @@
 #include "MainMenu.h"
+#include "FontService.h"
 #include <learnopengl/shader_m.h>
 #include <learnopengl/filesystem.h>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 
-#include <ft2build.h>
-#include FT_FREETYPE_H
-
 #define STB_IMAGE_IMPLEMENTATION_DISABLED
 #include <stb_image.h>
 
@@ -25,16 +24,19 @@ namespace mecha
         Shutdown();
     }
 
-    bool MainMenu::Initialize(unsigned int screenWidth, unsigned int screenHeight, const std::string &backgroundPath)
+    bool MainMenu::Initialize(unsigned int screenWidth, unsigned int screenHeight, const std::string &backgroundPath,
+                              FontService &fonts)
     {
         m_screenWidth = screenWidth;
         m_screenHeight = screenHeight;
         m_state = MenuState::Active;
         m_lastFrameTime = static_cast<float>(glfwGetTime());
 
-        // Initialize text rendering with FreeType
+        // Text goes through the shared font service
+        m_fonts = &fonts;
         std::string fontPath = FileSystem::getPath("resources/fonts/Antonio-Bold.ttf");
-        if (!InitTextRendering(fontPath, 48))
+        m_font = fonts.LoadFont(fontPath, 48);
+        if (!m_font)
         {
             std::cerr << "[MainMenu] Warning: Failed to initialize text rendering" << std::endl;
         }
@@ -59,150 +61,17 @@ namespace mecha
         return true;
     }
 
-    bool MainMenu::InitTextRendering(const std::string &fontPath, unsigned int fontSize)
-    {
-        // Load text shader (reuse dev_text shaders)
-        const std::string vertexPath = FileSystem::getPath("src/mecha_fight/shaders/dev_text.vs");
-        const std::string fragmentPath = FileSystem::getPath("src/mecha_fight/shaders/dev_text.fs");
-        m_textShader = std::make_unique<Shader>(vertexPath.c_str(), fragmentPath.c_str());
-
-        // Setup projection matrix
-        m_textProjection = glm::ortho(0.0f, static_cast<float>(m_screenWidth),
-                                      static_cast<float>(m_screenHeight), 0.0f);
-        m_textShader->use();
-        m_textShader->setMat4("projection", m_textProjection);
-        m_textShader->setInt("text", 0);
-
-        // Setup VAO/VBO for text rendering
-        glGenVertexArrays(1, &m_textVAO);
-        glGenBuffers(1, &m_textVBO);
-        glBindVertexArray(m_textVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, m_textVBO);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, nullptr, GL_DYNAMIC_DRAW);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void *)0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
-
-        // Initialize FreeType
-        FT_Library ft;
-        if (FT_Init_FreeType(&ft))
-        {
-            std::cerr << "[MainMenu] ERROR: Could not init FreeType Library" << std::endl;
-            return false;
-        }
-
-        FT_Face face;
-        if (FT_New_Face(ft, fontPath.c_str(), 0, &face))
-        {
-            std::cerr << "[MainMenu] ERROR: Failed to load font: " << fontPath << std::endl;
-            FT_Done_FreeType(ft);
-            return false;
-        }
-
-        FT_Set_Pixel_Sizes(face, 0, fontSize);
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-        // Load ASCII characters
-        for (unsigned char c = 0; c < 128; ++c)
-        {
-            if (FT_Load_Char(face, c, FT_LOAD_RENDER))
-            {
-                std::cerr << "[MainMenu] Warning: Failed to load glyph for char " << static_cast<int>(c) << std::endl;
-                continue;
-            }
-
-            unsigned int texture;
-            glGenTextures(1, &texture);
-            glBindTexture(GL_TEXTURE_2D, texture);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RED,
-                         face->glyph->bitmap.width,
-                         face->glyph->bitmap.rows,
-                         0, GL_RED, GL_UNSIGNED_BYTE, face->glyph->bitmap.buffer);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-            Glyph glyph;
-            glyph.textureID = texture;
-            glyph.size = glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows);
-            glyph.bearing = glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top);
-            glyph.advance = static_cast<unsigned int>(face->glyph->advance.x);
-            m_glyphs.insert(std::make_pair(static_cast<char>(c), glyph));
-        }
-
-        glBindTexture(GL_TEXTURE_2D, 0);
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-
-        FT_Done_Face(face);
-        FT_Done_FreeType(ft);
-
-        m_textInitialized = true;
-        std::cout << "[MainMenu] Text rendering initialized with font: " << fontPath << std::endl;
-        return true;
-    }
-
     void MainMenu::RenderText(const std::string &text, float x, float y, float scale, const glm::vec3 &color)
     {
-        if (!m_textInitialized || !m_textShader)
+        if (m_font)
         {
-            return;
+            m_fonts->AddText(*m_font, text, x, y, scale, color);
         }
-
-        m_textShader->use();
-        m_textShader->setVec3("textColor", color);
-        glActiveTexture(GL_TEXTURE0);
-        glBindVertexArray(m_textVAO);
-
-        for (char c : text)
-        {
-            auto it = m_glyphs.find(c);
-            if (it == m_glyphs.end())
-            {
-                continue;
-            }
-
-            const Glyph &glyph = it->second;
-            float xpos = x + glyph.bearing.x * scale;
-            float ypos = y - (glyph.size.y - glyph.bearing.y) * scale;
-            float w = glyph.size.x * scale;
-            float h = glyph.size.y * scale;
-
-            float vertices[6][4] = {
-                {xpos, ypos + h, 0.0f, 1.0f},
-                {xpos + w, ypos, 1.0f, 0.0f},
-                {xpos, ypos, 0.0f, 0.0f},
-
-                {xpos, ypos + h, 0.0f, 1.0f},
-                {xpos + w, ypos + h, 1.0f, 1.0f},
-                {xpos + w, ypos, 1.0f, 0.0f}};
-
-            glBindTexture(GL_TEXTURE_2D, glyph.textureID);
-            glBindBuffer(GL_ARRAY_BUFFER, m_textVBO);
-            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-            glBindBuffer(GL_ARRAY_BUFFER, 0);
-            glDrawArrays(GL_TRIANGLES, 0, 6);
-
-            x += (glyph.advance >> 6) * scale;
-        }
-
-        glBindVertexArray(0);
-        glBindTexture(GL_TEXTURE_2D, 0);
     }
 
     float MainMenu::GetTextWidth(const std::string &text, float scale)
     {
-        float width = 0.0f;
-        for (char c : text)
-        {
-            auto it = m_glyphs.find(c);
-            if (it != m_glyphs.end())
-            {
-                width += (it->second.advance >> 6) * scale;
-            }
-        }
-        return width;
+        return m_font ? m_font->MeasureText(text, scale) : 0.0f;
     }
 
     void MainMenu::Shutdown()
@@ -214,25 +83,8 @@ namespace mecha
         }
         m_hasBackground = false;
 
-        // Cleanup text rendering resources
-        for (auto &pair : m_glyphs)
-        {
-            glDeleteTextures(1, &pair.second.textureID);
-        }
-        m_glyphs.clear();
-
-        if (m_textVAO != 0)
-        {
-            glDeleteVertexArrays(1, &m_textVAO);
-            m_textVAO = 0;
-        }
-        if (m_textVBO != 0)
-        {
-            glDeleteBuffers(1, &m_textVBO);
-            m_textVBO = 0;
-        }
-        m_textShader.reset();
-        m_textInitialized = false;
+        // The atlas belongs to the font service
+        m_font = nullptr;
 
         m_menuItems.clear();
     }
@@ -519,7 +371,7 @@ namespace mecha
         glBindVertexArray(0);
 
         // Render title text
-        if (m_textInitialized)
+        if (m_font)
         {
             std::string titleText = "MECHA FIGHT";
             float titleScale = 1.5f;
@@ -539,6 +391,12 @@ namespace mecha
             RenderText(subtitleText, subtitleX, subtitleY, subtitleScale, glm::vec3(0.7f, 0.7f, 0.8f));
         }
 
+        if (IsLoading())
+        {
+            RenderLoadingBar(shader, quadVAO);
+            return;
+        }
+
         // Render menu buttons
         shader.use();
         shader.setVec2("screenSize", glm::vec2(m_screenWidth, m_screenHeight));
@@ -605,7 +463,7 @@ namespace mecha
         glBindVertexArray(0);
 
         // Render button text with FreeType
-        if (m_textInitialized)
+        if (m_font)
         {
             for (size_t i = 0; i < m_menuItems.size(); ++i)
             {
@@ -631,22 +489,53 @@ namespace mecha
             float hintY = m_screenHeight - 40.0f;
 
             RenderText(hintText, hintX, hintY, hintScale, glm::vec3(0.5f, 0.5f, 0.5f));
+            m_fonts->Flush();
         }
     }
 
-    void MainMenu::Resize(unsigned int width, unsigned int height)
+    void MainMenu::SetLoadingProgress(float progress, const std::string &label)
     {
-        m_screenWidth = width;
-        m_screenHeight = height;
+        m_loadingProgress = std::clamp(progress, 0.0f, 1.0f);
+        m_loadingLabel = label;
+    }
 
-        // Update text projection matrix
-        if (m_textInitialized && m_textShader)
+    void MainMenu::RenderLoadingBar(Shader &shader, unsigned int quadVAO)
+    {
+        const glm::vec2 barSize(m_screenWidth * 0.4f, 12.0f);
+        const glm::vec2 barPos((m_screenWidth - barSize.x) * 0.5f, m_screenHeight * 0.55f);
+
+        shader.use();
+        shader.setVec2("screenSize", glm::vec2(m_screenWidth, m_screenHeight));
+        glBindVertexArray(quadVAO);
+
+        // Track
+        shader.setVec2("rectPos", barPos);
+        shader.setVec2("rectSize", barSize);
+        shader.setVec4("color", m_buttonColor);
+        shader.setFloat("fill", 1.0f);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+
+        // Fill
+        shader.setVec2("rectSize", glm::vec2(barSize.x * m_loadingProgress, barSize.y));
+        shader.setVec4("color", glm::vec4(0.2f, 0.8f, 1.0f, 1.0f));
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+
+        glBindVertexArray(0);
+
+        if (m_font)
         {
-            m_textProjection = glm::ortho(0.0f, static_cast<float>(width),
-                                          static_cast<float>(height), 0.0f);
-            m_textShader->use();
-            m_textShader->setMat4("projection", m_textProjection);
+            const std::string text = "Loading  " + m_loadingLabel;
+            const float textScale = 0.4f;
+            const float textX = (m_screenWidth - GetTextWidth(text, textScale)) * 0.5f;
+            RenderText(text, textX, barPos.y + barSize.y + 36.0f, textScale, glm::vec3(0.7f, 0.7f, 0.8f));
+            m_fonts->Flush();
         }
+    }
+
+    void MainMenu::Resize(unsigned int width, unsigned int height)
+    {
+        m_screenWidth = width;
+        m_screenHeight = height;
 
         CreateMenuItems();
     }
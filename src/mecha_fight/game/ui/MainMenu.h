@@ -6,20 +6,21 @@
 #include <string>
 #include <vector>
 #include <functional>
-#include <map>
-#include <memory>
 
 class Shader;
 
 namespace mecha
 {
 
+  class FontAtlas;
+  class FontService;
+
   /**
    * @brief Main menu screen displayed before the game starts
    *
    * Features:
    * - Background image
-   * - Title with FreeType text rendering
+   * - Title text drawn through the shared FontService
    * - Menu buttons (Start Game, Fullscreen/Windowed, Quit)
    * - Simple hover/selection effects
    */
@@ -51,9 +52,11 @@ namespace mecha
      * @param screenWidth Screen width in pixels
      * @param screenHeight Screen height in pixels
      * @param backgroundPath Path to background image
+     * @param fonts Font service the menu text is drawn through; must outlive the menu
      * @return true if initialization successful
      */
-    bool Initialize(unsigned int screenWidth, unsigned int screenHeight, const std::string &backgroundPath);
+    bool Initialize(unsigned int screenWidth, unsigned int screenHeight, const std::string &backgroundPath,
+                    FontService &fonts);
 
     /**
      * @brief Cleanup menu resources
@@ -73,6 +76,18 @@ namespace mecha
      */
     void Render(Shader &shader, unsigned int quadVAO);
 
+    /**
+     * @brief Show asset loading progress in place of the menu buttons until progress reaches 1
+     * @param progress Fraction loaded in [0, 1]
+     * @param label Name of the step that just finished
+     */
+    void SetLoadingProgress(float progress, const std::string &label);
+
+    /**
+     * @brief Check if the loading bar is shown instead of the menu
+     */
+    bool IsLoading() const { return m_loadingProgress < 1.0f; }
+
     /**
      * @brief Update screen dimensions
      */
@@ -104,23 +119,14 @@ namespace mecha
     void SetWindow(GLFWwindow *window) { m_window = window; }
 
   private:
-    // Text rendering glyph structure
-    struct Glyph
-    {
-      unsigned int textureID = 0;
-      glm::ivec2 size = glm::ivec2(0);
-      glm::ivec2 bearing = glm::ivec2(0);
-      unsigned int advance = 0;
-    };
-
     void CreateMenuItems();
     void UpdateHoverState(double mouseX, double mouseY);
     bool IsPointInRect(const glm::vec2 &point, const glm::vec2 &rectCenter, const glm::vec2 &rectSize);
+    void RenderLoadingBar(Shader &shader, unsigned int quadVAO);
     unsigned int LoadTexture(const std::string &path);
     void ToggleFullscreen();
 
     // Text rendering methods
-    bool InitTextRendering(const std::string &fontPath, unsigned int fontSize);
     void RenderText(const std::string &text, float x, float y, float scale, const glm::vec3 &color);
     float GetTextWidth(const std::string &text, float scale);
 
@@ -150,17 +156,17 @@ namespace mecha
     bool m_upPressed = false;
     bool m_downPressed = false;
 
+    // Loading screen (not loading by default)
+    float m_loadingProgress = 1.0f;
+    std::string m_loadingLabel;
+
     // Animation
     float m_animationTime = 0.0f;
     float m_lastFrameTime = 0.0f;
 
     // Text rendering resources
-    std::map<char, Glyph> m_glyphs;
-    unsigned int m_textVAO = 0;
-    unsigned int m_textVBO = 0;
-    std::unique_ptr<Shader> m_textShader;
-    glm::mat4 m_textProjection = glm::mat4(1.0f);
-    bool m_textInitialized = false;
+    FontService *m_fonts = nullptr;
+    const FontAtlas *m_font = nullptr;
 
     // Colors
     glm::vec3 m_titleColor = glm::vec3(1.0f, 0.9f, 0.2f);
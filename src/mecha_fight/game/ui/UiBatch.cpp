@@ -0,0 +1,189 @@
+#include "UiBatch.h"
+
+#include <glad/glad.h>
+#include <glm/gtc/constants.hpp>
+
+#include <learnopengl/shader_m.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace mecha
+{
+
+  UiBatch::~UiBatch()
+  {
+    Shutdown();
+  }
+
+  bool UiBatch::Init()
+  {
+    glGenVertexArrays(1, &vao_);
+    glGenBuffers(1, &vbo_);
+    glBindVertexArray(vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, position));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, uv));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, color));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    const unsigned char white[4] = {255, 255, 255, 255};
+    glGenTextures(1, &whiteTexture_);
+    glBindTexture(GL_TEXTURE_2D, whiteTexture_);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return true;
+  }
+
+  void UiBatch::Shutdown()
+  {
+    vertices_.clear();
+    ranges_.clear();
+    if (vao_ != 0)
+    {
+      glDeleteVertexArrays(1, &vao_);
+      vao_ = 0;
+    }
+    if (vbo_ != 0)
+    {
+      glDeleteBuffers(1, &vbo_);
+      vbo_ = 0;
+    }
+    if (whiteTexture_ != 0)
+    {
+      glDeleteTextures(1, &whiteTexture_);
+      whiteTexture_ = 0;
+    }
+    vboCapacity_ = 0;
+  }
+
+  void UiBatch::AddQuad(const glm::vec2 (&corners)[4], const glm::vec2 &uvTopLeft, const glm::vec2 &uvBottomRight,
+                        const glm::vec4 &color, unsigned int texture, Blend blend)
+  {
+    if (ranges_.empty() || ranges_.back().texture != texture || ranges_.back().blend != blend)
+    {
+      ranges_.push_back(DrawRange{texture, blend, vertices_.size(), 0});
+    }
+
+    const Vertex topLeft{corners[0], uvTopLeft, color};
+    const Vertex topRight{corners[1], glm::vec2(uvBottomRight.x, uvTopLeft.y), color};
+    const Vertex bottomRight{corners[2], uvBottomRight, color};
+    const Vertex bottomLeft{corners[3], glm::vec2(uvTopLeft.x, uvBottomRight.y), color};
+    vertices_.insert(vertices_.end(), {topLeft, topRight, bottomRight, topLeft, bottomRight, bottomLeft});
+    ranges_.back().count += 6;
+  }
+
+  void UiBatch::AddRect(const glm::vec2 &pos, const glm::vec2 &size, const glm::vec4 &color, float fill)
+  {
+    const float width = size.x * fill;
+    if (width <= 0.0f)
+    {
+      return;
+    }
+    const glm::vec2 corners[4] = {pos, pos + glm::vec2(width, 0.0f), pos + glm::vec2(width, size.y),
+                                  pos + glm::vec2(0.0f, size.y)};
+    AddQuad(corners, glm::vec2(0.0f), glm::vec2(fill, 1.0f), color, whiteTexture_);
+  }
+
+  void UiBatch::AddLine(const glm::vec2 &from, const glm::vec2 &to, float thickness, const glm::vec4 &color)
+  {
+    const glm::vec2 direction = to - from;
+    const float length = glm::length(direction);
+    if (length <= 0.0f)
+    {
+      return;
+    }
+    const glm::vec2 offset = glm::vec2(-direction.y, direction.x) / length * (thickness * 0.5f);
+    const glm::vec2 corners[4] = {from + offset, to + offset, to - offset, from - offset};
+    AddQuad(corners, glm::vec2(0.0f), glm::vec2(1.0f), color, whiteTexture_);
+  }
+
+  void UiBatch::AddCircle(const glm::vec2 &center, float radius, float thickness, const glm::vec4 &color, int segments)
+  {
+    const float inner = radius - thickness * 0.5f;
+    const float outer = radius + thickness * 0.5f;
+    glm::vec2 previous(1.0f, 0.0f);
+    for (int i = 1; i <= segments; ++i)
+    {
+      const float angle = (static_cast<float>(i) / static_cast<float>(segments)) * glm::two_pi<float>();
+      const glm::vec2 current(std::cos(angle), std::sin(angle));
+      const glm::vec2 corners[4] = {center + previous * outer, center + current * outer, center + current * inner,
+                                    center + previous * inner};
+      AddQuad(corners, glm::vec2(0.0f), glm::vec2(1.0f), color, whiteTexture_);
+      previous = current;
+    }
+  }
+
+  void UiBatch::AddTexturedQuad(const glm::vec2 &pos, const glm::vec2 &size, unsigned int texture, const glm::vec4 &color,
+                                const glm::vec2 &uvTopLeft, const glm::vec2 &uvBottomRight, Blend blend)
+  {
+    const glm::vec2 corners[4] = {pos, pos + glm::vec2(size.x, 0.0f), pos + size, pos + glm::vec2(0.0f, size.y)};
+    AddQuad(corners, uvTopLeft, uvBottomRight, color, texture, blend);
+  }
+
+  void UiBatch::Flush(Shader &shader, const glm::vec2 &screenSize)
+  {
+    if (vertices_.empty())
+    {
+      return;
+    }
+
+    glBindVertexArray(vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    // Orphan the old storage so the driver never waits for the previous flush's draws
+    vboCapacity_ = std::max(vboCapacity_, vertices_.size());
+    glBufferData(GL_ARRAY_BUFFER, vboCapacity_ * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertices_.size() * sizeof(Vertex), vertices_.data());
+
+    shader.use();
+    shader.setVec2("screenSize", screenSize);
+    shader.setInt("uTexture", 0);
+    glActiveTexture(GL_TEXTURE0);
+    GLint callerBlend[4] = {0, 0, 0, 0}; // Read on the first premultiplied range, restored after it
+    bool callerBlendSaved = false;
+    Blend currentBlend = Blend::Straight;
+    for (const DrawRange &range : ranges_)
+    {
+      if (range.blend != currentBlend)
+      {
+        if (range.blend == Blend::Premultiplied)
+        {
+          if (!callerBlendSaved)
+          {
+            glGetIntegerv(GL_BLEND_SRC_RGB, &callerBlend[0]);
+            glGetIntegerv(GL_BLEND_DST_RGB, &callerBlend[1]);
+            glGetIntegerv(GL_BLEND_SRC_ALPHA, &callerBlend[2]);
+            glGetIntegerv(GL_BLEND_DST_ALPHA, &callerBlend[3]);
+            callerBlendSaved = true;
+          }
+          glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        }
+        else
+        {
+          glBlendFuncSeparate(callerBlend[0], callerBlend[1], callerBlend[2], callerBlend[3]);
+        }
+        currentBlend = range.blend;
+      }
+      glBindTexture(GL_TEXTURE_2D, range.texture);
+      glDrawArrays(GL_TRIANGLES, static_cast<GLint>(range.first), static_cast<GLsizei>(range.count));
+    }
+    if (currentBlend == Blend::Premultiplied)
+    {
+      glBlendFuncSeparate(callerBlend[0], callerBlend[1], callerBlend[2], callerBlend[3]);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    vertices_.clear();
+    ranges_.clear();
+  }
+
+} // namespace mecha
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+class Shader;
+
+namespace mecha
+{
+
+  /**
+   * @brief Immediate-mode 2D batcher for screen-space UI shapes
+   *
+   * Rects, lines, circles and textured quads append triangles with a per-vertex colour to a
+   * CPU buffer; Flush uploads them into one dynamic vertex buffer and draws them with one call
+   * per run of the same texture and blend mode (untextured shapes sample a white texel). Positions are pixels
+   * with a top-left origin, as for the "ui" shader. Draw with the "ui_batch" shader.
+   */
+  class UiBatch
+  {
+  public:
+    enum class Blend
+    {
+      Straight,     // Colour not yet multiplied by alpha; drawn with the caller's blend state
+      Premultiplied // Render-target contents, composited with ONE, ONE_MINUS_SRC_ALPHA
+    };
+
+    UiBatch() = default;
+    ~UiBatch();
+
+    UiBatch(const UiBatch &) = delete;
+    UiBatch &operator=(const UiBatch &) = delete;
+
+    bool Init();
+    void Shutdown();
+
+    /**
+     * @param fill Fraction of the width drawn from the left, like the "ui" shader's fill
+     */
+    void AddRect(const glm::vec2 &pos, const glm::vec2 &size, const glm::vec4 &color, float fill = 1.0f);
+    void AddLine(const glm::vec2 &from, const glm::vec2 &to, float thickness, const glm::vec4 &color);
+
+    /**
+     * @brief Ring of the given thickness centred on radius
+     */
+    void AddCircle(const glm::vec2 &center, float radius, float thickness, const glm::vec4 &color, int segments);
+
+    /**
+     * @param uvTopLeft Texture coordinate at pos; the default samples images with their first row on top
+     */
+    void AddTexturedQuad(const glm::vec2 &pos, const glm::vec2 &size, unsigned int texture, const glm::vec4 &color,
+                         const glm::vec2 &uvTopLeft = glm::vec2(0.0f), const glm::vec2 &uvBottomRight = glm::vec2(1.0f),
+                         Blend blend = Blend::Straight);
+
+    /**
+     * @brief Draw everything added since the last flush
+     * @param screenSize Size in pixels of the target the positions refer to
+     */
+    void Flush(Shader &shader, const glm::vec2 &screenSize);
+
+    bool IsEmpty() const { return vertices_.empty(); }
+
+  private:
+    struct Vertex
+    {
+      glm::vec2 position;
+      glm::vec2 uv;
+      glm::vec4 color;
+    };
+
+    // Consecutive vertices sharing a texture and blend mode, drawn with one call
+    struct DrawRange
+    {
+      unsigned int texture = 0;
+      Blend blend = Blend::Straight;
+      size_t first = 0;
+      size_t count = 0;
+    };
+
+    // Corners in order top-left, top-right, bottom-right, bottom-left
+    void AddQuad(const glm::vec2 (&corners)[4], const glm::vec2 &uvTopLeft, const glm::vec2 &uvBottomRight,
+                 const glm::vec4 &color, unsigned int texture, Blend blend = Blend::Straight);
+
+    std::vector<Vertex> vertices_;
+    std::vector<DrawRange> ranges_;
+    unsigned int vao_ = 0;
+    unsigned int vbo_ = 0;
+    unsigned int whiteTexture_ = 0;
+    size_t vboCapacity_ = 0; // In vertices
+  };
+
+} // namespace mecha
@@ -1,14 +1,14 @@
 #version 330 core
 in vec2 TexCoords;
+in vec3 TextColor;
 out vec4 FragColor;
 
 uniform sampler2D text;
-uniform vec3 textColor;
 
 void main()
 {
     float alpha = texture(text, TexCoords).r;
     if (alpha < 0.01)
         discard;
-    FragColor = vec4(textColor, alpha);
+    FragColor = vec4(TextColor, alpha);
 }
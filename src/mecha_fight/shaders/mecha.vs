@@ -8,13 +8,27 @@ layout (location = 6) in vec4 aWeights;
 out vec2 TexCoords;
 out vec3 FragPos;
 out vec3 Normal;
-out vec4 FragPosLightSpace;
 out vec3 FragPosWorld;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-uniform mat4 lightSpaceMatrix;
+
+const int MAX_CASCADES = 4;
+layout (std140) uniform FrameConstants
+{
+    mat4 projection;
+    mat4 view;
+    mat4 invProjection;
+    mat4 cascadeMatrices[MAX_CASCADES];
+    mat4 staticLightSpaceMatrix;
+    vec4 cascadeSplits;      // far view-space distance of each cascade
+    vec3 viewPos;
+    float time;
+    vec3 lightPos;
+    int cascadeCount;
+    vec3 lightIntensity;
+    int useStaticShadow;     // cached terrain/gate depth, sampled alongside the cascades
+};
+
 uniform bool useSkinning;
 uniform int bonesCount;
 const int MAX_BONES = 100;
@@ -89,6 +103,5 @@ void main()
     FragPos = vec3(worldPos);
     FragPosWorld = vec3(worldPos);
     Normal = normalize(mat3(transpose(inverse(model))) * skinnedNormal);
-    FragPosLightSpace = lightSpaceMatrix * worldPos;
     gl_Position = projection * view * worldPos;
 }
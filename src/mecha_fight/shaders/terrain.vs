@@ -6,13 +6,26 @@ layout (location = 2) in vec2 aTexCoords;
 out vec2 TexCoords;
 out vec3 FragPos;
 out vec3 Normal;
-out vec4 FragPosLightSpace;
 out vec3 FragPosWorld;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-uniform mat4 lightSpaceMatrix;
+
+const int MAX_CASCADES = 4;
+layout (std140) uniform FrameConstants
+{
+    mat4 projection;
+    mat4 view;
+    mat4 invProjection;
+    mat4 cascadeMatrices[MAX_CASCADES];
+    mat4 staticLightSpaceMatrix;
+    vec4 cascadeSplits;      // far view-space distance of each cascade
+    vec3 viewPos;
+    float time;
+    vec3 lightPos;
+    int cascadeCount;
+    vec3 lightIntensity;
+    int useStaticShadow;     // cached terrain/gate depth, sampled alongside the cascades
+};
 
 void main()
 {
@@ -21,6 +34,5 @@ void main()
     FragPos = vec3(worldPos);
     FragPosWorld = vec3(worldPos);
     Normal = mat3(transpose(inverse(model))) * aNormal;
-    FragPosLightSpace = lightSpaceMatrix * worldPos;
     gl_Position = projection * view * model * vec4(aPos, 1.0);
 }
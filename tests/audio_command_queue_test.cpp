@@ -0,0 +1,247 @@
+// Checks the audio command path of MiniaudioSoundController on miniaudio's null backend: commands
+// for a voice are applied in the order they were queued, a full command ring makes the game thread
+// wait instead of dropping commands, and ended voices come back to the pool even when the device
+// stops pulling frames and the engine clock stalls.
+
+#include "game/audio/MiniaudioSoundController.h"
+#include "game/audio/SpscQueue.h"
+
+#include <miniaudio.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mecha
+{
+  // Reaches the controller's queues and engine; declared a friend by MiniaudioSoundController
+  struct MiniaudioSoundControllerTestAccess
+  {
+    // Voice events the service thread reported, in order, waiting up to timeout for count of them
+    static std::vector<uint32_t> WaitForVoiceEvents(MiniaudioSoundController &controller, size_t count,
+                                                    std::chrono::milliseconds timeout)
+    {
+      std::vector<uint32_t> voices;
+      const auto deadline = std::chrono::steady_clock::now() + timeout;
+      MiniaudioSoundController::VoiceEvent event;
+      while (voices.size() < count && std::chrono::steady_clock::now() < deadline)
+      {
+        if (controller.voiceEvents_->Pop(event))
+        {
+          voices.push_back(event.voice);
+        }
+        else
+        {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+      }
+      return voices;
+    }
+
+    static size_t CommandQueueCapacity(const MiniaudioSoundController &controller)
+    {
+      return controller.commands_->Capacity();
+    }
+
+    // Stop the device: nothing pulls frames any more, so the engine clock stays where it is
+    static bool StopDevice(MiniaudioSoundController &controller)
+    {
+      return ma_engine_stop(controller.engine_) == MA_SUCCESS;
+    }
+
+    static ma_uint64 EngineTime(const MiniaudioSoundController &controller)
+    {
+      return ma_engine_get_time_in_pcm_frames(controller.engine_);
+    }
+  };
+} // namespace mecha
+
+namespace
+{
+  using mecha::MiniaudioSoundController;
+  using Access = mecha::MiniaudioSoundControllerTestAccess;
+
+  int gFailures = 0;
+
+  void Check(bool condition, const char *what)
+  {
+    if (!condition)
+    {
+      std::printf("FAILED: %s\n", what);
+      ++gFailures;
+    }
+  }
+
+  void WriteLittleEndian(std::ofstream &out, uint32_t value, int bytes)
+  {
+    for (int i = 0; i < bytes; ++i)
+    {
+      out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+  }
+
+  // A tenth of a second 16-bit mono sine, decoded by the controller into a pooled clip
+  bool WriteTestClip(const std::string &path)
+  {
+    const uint32_t sampleRate = 48000;
+    const uint32_t frameCount = sampleRate / 10;
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+    {
+      return false;
+    }
+    out.write("RIFF", 4);
+    WriteLittleEndian(out, 36 + frameCount * 2, 4);
+    out.write("WAVEfmt ", 8);
+    WriteLittleEndian(out, 16, 4);
+    WriteLittleEndian(out, 1, 2); // PCM
+    WriteLittleEndian(out, 1, 2); // Mono
+    WriteLittleEndian(out, sampleRate, 4);
+    WriteLittleEndian(out, sampleRate * 2, 4);
+    WriteLittleEndian(out, 2, 2);
+    WriteLittleEndian(out, 16, 2);
+    out.write("data", 4);
+    WriteLittleEndian(out, frameCount * 2, 4);
+    for (uint32_t i = 0; i < frameCount; ++i)
+    {
+      const float sample = std::sin(6.2831853f * 440.0f * static_cast<float>(i) / sampleRate);
+      WriteLittleEndian(out, static_cast<uint32_t>(static_cast<int16_t>(sample * 12000.0f)) & 0xFFFF, 2);
+    }
+    return static_cast<bool>(out);
+  }
+
+  MiniaudioSoundController::Config NullConfig()
+  {
+    MiniaudioSoundController::Config config;
+    config.nullBackend = true;
+    config.voiceCount = 8;
+    return config;
+  }
+
+  // Looped voices only end when a Stop reaches them, so an event proves the Stop was applied after
+  // the Play and the volume change queued before it
+  void TestCommandOrder(const std::string &clip)
+  {
+    MiniaudioSoundController controller(NullConfig());
+    Check(controller.DecodeSound(clip.c_str()), "clip decodes");
+
+    void *first = controller.Play3D(clip.c_str(), glm::vec3(1.0f, 0.0f, 0.0f), true, 1.0f, 50.0f);
+    void *second = controller.Play3D(clip.c_str(), glm::vec3(-1.0f, 0.0f, 0.0f), true, 1.0f, 50.0f);
+    Check(first != nullptr && second != nullptr, "looped plays get pooled voices");
+    Check(controller.GetActiveVoiceCount() == 2, "two voices reserved");
+
+    controller.SetVolume(first, 0.5f);
+    controller.SetVolume(second, 0.25f);
+    controller.StopSound(second);
+    controller.StopSound(first);
+
+    // The pool hands out voice 0 first, so the stops come back as voice 1, then voice 0
+    const std::vector<uint32_t> events = Access::WaitForVoiceEvents(controller, 2, std::chrono::seconds(2));
+    Check(events.size() == 2, "both stopped voices are reported");
+    Check(events.size() == 2 && events[0] == 1 && events[1] == 0, "voice events follow the order of the stops");
+
+    const std::vector<uint32_t> extra = Access::WaitForVoiceEvents(controller, 1, std::chrono::milliseconds(50));
+    Check(extra.empty(), "each voice is reported once");
+  }
+
+  void TestQueueFull(const std::string &clip)
+  {
+    // Capacity rounds up to a power of two; Push fails once every slot is taken
+    mecha::SpscQueue<uint32_t> queue(5);
+    Check(queue.Capacity() == 8, "capacity rounds up to a power of two");
+    uint32_t pushed = 0;
+    while (queue.Push(pushed))
+    {
+      ++pushed;
+    }
+    Check(pushed == queue.Capacity(), "ring holds exactly its capacity");
+
+    // Freeing a slot lets exactly one more in, and everything comes out in push order across the wrap
+    uint32_t value = 0;
+    Check(queue.Pop(value) && value == 0, "oldest element pops first");
+    Check(queue.Push(pushed), "push succeeds after a pop");
+    Check(!queue.Push(pushed + 1), "ring is full again");
+    bool ordered = true;
+    for (uint32_t expected = 1; expected <= pushed; ++expected)
+    {
+      ordered = ordered && queue.Pop(value) && value == expected;
+    }
+    Check(ordered, "elements pop in push order across the wrap");
+    Check(!queue.Pop(value), "queue is empty after draining");
+
+    // The controller never drops a command: far more volume changes than the ring holds, then a
+    // Stop, and the Stop still arrives
+    MiniaudioSoundController controller(NullConfig());
+    Check(controller.DecodeSound(clip.c_str()), "clip decodes");
+    void *handle = controller.Play2D(clip.c_str(), true, 1.0f);
+    Check(handle != nullptr, "looped 2D play gets a pooled voice");
+    const size_t commandCount = 3 * Access::CommandQueueCapacity(controller);
+    for (size_t i = 0; i < commandCount; ++i)
+    {
+      controller.SetVolume(handle, static_cast<float>(i % 100) / 100.0f);
+    }
+    controller.StopSound(handle);
+    const std::vector<uint32_t> events = Access::WaitForVoiceEvents(controller, 1, std::chrono::seconds(5));
+    Check(events.size() == 1, "stop queued behind a full command ring is applied");
+  }
+
+  // With the device stopped the engine clock never passes a voice's end time; the voice must still
+  // come back to the pool once the retire timeout runs out
+  void TestStalledClock(const std::string &clip)
+  {
+    MiniaudioSoundController controller(NullConfig());
+    Check(controller.DecodeSound(clip.c_str()), "clip decodes");
+    Check(Access::StopDevice(controller), "device stops");
+
+    void *handle = controller.Play3D(clip.c_str(), glm::vec3(0.0f), true, 1.0f, 50.0f);
+    Check(handle != nullptr, "play on a stopped device gets a pooled voice");
+    controller.StopSound(handle);
+
+    const ma_uint64 stalledAt = Access::EngineTime(controller);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    controller.Update(0.03f);
+    Check(Access::EngineTime(controller) == stalledAt, "engine clock is stalled");
+    Check(controller.GetActiveVoiceCount() == 1, "voice is held while the timeout runs");
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (controller.GetActiveVoiceCount() != 0 && std::chrono::steady_clock::now() < deadline)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      controller.Update(0.01f);
+    }
+    Check(controller.GetActiveVoiceCount() == 0, "voice returns to the pool with the clock stalled");
+
+    // The recycled voice plays again and retires the same way
+    void *again = controller.Play3D(clip.c_str(), glm::vec3(0.0f), false, 1.0f, 50.0f);
+    Check(again != nullptr && again != handle, "recycled voice hands out a fresh handle");
+  }
+} // namespace
+
+int main()
+{
+  const std::string clip = (std::filesystem::temp_directory_path() / "audio_command_queue_test.wav").string();
+  if (!WriteTestClip(clip))
+  {
+    std::printf("FAILED: could not write %s\n", clip.c_str());
+    return 1;
+  }
+
+  TestCommandOrder(clip);
+  TestQueueFull(clip);
+  TestStalledClock(clip);
+  std::filesystem::remove(clip);
+
+  if (gFailures > 0)
+  {
+    std::printf("%d audio command queue checks failed\n", gFailures);
+    return 1;
+  }
+  std::printf("All audio command queue checks passed\n");
+  return 0;
+}